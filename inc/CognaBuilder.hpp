@@ -60,12 +60,33 @@ public:
     std::vector<utils::networking_client*> get_client_list();
     std::vector<utils::networking_sender*> get_sender_list();
     int get_frequency();
+    int get_worker_threads();
+    int get_partition_profile_steps();
+    bool get_dataflow_scheduling();
+    std::vector<int> get_worker_cpus();
+    std::vector<int> get_io_cpus();
+    bool get_free_running();
+    unsigned long long get_max_steps();
+    int get_overrun_policy();
+    bool get_realtime();
+    int get_realtime_priority();
 
 private:
     std::vector<NeuralNetwork*> _network_list;
     std::vector<utils::networking_client*> _client_list;
     std::vector<utils::networking_sender*> _sender_list;
     int _frequency;
+    int _worker_threads;
+    int _partition_profile_steps;
+    bool _dataflow_scheduling;
+    std::vector<int> _worker_cpus;      // Empty if the workers are not pinned
+    std::vector<int> _io_cpus;          // Empty if the networking threads are not pinned
+    uint64_t _random_seed;              // Seed of the random activation of all networks
+    bool _free_running;
+    unsigned long long _max_steps;      // 0 if the cluster runs until it is stopped
+    int _overrun_policy;
+    bool _realtime;
+    int _realtime_priority;             // SCHED_FIFO priority of the workers with the real-time profile
 
     nlohmann::json _neuron_types;
     std::vector<nlohmann::json> _presynaptic_connections;
@@ -12,11 +12,15 @@
 #define INCLUDE_COGNALAUNCHER_HPP
 
 #include "NeuralNetwork.hpp"
+#include "DataflowScheduler.hpp"
+#include "GraphPartitioner.hpp"
+#include "TickClock.hpp"
+#include "WorkerPool.hpp"
 #include "networking_client.hpp"
 #include "networking_sender.hpp"
+#include <functional>
 #include <vector>
 #include <thread>
-#include <condition_variable>
 
 namespace COGNA{
 
@@ -24,11 +28,15 @@ class CognaLauncher{
 public:
     /**
      * Constructor. Initializes the compiled COGNA cluster.
+     *
+     * @param worker_threads    Number of threads stepping the networks. 0 uses one thread per hardware
+     *                          thread, but never more than networks in the cluster.
      */
     CognaLauncher(std::vector<NeuralNetwork*> network_list,
                   std::vector<utils::networking_client*> client_list,
                   std::vector<utils::networking_sender*> sender_list,
-                  int frequency);
+                  int frequency,
+                  int worker_threads=0);
 
     /**
      * Destructor. Frees all memory used by the networks in the cluster.
@@ -49,13 +57,124 @@ public:
      */
     int run_cogna();
 
+    /**
+     * @brief Places the networks on the workers by a partition map.
+     *
+     * Every network starts its steps on the worker of the shard holding most of its weight.
+     * Idle workers still steal networks of other workers. Networks stepping on all workers
+     * split their dense steps by the shards of their neurons, see NeuralNetwork::set_partition().
+     *
+     * @param partition_map    The partition of the cluster, usually with one shard per worker.
+     */
+    void set_partition_map(const PartitionMap &partition_map);
+
+    /**
+     * @brief Profiles the first steps of the cluster and partitions it into one shard per worker afterwards.
+     *
+     * @param profile_steps    Number of steps to profile. 0 does not partition the cluster.
+     */
+    void set_partition_profile_steps(int profile_steps);
+
+    /**
+     * @brief Steps every network as soon as its neighbours in the network graph are ready, see DataflowScheduler.
+     *
+     * Not used if a network steps on all workers, see NeuralNetwork::set_worker_pool().
+     *
+     * @param dataflow_scheduling    true to use the DataflowScheduler, false to step all networks as one batch.
+     */
+    void set_dataflow_scheduling(bool dataflow_scheduling);
+
+    /**
+     * @brief Pins the workers to CPUs and stores every network on the NUMA node of the worker it starts on.
+     *
+     * Worker i runs on cpus[i % cpus.size()]. Worker 0 is the thread calling run_cogna().
+     *
+     * @param cpus    The CPUs of the workers. Empty does not pin the workers.
+     */
+    void set_worker_cpus(const std::vector<int> &cpus);
+
+    /**
+     * @brief Restricts the threads receiving UDP messages to a set of CPUs.
+     *
+     * @param cpus    The CPUs of the networking threads. Empty does not pin the threads.
+     */
+    void set_io_cpus(const std::vector<int> &cpus);
+
+    /**
+     * @brief Steps the cluster as fast as possible instead of holding its frequency.
+     *
+     * UDP messages are still polled before every step, but never waited for. Without clients and senders
+     * the DataflowScheduler steps the networks in batches of FREE_RUNNING_BATCH steps.
+     *
+     * @param free_running    true to never sleep between two steps.
+     */
+    void set_free_running(bool free_running);
+
+    /**
+     * @brief Stops the cluster after a number of steps, run_cogna() returns afterwards.
+     *
+     * @param max_steps    The step budget. 0 runs until the cluster is stopped.
+     */
+    void set_max_steps(unsigned long long max_steps);
+
+    /**
+     * @brief Decides what happens to the ticks a step overran, see TickClock.
+     *
+     * @param overrun_policy    OVERRUN_SKIP, OVERRUN_CATCH_UP or OVERRUN_STRETCH.
+     */
+    void set_overrun_policy(int overrun_policy);
+
+    /**
+     * @brief Runs the cluster with the real-time profile, see RealtimeProfile.
+     *
+     * Locks the memory, pre-faults the networks and the worker stacks, runs the workers and networking threads
+     * with SCHED_FIFO and pins the workers to the isolated CPUs if no worker CPUs are set. Guarantees which
+     * cannot be applied, usually because of missing privileges, are reported and the cluster runs without them.
+     *
+     * @param realtime    true to apply the profile in run_cogna().
+     */
+    void set_realtime(bool realtime);
+
+    /**
+     * @brief Sets the SCHED_FIFO priority of the workers, the networking threads run one below.
+     *
+     * @param priority    The priority from 1 to 99.
+     */
+    void set_realtime_priority(int priority);
+
+    /**
+     * @brief Returns the clock of the tick loop, its lateness statistics may be queried while the cluster runs.
+     */
+    const TickClock &get_tick_clock() const;
+
+    /**
+     * @brief Returns the number of steps the cluster took, may be queried while the cluster runs.
+     */
+    unsigned long long get_cluster_step() const;
+
 private:
     std::vector<NeuralNetwork*> _network_list;
     std::vector<utils::networking_client*> _client_list;
     std::vector<utils::networking_sender*> _sender_list;
     std::vector<std::thread*> _client_worker_list;
-    std::vector<std::thread*> _cogna_worker_list;
+    std::vector<std::function<void()>> _step_tasks;
+    std::vector<uint32_t> _first_tasks;         // First step task of every worker, empty if not partitioned
+    std::vector<NeuralNetwork*> _parallel_networks;     // Stepped on all workers after the step tasks
+    WorkerPool *_worker_pool;
+    PartitionMap _partition_map;
+    GraphPartitioner *_partitioner;             // Only exists while profiling
+    int _partition_profile_steps;
+    DataflowScheduler *_scheduler;              // NULL if the networks are stepped as one batch
+    bool _dataflow_scheduling;
+    std::vector<int> _worker_cpus;
+    std::vector<int> _io_cpus;
     int _frequency;
+    TickClock _tick_clock;
+    bool _free_running;
+    bool _realtime;
+    int _realtime_priority;
+    unsigned long long _max_steps;              // 0 if the cluster runs until it is stopped
+    int _worker_threads;
     unsigned long long *_curr_cluster_step;
 
     /**
@@ -66,14 +185,55 @@ private:
     int create_networking_workers();
 
     /**
-     * @brief Creates all threads working on different COGNA networks.
+     * @brief Creates the worker pool and one step task per network.
+     *
+     * @return  Error code.
+     */
+    int create_cogna_workers();
+
+    /**
+     * @brief Applies the real-time profile to the running workers and reports every guarantee missing.
+     *
+     * @return  The number of guarantees which could not be applied.
+     */
+    int apply_realtime_profile();
+
+    /**
+     * @brief Stops and joins all threads working on UDP networking.
+     */
+    void stop_networking_workers();
+
+    /**
+     * @brief Polls the clients, steps the cluster and sends the payload of the senders.
+     *
+     * @param steps    Number of steps. More than one step is only stepped without clients and senders.
      *
-     * @param thread_lock   A mutex condition_variable for locking a thread until it is allowed to run.
-     *                      Used for synchronizing all threads.
+     * @return         The number of steps taken.
+     */
+    unsigned long long step_cluster(unsigned long long steps);
+
+    /**
+     * @brief Creates one step task per network, ordered by the worker it starts on.
      *
-     * @return              Error code.
+     * Networks stepping in parallel get no task, they run their chunks on all workers instead, see
+     * NeuralNetwork::is_parallel().
+     */
+    void create_step_tasks();
+
+    /**
+     * @brief Partitions the cluster with the profile of the first steps.
+     */
+    void partition_cluster();
+
+    /**
+     * @brief Returns the worker a network starts its steps on.
+     */
+    int home_worker(unsigned int network_index);
+
+    /**
+     * @brief Moves every network to the NUMA node of its home worker and reports the placement.
      */
-    int create_cogna_workers(std::condition_variable *thread_lock);
+    void place_networks();
 };
 
 } //namespace COGNA
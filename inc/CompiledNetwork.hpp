@@ -0,0 +1,383 @@
+/**
+ * @file CompiledNetwork.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief A flat representation of a neural network used for running the network loop.
+ *
+ * The object graph of Neuron and Connection objects is convenient for building a network,
+ * but every step has to chase pointers through heap objects spread across memory. The
+ * compiled network stores the topology as compressed sparse rows (CSR) with 32 bit indices
+ * and the changing state of all neurons and connections in flat arrays.
+ *
+ * Neurons are indexed by their ID, connections by their position in the CSR arrays. The
+ * connections of a neuron are stored in the same order as in Neuron::_connections, so the
+ * compiled network visits everything in the same order as the object graph does.
+ *
+ * @date 2021-07-05
+ *
+ */
+
+#ifndef INCLUDE_COMPILEDNETWORK_HPP
+#define INCLUDE_COMPILEDNETWORK_HPP
+
+#include <vector>
+#include <cstdint>
+#include "NetworkKernels.hpp"
+#include "NetworkInbox.hpp"
+
+namespace COGNA{
+    /**
+     * @brief Number of kernel IDs returned by CompiledNetwork::kernel_id(), including KERNEL_ANY_TYPE.
+     *
+     */
+    const int CONNECTION_KERNEL_NUMBER = 17;
+
+    /**
+     * @brief Rows splitting into runs shorter than this on average are propagated as one run of the
+     *        generic kernel, which costs fewer calls than the runs save branches.
+     *
+     */
+    const uint32_t MIN_KERNEL_RUN_LENGTH = 2;
+
+    /**
+     * @brief Scratch memory of CompiledNetwork::batch_learning(). Threads learning in parallel need one each.
+     *
+     */
+    struct LearningBuffers{
+        std::vector<double> _pow_base;
+        std::vector<double> _pow_exponent;
+        std::vector<double> _pow_result;
+        std::vector<int32_t> _habituation_jobs;       /**< Index of the short habituation power, -1 if none */
+        std::vector<int32_t> _sensitization_jobs;     /**< Index of the short sensitization power, -1 if none */
+    };
+
+    class NeuralNetwork;
+    class Neuron;
+    class Connection;
+    class NeuronParameterHandler;
+    class ConnectionParameterHandler;
+
+    /**
+     * @brief Class containing the compiled topology and state of a single network.
+     *
+     */
+    class CompiledNetwork{
+    public:
+        int _network_id;
+        uint32_t _neuron_count;
+        uint32_t _connection_count;
+
+        /* Topology */
+        std::vector<uint32_t> _offsets;               /**< Connections of neuron n are in [_offsets[n], _offsets[n+1]) */
+        std::vector<uint32_t> _targets;               /**< Target neuron ID or target connection index */
+        std::vector<uint16_t> _target_networks;       /**< Network ID the target belongs to */
+        std::vector<uint8_t> _target_kinds;           /**< EDGE_TARGET_NEURON or EDGE_TARGET_CONNECTION */
+        std::vector<uint32_t> _sources;               /**< ID of the neuron a connection stems from */
+
+        /* Neuron state */
+        std::vector<float> _activation;
+        std::vector<float> _next_activation;
+        std::vector<float> _threshold;
+        std::vector<uint8_t> _was_activated;
+        std::vector<int64_t> _last_activated_step;
+        std::vector<int64_t> _last_fired_step;
+        std::vector<const NeuronParameterHandler*> _neuron_parameter;
+
+        /* Connection state */
+        std::vector<float> _base_weight;
+        std::vector<float> _short_weight;
+        std::vector<float> _long_weight;
+        std::vector<float> _long_learning_weight;
+        std::vector<float> _presynaptic_potential;
+        std::vector<int64_t> _last_presynaptic_activated_step;
+        std::vector<int64_t> _last_connection_step;
+        std::vector<int8_t> _activation_type;
+        std::vector<uint8_t> _activation_function;
+        std::vector<uint16_t> _transmitter_type;
+        std::vector<const ConnectionParameterHandler*> _connection_parameter;
+
+        /* Neurons whose connections are activated in this and in the next step. May contain duplicates. */
+        std::vector<uint32_t> _curr_neurons;
+        std::vector<uint32_t> _next_neurons;
+
+        /* A neuron is in _next_neurons of its network if its stamp equals the current epoch
+           and in _curr_neurons if it was received from another network in the previous epoch. */
+        std::vector<int64_t> _scheduled_epoch;
+        int64_t _schedule_epoch;
+
+        /* One bit per neuron marking _curr_neurons during a dense step. All zero between steps. */
+        std::vector<uint64_t> _frontier_bits;
+
+        /* Runs of connections sharing their kernel. The runs of neuron n are in [_run_offsets[n], _run_offsets[n+1]),
+           run r contains the connections [_run_starts[r], _run_starts[r+1]). Rows of short runs are a
+           single KERNEL_ANY_TYPE run, see MIN_KERNEL_RUN_LENGTH. */
+        std::vector<uint32_t> _run_offsets;
+        std::vector<uint32_t> _run_starts;
+        std::vector<uint8_t> _run_kernels;            /**< Kernel ID of each run, see kernel_id() */
+
+        /* 1 if the learning of all connections of a neuron can be batched, see batch_learning(). */
+        std::vector<uint8_t> _batch_learning_rows;
+
+        /* Connections between neurons of this network by their target, empty until build_incoming_connections().
+           The connections reaching neuron n are in _incoming[_incoming_offsets[n], _incoming_offsets[n+1]) in index order. */
+        std::vector<uint32_t> _incoming_offsets;
+        std::vector<uint32_t> _incoming;
+
+        /**
+         * @brief Compiles the object graph of a network.
+         *
+         * Presynaptic connections targeting connections of other networks are resolved
+         * with the help of the network list.
+         *
+         * @param nn              The network to compile.
+         * @param network_list    All networks of the cluster, indexed by their ID.
+         *
+         */
+        CompiledNetwork(NeuralNetwork *nn, const std::vector<NeuralNetwork*> &network_list);
+
+        /**
+         * @brief Frees all memory allocated by the compiled network. The object graph is not touched.
+         *
+         */
+        ~CompiledNetwork();
+
+        /**
+         * @brief Writes the compiled state back into the Neuron and Connection objects of the network.
+         *
+         * @param nn    The network this compiled network was built from.
+         *
+         */
+        void store_state(NeuralNetwork *nn);
+
+        /**
+         * @brief Returns the ID of the kernel propagating and learning a connection.
+         *
+         * Connections to neurons get one kernel per activation function and learning type, connections
+         * to connections one per learning type. Connections with an invalid type get KERNEL_ANY_TYPE.
+         *
+         * @param target_kind            EDGE_TARGET_NEURON or EDGE_TARGET_CONNECTION.
+         * @param activation_function    The activation function of the connection.
+         * @param learning_type          The learning type of the connection.
+         *
+         * @return                       KERNEL_ANY_TYPE or an ID in [1, CONNECTION_KERNEL_NUMBER[.
+         *
+         */
+        static int kernel_id(int target_kind, int activation_function, int learning_type);
+
+        /**
+         * @brief Bundles references to the learning state of a connection for the NetworkKernels.
+         *
+         * @param con    Index of the connection.
+         *
+         * @return       References into the flat connection arrays.
+         *
+         */
+        ConnectionStateRef connection_state(uint32_t con);
+
+        /**
+         * @brief Checks if a neuron has reached its threshold.
+         *
+         * @param neuron    ID of the neuron.
+         *
+         * @return          true if the neuron fires, false if not.
+         *
+         */
+        bool is_active(uint32_t neuron);
+
+        /**
+         * @brief Adds activation to a neuron and schedules its connections for this step.
+         *
+         * @param neuron        ID of the neuron.
+         * @param activation    The activation to add.
+         *
+         */
+        void init_activation(uint32_t neuron, float activation);
+
+        /**
+         * @brief Runs the learning of all connections of a firing neuron as one batch.
+         *
+         * Equivalent to calling NetworkKernels::basic_learning() for each connection of the neuron
+         * with NONDIRECTIONAL conditioning, except that the powers of the habituation and sensitization
+         * gradients of all connections are calculated together with VectorMath::pow(). The weights
+         * therefore only differ in rounding from the scalar learning.
+         *
+         * Only allowed for neurons marked in _batch_learning_rows. The connections of other neurons
+         * change the state of their own neuron or row while firing, so they have to learn one by one.
+         *
+         * @param neuron          ID of the firing neuron.
+         * @param network_step    The current step/tick count of the network.
+         *
+         */
+        void batch_learning(uint32_t neuron, int64_t network_step);
+
+        /**
+         * @brief Same as batch_learning(), but with scratch memory of the caller.
+         *
+         * @param buffers    Scratch memory prepared with reserve_learning_buffers().
+         *
+         */
+        void batch_learning(uint32_t neuron, int64_t network_step, LearningBuffers &buffers);
+
+        /**
+         * @brief Sizes scratch memory for the longest row of the network.
+         *
+         */
+        void reserve_learning_buffers(LearningBuffers &buffers) const;
+
+        /**
+         * @brief Calculates the activation a connection sends to its target neuron.
+         *
+         * Counterpart of Connection::activate_next_neuron().
+         *
+         * @tparam FUNCTION              The activation function of the connection or KERNEL_ANY_TYPE.
+         *
+         * @param con                    Index of the connection.
+         * @param target                 The compiled network containing the target neuron.
+         * @param network_step           The current step/tick count of the network.
+         * @param transmitter_weights    The weights of all neurotransmitters in the network.
+         *
+         */
+        template<int FUNCTION>
+        void activate_next_neuron(uint32_t con,
+                                  CompiledNetwork *target,
+                                  int64_t network_step,
+                                  const std::vector<float> &transmitter_weights);
+
+        /**
+         * @brief Calculates the activation a connection adds to its target neuron.
+         *
+         * Counterpart of Connection::neuron_force().
+         *
+         * @tparam FUNCTION              The activation function of the connection or KERNEL_ANY_TYPE.
+         *
+         * @param con                    Index of the connection.
+         * @param transmitter_weights    The weights of all neurotransmitters in the network.
+         *
+         * @return                       The added activation.
+         *
+         */
+        template<int FUNCTION>
+        float neuron_force(uint32_t con, const std::vector<float> &transmitter_weights);
+
+        /**
+         * @brief Calculates the backfall of the presynaptic potential of a connection before it fires.
+         *
+         * @param con             Index of the connection.
+         * @param network_step    The current step/tick count of the network.
+         *
+         */
+        void presynaptic_potential_backfall(uint32_t con, int64_t network_step);
+
+        /**
+         * @brief Applies the activation another network sent to a neuron or connection of this network.
+         *
+         * Neurons still have to be saved with save_received_neuron() after all deliveries of a step
+         * were received.
+         *
+         * @param delivery    The delivery from the inbox of the network.
+         *
+         */
+        void receive_delivery(const NetworkDelivery &delivery);
+
+        /**
+         * @brief Takes over the received activation of a neuron and adds it to the current step if it is activated.
+         *
+         * @param neuron          ID of the neuron.
+         * @param network_step    The step the activation was sent in.
+         *
+         */
+        void save_received_neuron(uint32_t neuron, int64_t network_step);
+
+        /**
+         * @brief Calculates the presynaptic activation of the connection a connection fires at.
+         *
+         * Counterpart of Connection::activate_next_connection().
+         *
+         * @param con             Index of the connection.
+         * @param target          The compiled network containing the target connection.
+         * @param network_step    The current step/tick count of the network.
+         *
+         */
+        void activate_next_connection(uint32_t con, CompiledNetwork *target, int64_t network_step);
+
+        /**
+         * @brief Sets the activation level of a neuron to its minimum, if it did fire.
+         *
+         * @param neuron          ID of the neuron.
+         * @param network_step    The current step/tick count of the network.
+         *
+         */
+        void clear_neuron_activation(uint32_t neuron, int64_t network_step);
+
+        /**
+         * @brief Adds a neuron to the neurons of the next step, if it is not already contained.
+         *
+         * @param neuron    ID of the neuron.
+         *
+         */
+        void schedule_neuron(uint32_t neuron);
+
+        /**
+         * @brief Marks all neurons of the current step in the frontier bitmap. Duplicates collapse.
+         *
+         */
+        void load_frontier_bits();
+
+        /**
+         * @brief Unmarks all neurons of the current step in the frontier bitmap.
+         *
+         */
+        void clear_frontier_bits();
+
+        /**
+         * @brief Builds the incoming connections of every neuron from the predecessors in the object graph.
+         *
+         * Only needed by steps gathering the forces at their targets, so it is not part of compiling.
+         *
+         */
+        void build_incoming_connections();
+
+        /**
+         * @brief Moves the flat arrays of the network to a NUMA node, see CpuPlacement::bind_memory().
+         *
+         * @param node    The NUMA node of the worker stepping the network.
+         *
+         * @return        Error code. ERROR_CODE if an array could not be moved.
+         *
+         */
+        int bind_to_node(int node);
+
+        /**
+         * @brief Touches every page of the flat arrays and the scheduling lists, see RealtimeProfile::prefault_memory().
+         *
+         */
+        void prefault();
+
+        /**
+         * @brief Moves the neurons of the next step to the current step.
+         *
+         */
+        void switch_vectors();
+
+    private:
+        std::vector<Neuron*> _neuron_objects;
+        std::vector<Connection*> _connection_objects;
+
+        uint32_t _max_row_length;
+        LearningBuffers _learning_buffers;            /**< Used by batch_learning() without own buffers */
+
+        /**
+         * @brief Converts a list of scheduled neurons of the object graph into a list of neuron IDs.
+         *
+         */
+        void load_scheduled_neurons(const std::vector<Neuron*> &neuron_objects, std::vector<uint32_t> &neurons);
+
+        /**
+         * @brief Converts a list of scheduled neuron IDs back into the neuron list of the object graph.
+         *
+         */
+        void store_scheduled_neurons(const std::vector<uint32_t> &neurons, std::vector<Neuron*> &neuron_objects);
+    };
+}
+
+#endif /* INCLUDE_COMPILEDNETWORK_HPP */
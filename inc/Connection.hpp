@@ -23,6 +23,7 @@
 #include <vector>
 #include <cstdint>
 #include <cstdlib>
+#include "NetworkKernels.hpp"
 
 namespace COGNA{
     class Neuron;
@@ -45,8 +46,11 @@ namespace COGNA{
         /**
          * @brief Contains the parameters specifiying connection behavior.
          *
+         * The profile is shared with other connections and owned by the ParameterProfilePool of the
+         * network. Use set_parameter() to change it.
+         *
          */
-        COGNA::ConnectionParameterHandler *_parameter;
+        const COGNA::ConnectionParameterHandler *_parameter;
 
         float base_weight;        /**< Base weight where learning processes always slowly return to */
         float short_weight;       /**< Weight of this connection changing for short term learning. This one is directly used */
@@ -61,13 +65,10 @@ namespace COGNA{
         /**
          * @brief Initializes all behavior relevant parameter of Connection.
          *
-         * Inherits the connection-specific parameters of the neuron, where
-         * the connection is stored in.
-         *
-         * @param default_parameter    Parameters from source neuron.
+         * @param parameter    Interned parameter profile of the connection, usually derived from the source neuron.
          *
          */
-        Connection(COGNA::NeuronParameterHandler *default_parameter);
+        Connection(const COGNA::ConnectionParameterHandler *parameter);
 
         /**
          * @brief Frees all memory allocated by the connection.
@@ -75,6 +76,17 @@ namespace COGNA{
          */
         ~Connection();
 
+        /**
+         * @brief Replaces the parameters of this connection copy-on-write.
+         *
+         * The shared profile is not changed. Instead the new parameters are interned in the
+         * profile pool of the network of the source neuron.
+         *
+         * @param parameter    The complete new parameter set.
+         *
+         */
+        void set_parameter(const COGNA::ConnectionParameterHandler &parameter);
+
         /**
          * @brief A wrapper including all learning functions of a connection
          *
@@ -94,7 +106,35 @@ namespace COGNA{
          * @param transmitter_weights    A vector containing the weights all neurotransmitters in the network
          *
          */
-        void activate_next_neuron(int64_t network_step, std::vector<float> transmitter_weights);
+        void activate_next_neuron(int64_t network_step, const std::vector<float> &transmitter_weights);
+
+        /**
+         * @brief Calculates the activation the connection adds to the neuron it fires at.
+         *
+         * @param transmitter_weights    A vector containing the weights all neurotransmitters in the network
+         *
+         * @return                       The added activation.
+         *
+         */
+        float neuron_force(const std::vector<float> &transmitter_weights);
+
+        /**
+         * @brief Calculates the backfall of the presynaptic potential of this connection before it fires.
+         *
+         * @param network_step    The current step/tick count of the network.
+         *
+         */
+        void presynaptic_potential_backfall(int64_t network_step);
+
+        /**
+         * @brief Calculates the learning of this connection when another connection fires at it.
+         *
+         * @param network_step       The current step/tick count of the network.
+         * @param activation         The activation of the neuron the other connection stems from.
+         * @param activation_type    The type of the other connection.
+         *
+         */
+        void receive_presynaptic_activation(int64_t network_step, float activation, int activation_type);
 
         /**
          * @brief Calculates the presynaptic activation of a certain connection fired at.
@@ -106,95 +146,12 @@ namespace COGNA{
 
         private:
             /**
-             * @brief Calculates the backfall of the factor which reduces longterm learning after some time of nonactivation.
-             *
-             * Based on a static gradient, the backfall of the reducing factor for
-             * longterm learning is calculated. The longer the connection did not
-             * fire, the more @c #long_learning_weight falls back to 1.0.
-             *
-             * @param network_step    The current step/tick count of the network.
-             *
-             */
-            void long_learning_weight_backfall(int64_t network_step);
-
-            /**
-             * @brief Calculates the reduction of long term learning after repeated activation.
-             *
-             * Based on a dynamic gradient, the reduction of longterm learning
-             * is calculated. The more often the connection is activated, the
-             * more reduction happens.
-             *
-             * @param network_step    The current step/tick count of the network.
-             *
-             */
-            void long_learning_weight_reduction(int64_t network_step);
-
-            /**
-             * @brief Calculates habituation of connection if weakly activated.
-             *
-             * Can happen directly by weak activation of this connection, or by
-             * a presynaptic connection, which acts as a conditioning input.
-             *
-             * @param network_step        The current step/tick count of the network.
-             * @param conditioning_con    Another connection which is connected to this one.
-             *
-             */
-            void habituate(int64_t network_step, Connection *conditioning_con=NULL);
-
-            /**
-             * @brief Calculates sansitization of connection if strongly activated.
-             *
-             * Can happen directly by strong activation of this connection, or by
-             * a presynaptic connection, which acts as a conditioning input.
-             *
-             * @param network_step        The current step/tick count of the network.
-             * @param conditioning_con    Another connection which is connected to this one.
-             *
-             */
-            void sensitize(int64_t network_step, Connection *conditioning_con=NULL);
-
-            /**
-             * @brief Calculates dehabituation of connection after time.
-             *
-             * The more steps/ticks pass since last activation, the more the
-             * connection dehabituates.
-             *
-             * @param network_step    The current step/tick count of the network.
-             *
-             */
-            void dehabituate(int64_t network_step);
-
-            /**
-             * @brief Calculates desensitization of connection after time.
-             *
-             * The more steps/ticks pass since last activation, the more the
-             * connection desensitizes.
-             *
-             * @param network_step    The current step/tick count of the network.
-             *
-             */
-            void desensitize(int64_t network_step);
-
-            /**
-             * @brief Calculates backfall of presynaptic potential, if the connection is not presynaptically activated.
-             *
-             * The more steps/ticks pass since last activation, the more the
-             * presynaptic potential falls back to a neutral state.
-             *
-             * @param network_step    The current step/tick count of the network.
-             *
-             */
-            void presynaptic_potential_backfall(int64_t network_step);
-
-            /**
-             * @brief Decides which activation function should be used for activation.
-             *
-             * @param input    The input value for the function.
+             * @brief Bundles references to the learning state of this connection for the NetworkKernels.
              *
-             * @return         The result of the function.
+             * @return    References to the mutable members of this connection.
              *
              */
-            float choose_activation_function(float input);
+            ConnectionStateRef state();
     };
 }
 
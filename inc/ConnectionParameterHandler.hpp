@@ -11,7 +11,11 @@
 #ifndef INCLUDE_CONNECTIONPARAMETERHANDLER_HPP
 #define INCLUDE_CONNECTIONPARAMETERHANDLER_HPP
 
+#include <cstddef>
+
 namespace COGNA{
+    class GradientEvaluator;
+
     /**
      * @brief A class containing all parameters for a connection
      *
@@ -58,10 +62,42 @@ namespace COGNA{
             float habituation_threshold;
             float sensitization_threshold;
 
+            /* Power tables of the step based gradients. Set by bind_gradients(), not part of equals() and hash(). */
+            const GradientEvaluator *short_dehabituation_gradient;
+            const GradientEvaluator *short_desensitization_gradient;
+            const GradientEvaluator *long_dehabituation_gradient;
+            const GradientEvaluator *long_desensitization_gradient;
+            const GradientEvaluator *presynaptic_backfall_gradient;
+            const GradientEvaluator *long_learning_weight_reduction_gradient;
+            const GradientEvaluator *long_learning_weight_backfall_gradient;
+
             /**
              * @brief First definition of parameters
              */
             ConnectionParameterHandler();
+
+            /**
+             * @brief Compares all parameters with the parameters of another handler.
+             *
+             * @param other    The handler to compare with.
+             *
+             * @return         true if all parameters are equal, false if not.
+             */
+            bool equals(const ConnectionParameterHandler &other) const;
+
+            /**
+             * @brief Calculates a hash over all parameters. Equal handlers have equal hashes.
+             *
+             * @return    The hash value.
+             */
+            size_t hash() const;
+
+            /**
+             * @brief Looks up the gradient evaluators of the current curvatures.
+             *
+             * Has to be called again after a curvature changed. Until then the gradients fall back to pow().
+             */
+            void bind_gradients();
     };
 }
 
@@ -14,15 +14,6 @@
 namespace COGNA{
     const bool DATA_ANALYTIC_OUTPUT = false;
 
-    const bool DEBUG_MODE = true;
-    const bool DEB_BASE = true;
-    const bool DEB_HABITUATION = false;
-    const bool DEB_SENSITIZATION = false;
-    const bool DEB_TRANSMITTER = false;
-    const bool DEB_NEURON_BACKFALL = false;
-    const bool DEB_LONG_LEARNING_WEIGHT = false;
-    const bool DEB_PRESYNAPTIC = true;
-
     const int SYNAPTIC_NO_ID = -5;
 
     const int STATE_RUNNING = 0;
@@ -33,6 +24,7 @@ namespace COGNA{
     const int ERROR_CODE = -1;
 
     const int MICROSECOND_FACTOR = 1000000;
+    const int FREE_RUNNING_BATCH = 64;    // Steps a free-running cluster without I/O takes between two stop checks
     const int MIN_NEURON_ID = 1;
 
     const int MIN_TRANSMITTER_WEIGHT = 0;
@@ -62,6 +54,8 @@ namespace COGNA{
     const int LEARNING_SENSITIZATION = 3;
     const int LEARNING_HABISENS = 4;
 
+    const int KERNEL_ANY_TYPE = 0;    // Template argument of kernels reading the function or learning type at runtime
+
     const int POSITIVE_INFLUENCE = 1;
     const int NEGATIVE_INFLUENCE = -1;
 
@@ -73,6 +67,11 @@ namespace COGNA{
 
     const int NODE_TARGET_NEURON = 1;
     const int NODE_TARGET_NODE = 2;
+
+    const int EDGE_TARGET_NEURON = 1;
+    const int EDGE_TARGET_CONNECTION = 2;
+
+    const int POWER_TABLE_SIZE = 1024;
 }
 
 #endif /* INCLUDE_CONSTANTS_HPP */
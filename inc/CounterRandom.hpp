@@ -0,0 +1,85 @@
+/**
+ * @file CounterRandom.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief A counter-based random number generator (Philox4x32-10) for the random activation of neurons.
+ *
+ * **Note:**
+ * A counter-based generator has no state which advances with every number. Each number is a
+ * function of the seed, a stream and a counter, e.g. the network ID, the step and the neuron ID.
+ * Networks stepped by different workers therefore never share or lock a generator, and the
+ * numbers drawn in a step do not depend on which numbers were drawn before. Runs with the
+ * same seed are bitwise reproducible, independent of the order the networks are stepped in.
+ *
+ * The generator is Philox4x32-10 of Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3" (2011).
+ *
+ * @date 2021-07-21
+ *
+ */
+
+#ifndef INCLUDE_COUNTERRANDOM_HPP
+#define INCLUDE_COUNTERRANDOM_HPP
+
+#include <cstdint>
+
+namespace COGNA{
+    /**
+     * @brief Class containing the key of a single random stream.
+     *
+     */
+    class CounterRandom{
+    public:
+        /**
+         * @brief Initializes a stream of a seed.
+         *
+         * @param seed      The seed shared by all streams of a cluster.
+         * @param stream    The stream, usually the ID of the network.
+         *
+         */
+        CounterRandom(uint64_t seed=0, uint32_t stream=0);
+
+        /**
+         * @brief Changes the seed and keeps the stream.
+         *
+         */
+        void set_seed(uint64_t seed);
+
+        /**
+         * @brief Returns the seed of the stream.
+         *
+         */
+        uint64_t seed() const;
+
+        /**
+         * @brief Calculates the block of four random words of a counter.
+         *
+         * @param counter    Usually the step of the network.
+         * @param index      Usually the ID of the neuron.
+         * @param words      Receives the four words.
+         *
+         */
+        void block(uint64_t counter, uint32_t index, uint32_t words[4]) const;
+
+        /**
+         * @brief Returns an equally distributed number in [0, bound[.
+         *
+         * Uses the first word of the block. The bias is below bound / 2^32.
+         *
+         */
+        uint32_t below(uint32_t bound, uint64_t counter, uint32_t index) const;
+
+        /**
+         * @brief Returns an equally distributed number in ]0, 1] with 53 random bits.
+         *
+         * Uses the last two words of the block, so it is independent of below() with the same counter.
+         *
+         */
+        double uniform(uint64_t counter, uint32_t index) const;
+
+    private:
+        uint32_t _key[2];
+        uint32_t _stream;
+    };
+}
+
+#endif /* INCLUDE_COUNTERRANDOM_HPP */
@@ -0,0 +1,105 @@
+/**
+ * @file CpuPlacement.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief A class pinning threads to CPUs and moving memory to NUMA nodes.
+ *
+ * **Note:**
+ * CPU sets are written like the cpuset lists of Linux, e.g. "0-3,8,10-11". A memory range is
+ * moved to a node with mbind(), which also migrates pages the builder already touched while the
+ * networks were loaded. The node is only preferred, so allocations still succeed if it is full.
+ *
+ * On systems other than Linux threads are not pinned and memory is not moved.
+ *
+ * @date 2021-07-20
+ *
+ */
+
+#ifndef INCLUDE_CPUPLACEMENT_HPP
+#define INCLUDE_CPUPLACEMENT_HPP
+
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace COGNA{
+    /**
+     * @brief Class containing static placement functions.
+     */
+    class CpuPlacement{
+        public:
+            /**
+             * @brief Parses a list of CPUs like "0-3,8,10-11".
+             *
+             * @param text    The list. Ranges include both ends.
+             * @param cpus    Receives the CPUs, ascending and without duplicates.
+             *
+             * @return        Error code. ERROR_CODE if the list is empty or malformed.
+             */
+            static int parse_cpu_list(const std::string &text, std::vector<int> &cpus);
+
+            /**
+             * @brief Writes a list of CPUs in the format read by parse_cpu_list().
+             *
+             */
+            static std::string format_cpu_list(const std::vector<int> &cpus);
+
+            /**
+             * @brief Restricts a thread to a set of CPUs.
+             *
+             * @param thread    Native handle of the thread, see std::thread::native_handle().
+             * @param cpus      The CPUs the thread may run on.
+             *
+             * @return          Error code. ERROR_CODE if the thread could not be pinned.
+             */
+            static int pin_thread(std::thread::native_handle_type thread, const std::vector<int> &cpus);
+
+            /**
+             * @brief Restricts the calling thread to a set of CPUs.
+             *
+             * @return          Error code. ERROR_CODE if the thread could not be pinned.
+             */
+            static int pin_current_thread(const std::vector<int> &cpus);
+
+            /**
+             * @brief Returns the NUMA node a CPU belongs to.
+             *
+             * @return    The node, -1 if it is not known.
+             */
+            static int numa_node(int cpu);
+
+            /**
+             * @brief Reads the CPUs the kernel keeps free of other tasks, e.g. with the boot parameter isolcpus.
+             *
+             * @param cpus    Receives the isolated CPUs, empty if there are none.
+             *
+             * @return        Error code. ERROR_CODE if the list could not be read.
+             */
+            static int isolated_cpus(std::vector<int> &cpus);
+
+            /**
+             * @brief Moves the whole pages of a memory range to a NUMA node and prefers it for future pages.
+             *
+             * Pages the range only partly covers are left where they are, since they belong to other objects.
+             *
+             * @param memory    Start of the range.
+             * @param size      Number of bytes.
+             * @param node      The NUMA node.
+             *
+             * @return          Error code. ERROR_CODE if the kernel refused to move the range.
+             */
+            static int bind_memory(const void *memory, size_t size, int node);
+
+            /**
+             * @brief Moves the elements of a vector to a NUMA node, see bind_memory().
+             *
+             */
+            template<typename T>
+            static int bind_vector(const std::vector<T> &vector, int node){
+                return bind_memory(vector.data(), vector.size() * sizeof(T), node);
+            }
+    };
+}
+
+#endif /* INCLUDE_CPUPLACEMENT_HPP */
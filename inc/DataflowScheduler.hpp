@@ -0,0 +1,126 @@
+/**
+ * @file DataflowScheduler.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Steps every network of a cluster as soon as the deliveries it depends on are complete.
+ *
+ * **Note:**
+ * A network applies the deliveries its upstream networks sent in their previous step at the start
+ * of its own step, see NetworkInbox. Step s of a network can therefore start as soon as all of its
+ * upstream networks finished step s - 1. Since the inbox only keeps two buffers per sender, it also
+ * has to wait until its downstream networks finished step s - 1, which applied the deliveries of its
+ * step s - 2 from the buffer step s writes to. Connected networks stay at most one step apart, while
+ * networks without connections between them step freely within run().
+ *
+ * The edges between networks are taken from the compiled cluster when the scheduler is created.
+ * Each worker of the WorkerPool repeatedly claims a network which is ready and steps it, so the
+ * results are the same as if all networks took their steps together.
+ *
+ * @date 2021-07-19
+ *
+ */
+
+#ifndef INCLUDE_DATAFLOWSCHEDULER_HPP
+#define INCLUDE_DATAFLOWSCHEDULER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "WorkerPool.hpp"
+
+namespace COGNA{
+    class NeuralNetwork;
+
+    /**
+     * @brief Class containing the network graph of a cluster and the progress of every network.
+     *
+     */
+    class DataflowScheduler{
+    public:
+        /**
+         * @brief Derives the edges between the networks of a compiled cluster.
+         *
+         * @param network_list    All networks of the cluster, indexed by their ID. Must not change their topology afterwards.
+         * @param pool            The workers stepping the networks. Has to outlive the scheduler.
+         *
+         */
+        DataflowScheduler(const std::vector<NeuralNetwork*> &network_list, WorkerPool *pool);
+
+        /**
+         * @brief Lets every network take a number of steps and returns when all of them finished.
+         *
+         * @param steps    Number of steps of every network.
+         *
+         */
+        void run(int64_t steps);
+
+        /**
+         * @brief Returns the IDs of the networks sending deliveries to a network.
+         *
+         */
+        const std::vector<int> &upstream_networks(int network_id) const;
+
+        /**
+         * @brief Returns the IDs of the networks a network sends deliveries to.
+         *
+         */
+        const std::vector<int> &downstream_networks(int network_id) const;
+
+        /**
+         * @brief Returns the number of groups of networks without any edges between the groups.
+         *
+         */
+        int group_count() const;
+
+        /**
+         * @brief Returns the largest number of steps a network was ahead of another one during run().
+         *
+         */
+        int64_t max_lead() const;
+
+        /**
+         * @brief Prints the groups of networks and the idle scans of the workers to std output.
+         *
+         */
+        void print_statistics() const;
+
+    private:
+        /* Padded, so two networks never share a cache line */
+        struct NetworkSlot{
+            std::atomic<int64_t> _steps;            // Steps the network finished since the scheduler was created
+            std::atomic<int> _claimed;              // 1 while a worker steps the network
+            char _padding[112];
+        };
+
+        std::vector<NeuralNetwork*> _network_list;
+        std::vector<int> _networks;                 // IDs of all networks of the list
+        std::vector<std::vector<int>> _upstream;    // Indexed by network ID
+        std::vector<std::vector<int>> _downstream;
+        std::vector<std::vector<int>> _neighbours;  // Upstream and downstream networks
+        std::vector<NetworkSlot> _slots;            // Indexed by network ID
+        std::vector<int> _groups;                   // Group of every network, indexed by network ID
+        int _group_count;
+
+        WorkerPool *_pool;
+        std::vector<std::function<void()>> _tasks;  // One loop per worker
+        int64_t _target_steps;
+        std::atomic<uint32_t> _finished_networks;
+        std::atomic<uint64_t> _idle_scans;
+        std::atomic<int64_t> _max_lead;
+
+        /**
+         * @brief Claims and steps ready networks until all networks reached the target.
+         *
+         */
+        void process(int worker);
+
+        /**
+         * @brief Checks if all neighbours of a network finished the step before its next one.
+         *
+         */
+        bool is_ready(int network_id, int64_t steps) const;
+    };
+}
+
+#endif /* INCLUDE_DATAFLOWSCHEDULER_HPP */
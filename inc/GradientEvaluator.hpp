@@ -0,0 +1,82 @@
+/**
+ * @file GradientEvaluator.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief A class evaluating gradient curves over step counts with precomputed powers.
+ *
+ * Backfall, dehabituation and desensitization evaluate pow(x, curvature) every time a neuron or
+ * connection is touched, where x is the number of steps since its last activation and the
+ * curvature is one of a few values configured per project. An evaluator stores pow(k, curvature)
+ * for all small k, so these gradients do not have to call pow() anymore.
+ *
+ * @date 2021-07-09
+ *
+ */
+
+#ifndef INCLUDE_GRADIENTEVALUATOR_HPP
+#define INCLUDE_GRADIENTEVALUATOR_HPP
+
+#include <cstdint>
+#include "Constants.hpp"
+
+namespace COGNA{
+    /**
+     * @brief Class containing the power table of a single curvature.
+     *
+     */
+    class GradientEvaluator{
+        public:
+            /**
+             * @brief Fills the power table of the curvature.
+             *
+             * @param curvature    The power factor of the gradients calculated with this evaluator.
+             *
+             */
+            GradientEvaluator(float curvature);
+
+            /**
+             * @brief Returns the evaluator of a curvature. All callers share one evaluator per distinct curvature.
+             *
+             * Evaluators are created on first use and kept until the program ends.
+             *
+             * @param curvature    The power factor of the gradient.
+             *
+             * @return             The evaluator, NULL if the curvature is not a number.
+             *
+             */
+            static const GradientEvaluator *get(float curvature);
+
+            /**
+             * @brief Calculates the static gradient function like MathUtils::calculate_static_gradient().
+             *
+             * The result is bitwise equal to MathUtils::calculate_static_gradient(). The power is taken
+             * from the table if the evaluator belongs to power_factor and x is inside of the table.
+             * Otherwise pow() is called, so a missing or outdated evaluator only costs speed.
+             *
+             * @param evaluator       The evaluator of power_factor. May be NULL.
+             * @param source_value    Value which should be manipulated.
+             * @param curve_factor    Defines how wide the curve of the function is.
+             * @param x               Step count the gradient is evaluated at.
+             * @param power_factor    Defines how steep the function is.
+             * @param method          Can be ADD or SUBTRACT. Defines if function increases or decreases.
+             * @param max             Max value the function can return.
+             * @param min             Min value the function can return.
+             *
+             * @return         Result of function.
+             */
+            static float static_gradient(const GradientEvaluator *evaluator,
+                                         float source_value,
+                                         float curve_factor,
+                                         int64_t x,
+                                         float power_factor,
+                                         int method,
+                                         float max,
+                                         float min);
+
+        private:
+            float _curvature;
+            double _powers[POWER_TABLE_SIZE];    /**< _powers[k] = pow(k, _curvature) */
+    };
+}
+
+#endif /* INCLUDE_GRADIENTEVALUATOR_HPP */
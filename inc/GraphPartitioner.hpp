@@ -0,0 +1,158 @@
+/**
+ * @file GraphPartitioner.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Splits the neurons of a cluster into balanced shards with few connections between them.
+ *
+ * **Note:**
+ * Every neuron is weighted with the work it causes per step, which is its number of connections times
+ * its firing rate. Every connection is weighted with the firing rate of its source. Without a profiling
+ * run, all neurons count as firing in every step. A connection targeting another connection couples
+ * its source with the neuron the target connection stems from.
+ *
+ * The partitioner works in three steps, all of them in a fixed order, so the same cluster and profile
+ * always give the same partition:
+ *
+ * 1. Clustering: Every neuron starts in its own cluster and joins the cluster it is connected to the
+ *    most (label propagation), as long as the cluster stays below the average weight of a shard.
+ * 2. Packing: The clusters are placed on the shards from the heaviest to the lightest, each of them
+ *    on the lightest shard.
+ * 3. Refinement: Every neuron moves to the shard it is connected to the most, as long as that shard
+ *    does not exceed its capacity.
+ *
+ * @date 2021-07-18
+ *
+ */
+
+#ifndef INCLUDE_GRAPHPARTITIONER_HPP
+#define INCLUDE_GRAPHPARTITIONER_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace COGNA{
+    const float PARTITION_IMBALANCE = 0.05f;    /**< A shard may exceed the average weight by this fraction */
+    const int PARTITION_PASSES = 16;            /**< Maximum number of label propagation passes */
+    const float PARTITION_MIN_RATE = 0.01f;     /**< Firing rate of silent neurons, so their connections still count */
+
+    class NeuralNetwork;
+
+    /**
+     * @brief Result of a partitioning. Consumed by CognaLauncher and NeuralNetwork::set_partition().
+     *
+     */
+    class PartitionMap{
+        public:
+            int _shard_number;
+            std::vector<std::vector<uint16_t>> _neuron_shards;  /**< Shard of every neuron, indexed by network and neuron ID */
+            std::vector<int> _network_shards;                   /**< Shard holding the largest weight of a network, -1 if none */
+            std::vector<double> _shard_weights;                 /**< Summed weight of the neurons of every shard */
+            double _cut_weight;                                 /**< Summed weight of connections between shards */
+            double _connection_weight;                          /**< Summed weight of all connections */
+            uint64_t _cut_connections;                          /**< Number of connections between shards */
+            uint64_t _connections;                              /**< Number of all connections */
+
+            /**
+             * @brief Initializes an empty map.
+             *
+             */
+            PartitionMap();
+
+            /**
+             * @brief Returns the shard of a neuron, 0 if it is not part of the map.
+             *
+             */
+            int shard_of(int network_id, uint32_t neuron_id) const;
+
+            /**
+             * @brief Returns the weight of the heaviest shard divided by the average weight.
+             *
+             */
+            float imbalance() const;
+
+            /**
+             * @brief Prints the weight of every shard and the cut to std output.
+             *
+             */
+            void print_statistics() const;
+    };
+
+    /**
+     * @brief Class containing the graph of a cluster and its firing profile.
+     *
+     */
+    class GraphPartitioner{
+        public:
+            /**
+             * @brief Reads the connections of all networks. The networks must not change their topology afterwards.
+             *
+             * @param network_list    All networks of the cluster, indexed by their ID.
+             *
+             */
+            GraphPartitioner(const std::vector<NeuralNetwork*> &network_list);
+
+            /**
+             * @brief Counts the neurons which fired in the last step of every network.
+             *
+             * Called after every step of a profiling run.
+             *
+             */
+            void profile_step();
+
+            /**
+             * @brief Returns the number of steps profiled so far.
+             *
+             */
+            int64_t profiled_steps() const;
+
+            /**
+             * @brief Splits the neurons of the cluster into shards.
+             *
+             * @param shard_number    Number of shards. Clamped to [1, 65535].
+             *
+             * @return                The partition map.
+             *
+             */
+            PartitionMap partition(int shard_number);
+
+        private:
+            std::vector<NeuralNetwork*> _network_list;
+            std::vector<uint32_t> _network_offsets;             // Neurons of network i are [_network_offsets[i], _network_offsets[i+1])
+            std::vector<uint32_t> _fan_out;
+
+            /* Neighbours of both directions. The neighbours of neuron v are in [_offsets[v], _offsets[v+1]),
+               _sources tells which end of the connection fires. */
+            std::vector<uint32_t> _offsets;
+            std::vector<uint32_t> _neighbours;
+            std::vector<uint32_t> _sources;
+
+            std::vector<std::vector<uint32_t>> _fired_counts;  // Indexed by network and neuron ID
+            int64_t _profiled_steps;
+
+            /**
+             * @brief Returns the firing rate of every neuron during profiling, 1 if nothing was profiled.
+             *
+             */
+            std::vector<float> firing_rates() const;
+
+            /**
+             * @brief Moves every neuron to the label it is connected to the most, until no neuron moves anymore.
+             *
+             * @param labels          Label of every neuron, e.g. its cluster or its shard.
+             * @param label_weights   Summed weight of the neurons of every label.
+             * @param capacity        Maximum weight of a label a neuron may move to.
+             *
+             */
+            void propagate_labels(std::vector<uint32_t> &labels, std::vector<double> &label_weights, double capacity,
+                                  const std::vector<double> &weights, const std::vector<float> &rates) const;
+
+            /**
+             * @brief Adds a connection to the list of connections of its source, for building the neighbours.
+             *
+             */
+            void add_connection(std::vector<uint32_t> &sources, std::vector<uint32_t> &targets,
+                                uint32_t source, int target_network_id, uint32_t target_id);
+    };
+}
+
+#endif /* INCLUDE_GRAPHPARTITIONER_HPP */
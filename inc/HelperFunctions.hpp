@@ -2,6 +2,8 @@
 #define INCLUDE_HELPERFUNCTIONS_HPP
 
 #include <ctime>
+#include <cstddef>
+#include <functional>
 
 namespace utils{
 
@@ -17,6 +19,18 @@ namespace utils{
  */
 long get_time_microsec(struct timeval time);
 
+/**
+ * @brief Mixes the hash of a value into an existing hash.
+ *
+ * @param seed     The hash to mix the value into.
+ * @param value    The value to hash.
+ *
+ */
+template <typename T>
+inline void hash_combine(size_t &seed, const T &value){
+    seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
 } //namespace utils
 
 #endif //INCLUDE_HELPERFUNCTIONS_HPP
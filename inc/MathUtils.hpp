@@ -73,6 +73,28 @@ namespace COGNA{
                                                     float max=100.0f,
                                                     float min=0.0f);
 
+            /**
+             * @brief Applies an already calculated power to the source value like calculate_dynamic_gradient().
+             *
+             * Used by batched learning, which calculates the powers of many connections at once.
+             * With power = pow(x, power_factor) the result is bitwise equal to calculate_dynamic_gradient().
+             *
+             * @param source_value    Value which should be manipulated.
+             * @param curve_factor    Defines how wide the curve of the function is.
+             * @param power           The x value of the function raised to the power factor.
+             * @param method          Can be ADD or SUBTRACT. Defines if function increases or decreases.
+             * @param max             Max value the function can return.
+             * @param min             Min value the function can return.
+             *
+             * @return         Result of function.
+             */
+            static float apply_dynamic_gradient(float source_value,
+                                                float curve_factor,
+                                                double power,
+                                                int method=ADD,
+                                                float max=100.0f,
+                                                float min=0.0f);
+
             /**
              * @brief Calculates the static gradient function.
              *
@@ -0,0 +1,144 @@
+/**
+ * @file NetworkArena.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief A region allocator storing the neurons, connections and parameter profiles of a network.
+ *
+ * Objects are placed one after another in large chunks in the order they are created, so
+ * a neuron and its connections usually share cache lines and pages instead of being scattered
+ * across the heap. Destroying an object only runs its destructor. The memory of all objects is
+ * returned at once when the arena is deleted together with its network.
+ *
+ * Chunks can optionally be backed by transparent huge pages, which reduces TLB misses of large
+ * networks on Linux.
+ *
+ * @date 2021-07-13
+ *
+ */
+
+#ifndef INCLUDE_NETWORKARENA_HPP
+#define INCLUDE_NETWORKARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace COGNA{
+    const size_t ARENA_MIN_CHUNK_SIZE = 64 * 1024;          /**< Size of the first chunk, later chunks double */
+    const size_t ARENA_MAX_CHUNK_SIZE = 2 * 1024 * 1024;    /**< Size of a huge page */
+
+    /**
+     * @brief Class containing the memory chunks of a single network.
+     *
+     */
+    class NetworkArena{
+    public:
+        /**
+         * @brief Initializes an empty arena. No memory is allocated before the first object.
+         *
+         */
+        NetworkArena();
+
+        /**
+         * @brief Frees all chunks. Destructors of remaining objects are not called.
+         *
+         */
+        ~NetworkArena();
+
+        /**
+         * @brief Selects if chunks allocated from now on are backed by transparent huge pages.
+         *
+         * Huge page chunks are ARENA_MAX_CHUNK_SIZE large and aligned. Enabling them starts a new
+         * chunk with the next object. Ignored on systems without transparent huge pages.
+         *
+         * @param huge_pages    true to use huge pages.
+         *
+         */
+        void set_huge_pages(bool huge_pages);
+
+        /**
+         * @brief Moves all chunks to a NUMA node and allocates chunks added later on it.
+         *
+         * @param node    The NUMA node of the worker stepping the network.
+         *
+         * @return        Error code. ERROR_CODE if a chunk could not be moved.
+         *
+         */
+        int bind_to_node(int node);
+
+        /**
+         * @brief Returns the NUMA node the chunks are bound to, -1 if they are not bound.
+         *
+         */
+        int numa_node() const;
+
+        /**
+         * @brief Touches every page of all chunks, including the parts not allocated yet.
+         *
+         */
+        void prefault();
+
+        /**
+         * @brief Returns uninitialized memory from the current chunk, starting a new one if it is full.
+         *
+         * @param size         Number of bytes.
+         * @param alignment    Alignment of the memory, a power of two.
+         *
+         * @return             The memory. Valid until the arena is deleted.
+         *
+         */
+        void *allocate(size_t size, size_t alignment);
+
+        /**
+         * @brief Constructs an object in the arena.
+         *
+         */
+        template<typename T, typename... Args>
+        T *create(Args&&... args){
+            return new(allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Destructs an object of the arena. Its memory is only reused after the arena is deleted.
+         *
+         */
+        template<typename T>
+        void destroy(const T *object){
+            if(std::is_trivially_destructible<T>::value == false && object != NULL){
+                object->~T();
+            }
+        }
+
+        /**
+         * @brief Returns the number of bytes handed out by allocate().
+         *
+         */
+        size_t allocated_bytes() const;
+
+        /**
+         * @brief Returns the number of chunks the arena consists of.
+         *
+         */
+        size_t chunk_count() const;
+
+    private:
+        std::vector<void*> _chunks;
+        std::vector<size_t> _chunk_sizes;
+        char *_current;
+        size_t _remaining;
+        size_t _next_chunk_size;
+        size_t _allocated_bytes;
+        bool _huge_pages;
+        int _numa_node;
+
+        /**
+         * @brief Allocates a chunk of at least min_size bytes and makes it the current chunk.
+         *
+         */
+        void add_chunk(size_t min_size);
+    };
+}
+
+#endif /* INCLUDE_NETWORKARENA_HPP */
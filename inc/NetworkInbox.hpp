@@ -0,0 +1,111 @@
+/**
+ * @file NetworkInbox.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief The buffers through which networks of a cluster activate each other.
+ *
+ * **Note:**
+ * A network never changes the state of another network directly. Activations of neurons and
+ * presynaptic connections in other networks are stored as deliveries in the inbox of the target
+ * network, which applies them at the start of its next step.
+ *
+ * The inbox keeps one buffer per sending network and step parity. A buffer is only written by
+ * the thread stepping its sender and only read by the thread stepping the receiver one step later,
+ * while the sender already writes to the other parity. No locks are required as long as all
+ * networks of a cluster finish a step before any network starts the next one, which the
+ * WorkerPool of the CognaLauncher guarantees. Deliveries are applied in the order of the
+ * sender IDs, so the result does not depend on thread timing.
+ *
+ * @date 2021-07-14
+ *
+ */
+
+#ifndef INCLUDE_NETWORKINBOX_HPP
+#define INCLUDE_NETWORKINBOX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace COGNA{
+    class Connection;
+
+    const uint8_t DELIVERY_NEURON = 0;
+    const uint8_t DELIVERY_CONNECTION = 1;
+
+    /**
+     * @brief A single activation sent into another network.
+     *
+     */
+    struct NetworkDelivery{
+        int64_t step;                   /**< Step of the sending network */
+        COGNA::Connection *connection;  /**< Target connection if the receiver is not compiled */
+        uint32_t target;                /**< Target neuron ID or compiled index of the target connection */
+        int activation_type;            /**< Type of the sending connection, only used for connection targets */
+        float value;                    /**< Force for neuron targets, activation of the sender for connection targets */
+        uint8_t kind;                   /**< DELIVERY_NEURON or DELIVERY_CONNECTION */
+    };
+
+    /**
+     * @brief Class containing the deliveries other networks sent to a network.
+     *
+     */
+    class NetworkInbox{
+    public:
+        /**
+         * @brief Initializes an empty inbox.
+         *
+         */
+        NetworkInbox();
+
+        /**
+         * @brief Prepares the buffers of a sender, so sending does not allocate during the network loop.
+         *
+         * Has to be called for every sender before networks step in parallel.
+         *
+         * @param source_network_id    The ID of the sending network.
+         * @param deliveries           The maximum number of deliveries the sender sends in a step.
+         *
+         */
+        void reserve(int source_network_id, size_t deliveries);
+
+        /**
+         * @brief Stores a delivery. Only called by the thread stepping the sender.
+         *
+         * The buffers of the sender have to be created with reserve() before.
+         *
+         * @param source_network_id    The ID of the sending network.
+         * @param delivery             The delivery, its step selects the buffer.
+         *
+         */
+        void push(int source_network_id, const NetworkDelivery &delivery);
+
+        /**
+         * @brief Returns the number of senders buffers exist for.
+         *
+         */
+        int source_count() const;
+
+        /**
+         * @brief Returns the deliveries a sender sent in a step, in the order they were sent.
+         *
+         * @param source_network_id    The ID of the sending network.
+         * @param network_step         The step the deliveries were sent in.
+         *
+         */
+        const std::vector<NetworkDelivery> &deliveries(int source_network_id, int64_t network_step) const;
+
+        /**
+         * @brief Drops the deliveries of all senders sent in a step after they were applied.
+         *
+         * @param network_step    The step the deliveries were sent in.
+         *
+         */
+        void clear(int64_t network_step);
+
+    private:
+        std::vector<std::vector<NetworkDelivery>> _buffers;     // Two buffers per sender, indexed by 2 * ID + step parity
+    };
+}
+
+#endif /* INCLUDE_NETWORKINBOX_HPP */
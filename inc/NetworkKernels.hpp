@@ -0,0 +1,231 @@
+/**
+ * @file NetworkKernels.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Stateless neuron and connection update rules shared by the object graph and the compiled network.
+ *
+ * The kernels only operate on the values they get passed. Connection and Neuron call them with their
+ * own member fields, CompiledNetwork calls them with elements of its flat state arrays. This way both
+ * representations of a network always calculate bitwise identical results.
+ *
+ * @date 2021-07-05
+ *
+ */
+
+#ifndef INCLUDE_NETWORKKERNELS_HPP
+#define INCLUDE_NETWORKKERNELS_HPP
+
+#include <cstdint>
+
+namespace COGNA{
+    class ConnectionParameterHandler;
+    class NeuronParameterHandler;
+    class CompiledNetwork;
+
+    /**
+     * @brief References to the mutable learning state of a single connection.
+     *
+     */
+    struct ConnectionStateRef{
+        float &base_weight;
+        float &short_weight;
+        float &long_weight;
+        float &long_learning_weight;
+        float &presynaptic_potential;
+        int64_t &last_presynaptic_activated_step;
+        int64_t &last_activated_step;
+    };
+
+    /**
+     * @brief Class containing the static update rules of neurons and connections.
+     *
+     * The parameter debug_id is only used for debug output and is the ID of the neuron the
+     * connection stems from or the ID of the neuron itself.
+     *
+     */
+    class NetworkKernels{
+        public:
+            /**
+             * @brief A wrapper including all learning functions of a connection.
+             *
+             * @param state                 The state of the learning connection.
+             * @param parameter             The parameters of the learning connection.
+             * @param activation            The activation of the source neuron or of the conditioning connection.
+             * @param conditioning_type     NONDIRECTIONAL for normal learning, otherwise the activation type of the
+             *                              conditioning presynaptic connection.
+             * @param network_step          The current step/tick count of the network.
+             * @param debug_id              ID used for debug output.
+             */
+            static void basic_learning(ConnectionStateRef &state,
+                                       const ConnectionParameterHandler *parameter,
+                                       float activation,
+                                       int conditioning_type,
+                                       int64_t network_step,
+                                       int debug_id);
+
+            /**
+             * @brief basic_learning() specialized for connections of a fixed learning type.
+             *
+             * Instantiated for all LEARNING_* constants and KERNEL_ANY_TYPE, which reads the learning
+             * type from the parameters like basic_learning().
+             *
+             * @tparam LEARNING_TYPE        The learning type of the connection or KERNEL_ANY_TYPE.
+             */
+            template<int LEARNING_TYPE>
+            static void typed_learning(ConnectionStateRef &state,
+                                       const ConnectionParameterHandler *parameter,
+                                       float activation,
+                                       int conditioning_type,
+                                       int64_t network_step,
+                                       int debug_id);
+
+            /**
+             * @brief Calculates the backfall of the presynaptic potential of a connection.
+             *
+             * @param state           The state of the connection.
+             * @param parameter       The parameters of the connection.
+             * @param network_step    The current step/tick count of the network.
+             * @param debug_id        ID used for debug output.
+             */
+            static void presynaptic_potential_backfall(ConnectionStateRef &state,
+                                                       const ConnectionParameterHandler *parameter,
+                                                       int64_t network_step,
+                                                       int debug_id);
+
+            /**
+             * @brief Applies an activation function to an input value.
+             *
+             * @param activation_function   One of the FUNCTION_* constants.
+             * @param input                 The value to transform.
+             * @param debug_id              ID used for the warning of invalid functions.
+             *
+             * @return                      The transformed value. 0 for invalid functions.
+             */
+            static float activation_function(int activation_function, float input, int debug_id);
+
+            /**
+             * @brief activation_function() specialized for a fixed activation function.
+             *
+             * Instantiated for all FUNCTION_* constants and KERNEL_ANY_TYPE, which applies the
+             * function passed at runtime like activation_function().
+             *
+             * @tparam FUNCTION             The activation function or KERNEL_ANY_TYPE.
+             */
+            template<int FUNCTION>
+            static float typed_activation_function(int activation_function, float input, int debug_id);
+
+            /**
+             * @brief Calculates the backfall of neuron activation when neuron did not get activated in the last step.
+             *
+             * @param activation            The activation of the neuron.
+             * @param was_activated         Indicates if the neuron was activated in the last step.
+             * @param last_activated_step   The step the neuron was last activated.
+             * @param parameter             The parameters of the neuron.
+             * @param network_step          The current step/tick count of the network.
+             * @param debug_id              ID used for debug output.
+             */
+            static void neuron_backfall(float &activation,
+                                        bool was_activated,
+                                        int64_t last_activated_step,
+                                        const NeuronParameterHandler *parameter,
+                                        int64_t network_step,
+                                        int debug_id);
+
+            /**
+             * @brief Sets the activation level of a neuron to its minimum, if it did fire.
+             *
+             * @param activation      The activation of the neuron.
+             * @param parameter       The parameters of the neuron.
+             * @param network_step    The current step/tick count of the network.
+             * @param debug_id        ID used for debug output.
+             */
+            static void clear_neuron_activation(float &activation,
+                                                const NeuronParameterHandler *parameter,
+                                                int64_t network_step,
+                                                int debug_id);
+
+        private:
+            /* CompiledNetwork::batch_learning() splits basic_learning() into its parts */
+            friend class CompiledNetwork;
+
+            /**
+             * @brief Calculates the backfall of the factor which reduces longterm learning after some time of nonactivation.
+             *
+             * Based on a static gradient, the backfall of the reducing factor for
+             * longterm learning is calculated. The longer the connection did not
+             * fire, the more long_learning_weight falls back to 1.0.
+             *
+             */
+            static void long_learning_weight_backfall(ConnectionStateRef &state,
+                                                      const ConnectionParameterHandler *parameter,
+                                                      int64_t network_step,
+                                                      int debug_id);
+
+            /**
+             * @brief Calculates the reduction of long term learning after repeated activation.
+             *
+             * Based on a dynamic gradient, the reduction of longterm learning
+             * is calculated. The more often the connection is activated, the
+             * more reduction happens.
+             *
+             */
+            static void long_learning_weight_reduction(ConnectionStateRef &state,
+                                                       const ConnectionParameterHandler *parameter,
+                                                       int64_t network_step,
+                                                       int debug_id);
+
+            /**
+             * @brief Calculates habituation of connection if weakly activated.
+             *
+             * Can happen directly by weak activation of the connection, or by
+             * a presynaptic connection, which acts as a conditioning input.
+             *
+             */
+            static void habituate(ConnectionStateRef &state,
+                                  const ConnectionParameterHandler *parameter,
+                                  float activation,
+                                  int conditioning_type,
+                                  int64_t network_step,
+                                  int debug_id);
+
+            /**
+             * @brief Calculates sensitization of connection if strongly activated.
+             *
+             * Can happen directly by strong activation of the connection, or by
+             * a presynaptic connection, which acts as a conditioning input.
+             *
+             */
+            static void sensitize(ConnectionStateRef &state,
+                                  const ConnectionParameterHandler *parameter,
+                                  float activation,
+                                  int conditioning_type,
+                                  int64_t network_step,
+                                  int debug_id);
+
+            /**
+             * @brief Calculates dehabituation of connection after time.
+             *
+             * The more steps/ticks pass since last activation, the more the
+             * connection dehabituates.
+             *
+             */
+            static void dehabituate(ConnectionStateRef &state,
+                                    const ConnectionParameterHandler *parameter,
+                                    int64_t network_step,
+                                    int debug_id);
+
+            /**
+             * @brief Calculates desensitization of connection after time.
+             *
+             * The more steps/ticks pass since last activation, the more the
+             * connection desensitizes.
+             *
+             */
+            static void desensitize(ConnectionStateRef &state,
+                                    const ConnectionParameterHandler *parameter,
+                                    int64_t network_step,
+                                    int debug_id);
+    };
+}
+
+#endif /* INCLUDE_NETWORKKERNELS_HPP */
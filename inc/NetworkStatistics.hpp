@@ -0,0 +1,47 @@
+/**
+ * @file NetworkStatistics.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief A class collecting runtime statistics of a neural network.
+ *
+ * The statistics are updated by the network in every step and can be read at any time
+ * for monitoring and tuning purposes.
+ *
+ * @date 2021-07-08
+ *
+ */
+
+#ifndef INCLUDE_NETWORKSTATISTICS_HPP
+#define INCLUDE_NETWORKSTATISTICS_HPP
+
+#include <cstdint>
+
+namespace COGNA{
+    /**
+     * @brief A class containing the statistics of a single network.
+     *
+     */
+    class NetworkStatistics{
+        public:
+            int64_t _sparse_steps;              /**< Steps processing the frontier as list of neurons */
+            int64_t _dense_steps;               /**< Steps sweeping all neurons with a frontier bitmap */
+            int64_t _parallel_steps;            /**< Dense steps whose activation phase ran on the ParallelPropagator */
+            uint32_t _frontier_size;            /**< Number of scheduled neurons in the last step */
+            float _frontier_density;            /**< Fraction of neurons scheduled in the last step */
+            float _dense_frontier_threshold;    /**< Frontier density from which on dense steps are used */
+
+            /**
+             * @brief Initializes all statistics with 0.
+             *
+             */
+            NetworkStatistics();
+
+            /**
+             * @brief Resets all counters. The threshold is kept.
+             *
+             */
+            void reset();
+    };
+}
+
+#endif /* INCLUDE_NETWORKSTATISTICS_HPP */
@@ -88,8 +88,8 @@ public:
      */
     int id();
     int role();
-    std::string channel();
-    std::vector<Neuron*> targets();
+    const std::string &channel();
+    const std::vector<Neuron*> &targets();
 
 private:
     int _id;
@@ -15,13 +15,19 @@
 #define INCLUDE_NETWORK_HPP
 
 #include "Neuron.hpp"
+#include "CompiledNetwork.hpp"
+#include "CounterRandom.hpp"
+#include "RandomActivation.hpp"
 #include "NeuralNetworkParameterHandler.hpp"
+#include "NetworkStatistics.hpp"
 #include "NetworkingNode.hpp"
+#include "NetworkInbox.hpp"
+#include "ParallelPropagator.hpp"
 #include "networking_client.hpp"
 #include "networking_sender.hpp"
 #include "json.hpp"
 #include <string>
-#include <condition_variable>
+#include <atomic>
 
 namespace COGNA{
 
@@ -35,17 +41,21 @@ class NeuralNetwork{
 public:
     int _id;
     std::string _network_name;
-    bool _is_finished;
     std::vector<COGNA::Neuron*> _neurons;                   // All neurons contained in the network
     std::vector<COGNA::Connection*> _connections;
-    std::vector<COGNA::Connection*> _curr_connections;      // All connections which will be activated in this step
-    std::vector<COGNA::Connection*> _next_connections;      // All connections which will be activated in the next step
+    std::vector<COGNA::Neuron*> _curr_neurons;              // All neurons whose connections are activated in this step
+    std::vector<COGNA::Neuron*> _next_neurons;              // All neurons whose connections are activated in the next step
     COGNA::NeuralNetworkParameterHandler *_parameter;
+    COGNA::NetworkArena *_arena;                            // Storage of all neurons, connections and profiles
+    COGNA::ParameterProfilePool *_profiles;                // Shared parameter profiles of all neurons and connections
+    COGNA::NetworkStatistics _statistics;                   // Runtime statistics, updated every step
+    COGNA::NetworkInbox _inbox;                             // Activations other networks sent in the previous step
+    COGNA::CounterRandom _random;                           // Random activation, one stream per network ID
     std::vector<COGNA::NetworkingNode*> _extern_input_nodes;
     std::vector<COGNA::NetworkingNode*> _extern_output_nodes;
     nlohmann::json _subnet_input_connection_list;
     nlohmann::json _subnet_output_connection_list;
-    static int m_cluster_state;
+    static std::atomic<int> m_cluster_state;
 
     /**
      * @brief Initializes the neural network by setting some parameters and adding the Null-Neuron.
@@ -112,6 +122,17 @@ public:
                                      int chance,
                                      float activation_value);
 
+    /**
+     * @brief Sets the seed of the random activation.
+     *
+     * Every network draws from its own stream of the seed, so a cluster with the same seed
+     * activates the same neurons in every run. The seed is 0 if it is never set.
+     *
+     * @param seed    The seed shared by all networks of the cluster.
+     *
+     */
+    void set_random_seed(uint64_t seed);
+
     /**
      * @brief Adds a new connection between two neurons to the network.
      *
@@ -233,19 +254,124 @@ public:
     int setup_network();
 
     /**
-     * @brief This function calls every necessary function to do one step of the network.
+     * @brief Compiles the network into flat arrays, which are used by feed_forward() from now on.
      *
-     * Usually called inside of the network function.
+     * Should be called after setup_network(). After compiling, the state of the network is only
+     * kept in the compiled network and the members of the Neuron and Connection objects are not
+     * updated anymore until store_compiled_state() is called. Adding neurons or connections
+     * afterwards stores the state and drops the compiled network again.
+     *
+     * All networks of a cluster have to be compiled together, since they are activating each other.
+     *
+     * @param network_list    All networks of the cluster, indexed by their ID. Only required if connections
+     *                        lead into other networks.
+     *
+     * @return                Error code. SUCCESS_CODE if everything went right, ERROR_CODE if something went wrong.
+     *
+     */
+    int compile_network(std::vector<NeuralNetwork*> network_list=std::vector<NeuralNetwork*>());
+
+    /**
+     * @brief Prepares the inbox buffers of all networks this network sends activations to.
+     *
+     * Has to be called for every network of a cluster after setup_network() and before the networks
+     * step in parallel, since the inboxes are not locked. compile_network() calls it itself.
+     *
+     * @param network_list    All networks of the cluster, indexed by their ID.
+     *
+     */
+    void reserve_deliveries(const std::vector<NeuralNetwork*> &network_list);
+
+    /**
+     * @brief Writes the state of the compiled network back into the Neuron and Connection objects.
+     *
+     * Does nothing if the network is not compiled.
+     *
+     */
+    void store_compiled_state();
+
+    /**
+     * @brief Checks if the network runs on its compiled representation.
+     *
+     * @return    true if compiled, false if not.
+     *
+     */
+    bool is_compiled();
+
+    /**
+     * @brief Returns the IDs of all other networks this network sends deliveries to, in ascending order.
+     *
+     * Taken from the compiled network if the network is compiled, from the object graph otherwise.
+     *
+     */
+    std::vector<int> get_target_networks();
+
+    /**
+     * @brief Sets the owner of every neuron, which adds the forces it receives in parallel dense steps.
+     *
+     * Usually a row of a PartitionMap. An empty list or a list shorter than the neurons splits them by ID.
+     *
+     * @param neuron_shards    Owner of every neuron, indexed by its ID.
+     *
+     */
+    void set_partition(const std::vector<uint16_t> &neuron_shards);
+
+    /**
+     * @brief Returns the owner of every neuron set with set_partition(), empty if the neurons are split by ID.
+     *
+     */
+    const std::vector<uint16_t> &get_partition() const;
+
+    /**
+     * @brief Runs the parallel dense steps on the workers of a shared pool instead of an own pool.
+     *
+     * The network then has to be stepped by the thread running the pool, outside of WorkerPool::run().
+     * It uses all workers of the pool as soon as parallel_threads is larger than 1.
+     *
+     * @param pool    The pool, e.g. the one of the CognaLauncher. NULL starts an own pool with parallel_threads workers.
+     *
+     */
+    void set_worker_pool(COGNA::WorkerPool *pool);
+
+    /**
+     * @brief Returns true if the dense steps of the network run on several threads.
+     *
+     * This needs a compiled network, parallel_threads above 1 and a dense_frontier_threshold of at most 1.
+     *
+     */
+    bool is_parallel() const;
+
+    /**
+     * @brief Moves the arena and the compiled network to the NUMA node of the worker stepping the network.
+     *
+     * @param node    The NUMA node.
+     *
+     * @return        Error code. ERROR_CODE if some memory could not be moved.
+     *
+     */
+    int bind_to_node(int node);
+
+    /**
+     * @brief Touches every page of the arena and the compiled network, so no page is faulted in during a step.
+     *
+     */
+    void prefault();
+
+    /**
+     * @brief Increments the counter of every neuron which fired in the last step.
+     *
+     * @param counts    Counters indexed by neuron ID. Grown to the number of neurons if too short.
      *
      */
-    void feed_forward(std::vector<NeuralNetwork*> network_list=std::vector<NeuralNetwork*>());
+    void count_fired_neurons(std::vector<uint32_t> &counts);
 
     /**
-     * @brief This function listens to the cluster step counter and activates the network, if required.
+     * @brief This function calls every necessary function to do one step of the network.
+     *
+     * Usually called inside of the network function.
      *
      */
-    void listen_to_cluster(std::vector<NeuralNetwork*> network_list,
-                           std::condition_variable *thread_halter);
+    void feed_forward(const std::vector<NeuralNetwork*> &network_list=std::vector<NeuralNetwork*>());
 
     /**
      * @brief A debug function to print the activation of each firing neuron to std output.
@@ -264,6 +390,8 @@ public:
     /**
      * @brief Returns a neuron based on it's ID.
      *
+     * If the network is compiled, the state of the neuron is only up to date after store_compiled_state().
+     *
      * @param neuron_id    The ID of the neuron to return.
      *
      */
@@ -303,9 +431,18 @@ public:
 
     private:
         std::vector<COGNA::Neuron*> _random_neurons;            // All neurons in the network which can activate randomly
+        COGNA::RandomActivation _random_activation;             // Next activation of every random neuron
+        bool _random_activation_ready;                          // false if the next activations have to be drawn again
+        std::vector<uint32_t> _random_positions;                // Random neurons firing in the current step
         std::vector<float> _transmitter_weights;
         int64_t _network_step_counter;
         static int m_max_id;
+        COGNA::CompiledNetwork *_compiled;                      // Flat representation of the network, NULL if not compiled
+        COGNA::ParallelPropagator *_propagator;                 // Chunks of parallel or gathering dense steps, NULL if not used yet
+        COGNA::WorkerPool *_shared_pool;                        // Pool of the cluster running the chunks, see set_worker_pool()
+        COGNA::WorkerPool *_own_pool;                           // Pool of a network without a shared pool, NULL if not used yet
+        int64_t _schedule_epoch;                                // Changes every time _next_neurons is cleared
+        std::vector<uint16_t> _partition;                       // Owner of every neuron in parallel steps, see set_partition()
 
         /**
          * @brief Sets a new weight value to a certain neurotransmitter.
@@ -323,10 +460,14 @@ public:
          * Uses a dynamic gradient and the behavior parameters @c #transmitter_change_curvature
          * and @c #transmitter_change_steepness for calculations.
          *
-         * @param n    The neuron which should influence the neurotransmitter
+         * @param last_fired_step    The step the influencing neuron last fired.
+         * @param parameter          The parameters of the influencing neuron.
+         * @param activation         The activation of the influencing neuron.
          *
          */
-        void influence_transmitter(COGNA::Neuron *n);
+        void influence_transmitter(int64_t last_fired_step,
+                                   const COGNA::NeuronParameterHandler *parameter,
+                                   float activation);
 
         /**
          * @brief Calculates the slow backfall of neurotransmitter weight to 1 after it has been changed.
@@ -338,7 +479,7 @@ public:
         void transmitter_backfall();
 
         /**
-         * @brief Decides for each neuron which can activate randomly if it should fire.
+         * @brief Activates the random neurons firing in this step, see RandomActivation.
          *
          */
         void activate_random_neurons();
@@ -346,14 +487,20 @@ public:
         /**
          * @brief Contains the basic learning of the connections and the logic if a neuron or a connection is activated.
          *
+         * Neurons and connections of other networks are not changed, but sent to their inbox.
+         *
+         * @param network_list    All networks of the cluster, indexed by their ID.
+         *
          */
-        void activate_next_entities();
+        void activate_next_entities(const std::vector<NeuralNetwork*> &network_list);
 
         /**
          * @brief Stores the connections of all activated neurons, if their activation is higher than their threshold in a vector.
          *
+         * Only neurons of this network are saved. Neurons activated by other networks are saved by receive_deliveries().
+         *
          */
-        void save_next_neurons(std::vector<NeuralNetwork*> network_list);
+        void save_next_neurons(const std::vector<NeuralNetwork*> &network_list);
 
         /**
          * @brief Clears the vector containing the current connections and pushes the vector with the next connection to the current ones.
@@ -362,6 +509,110 @@ public:
         void switch_vectors();
 
         void store_sent_data();
+
+        /**
+         * @brief Applies all activations other networks sent in the previous step, ordered by their network ID.
+         *
+         * Received neurons which are activated afterwards fire in the current step.
+         *
+         */
+        void receive_deliveries();
+
+        /**
+         * @brief Applies a single delivery of the inbox to a neuron or connection of this network.
+         *
+         */
+        void receive_delivery(const NetworkDelivery &delivery);
+
+        /**
+         * @brief Takes over the received activation of a neuron and adds it to the current step if it is activated.
+         *
+         */
+        void save_received_neuron(const NetworkDelivery &delivery);
+
+        /**
+         * @brief Updates the frontier statistics and decides if this step sweeps densely over all neurons.
+         *
+         * A compiled network takes a dense step if the fraction of scheduled neurons reaches the
+         * dense frontier threshold of the network. The object graph always takes sparse steps.
+         * Dense steps visit the neurons in a different order than sparse steps and so change the
+         * results, therefore the threshold is above 1 unless a network sets it.
+         *
+         * @return    true for a dense step, false for a sparse step.
+         *
+         */
+        bool update_frontier_statistics();
+
+        /**
+         * @brief Compiled counterpart of activate_next_entities().
+         *
+         * A sparse step walks _curr_neurons of the compiled network in order. A dense step
+         * marks them in a bitmap and sweeps it in ID order, so every neuron fires at most once.
+         * Dense steps run on several threads if the network sets parallel_threads and supports it,
+         * so parallel_threads only takes effect together with a dense_frontier_threshold.
+         * With gather_propagation, they gather the forces at their targets, also on a single thread.
+         *
+         * @param network_list    All networks of the cluster, indexed by their ID.
+         * @param dense           true for a dense step, false for a sparse step.
+         *
+         */
+        void activate_compiled_entities(const std::vector<NeuralNetwork*> &network_list, bool dense);
+
+        /**
+         * @brief Returns the propagator for parallel dense steps, NULL if this step has to be serial.
+         *
+         * Tracing forces serial steps, since the events have to be recorded in order.
+         *
+         */
+        ParallelPropagator* parallel_propagator();
+
+        /**
+         * @brief Compiled counterpart of save_next_neurons().
+         *
+         * @param network_list    All networks of the cluster, indexed by their ID.
+         * @param dense           Has to match the mode of activate_compiled_entities() in this step.
+         *
+         */
+        void save_compiled_neurons(const std::vector<NeuralNetwork*> &network_list, bool dense);
+
+        /**
+         * @brief Activates all connections of a single firing neuron of the compiled network.
+         *
+         */
+        void activate_compiled_neuron(uint32_t prev, const std::vector<NeuralNetwork*> &network_list);
+
+        /**
+         * @brief Activates a run of connections of a firing neuron which share their kernel.
+         *
+         * Instantiated once per kernel of CompiledNetwork::kernel_id(), so the loop over the run does
+         * not branch on the target kind, activation function or learning type. KERNEL_ANY_TYPE reads
+         * them per connection.
+         *
+         * @param learn    false if the learning of the connections was already batched.
+         *
+         * @return         false if the neuron stopped firing at itself, so the rest of its connections is skipped.
+         *
+         */
+        template<int TARGET_KIND, int FUNCTION, int LEARNING_TYPE>
+        bool activate_compiled_run(uint32_t prev,
+                                   uint32_t first_con,
+                                   uint32_t last_con,
+                                   bool learn,
+                                   const std::vector<NeuralNetwork*> &network_list);
+
+        /**
+         * @brief Clears a fired neuron of the compiled network and schedules its activated targets.
+         *
+         */
+        void save_compiled_neuron(uint32_t prev, const std::vector<NeuralNetwork*> &network_list);
+
+        /**
+         * @brief Stores the state of the compiled network into the object graph and drops the compiled network.
+         *
+         * Called before the topology of the network is changed.
+         *
+         */
+        void release_compiled_network();
 };
 
 } //namespace COGNA
@@ -30,6 +30,11 @@ namespace COGNA{
             float transmitter_backfall_curvature;
             float transmitter_backfall_steepness;
 
+            float dense_frontier_threshold;     /**< Fraction of neurons in the frontier from which on compiled steps sweep densely, above 1 never */
+            bool batch_learning;                /**< Compiled networks learn all connections of a firing neuron as one batch, rounds differently */
+            int parallel_threads;               /**< Threads sharing the dense steps of a compiled network, 1 steps serially, see NeuralNetwork::is_parallel() */
+            bool gather_propagation;            /**< Dense steps gather the forces at their targets, also with a single thread */
+
             /**
              * @brief Initializes network parameters.
              *
@@ -21,6 +21,8 @@
 #include "NeuronParameterHandler.hpp"
 #include "NeuralNetworkParameterHandler.hpp"
 #include "Connection.hpp"
+#include "ParameterProfilePool.hpp"
+#include "NetworkArena.hpp"
 
 namespace COGNA{
 	class Neuron{
@@ -33,8 +35,11 @@ namespace COGNA{
 	        int64_t _last_activated_step;          /**< Network step count, when neuron was last activated */
 	        bool _was_activated;                   /**< Indicates if neuron was activated last time or this time */
 	        int _last_fired_step;                  /**< Step when neuron last fired */
+	        int64_t _scheduled_epoch;              /**< Schedule epoch of the network when the neuron was last added to the next step */
 
-	        COGNA::NeuronParameterHandler *_parameter;
+	        const COGNA::NeuronParameterHandler *_parameter;   /**< Interned profile, change it with set_parameter() */
+	        COGNA::ParameterProfilePool *_profiles;            /**< Profile pool of the network this neuron belongs to */
+	        COGNA::NetworkArena *_arena;                       /**< Arena of the network storing the connections */
 
 	        std::vector<COGNA::Connection*> _connections;
 			std::vector<COGNA::Neuron*> _previous;
@@ -42,8 +47,15 @@ namespace COGNA{
 			/**
 			 * @brief Initializes a neuron by setting its parameters to the default parameters coming from the network.
 			 *
+			 * @param default_parameter    The parameters of the network.
+			 * @param profiles             The profile pool of the network the neuron and its connections use.
+			 * @param arena                The arena of the network the connections are stored in.
+			 * @param network_id           The ID of the network.
 			 */
-	        Neuron(NeuralNetworkParameterHandler *default_parameter, int network_id);
+	        Neuron(NeuralNetworkParameterHandler *default_parameter,
+	               ParameterProfilePool *profiles,
+	               NetworkArena *arena,
+	               int network_id);
 
 			/**
 			 * @brief Frees all memory allocated by the neuron.
@@ -58,6 +70,16 @@ namespace COGNA{
 			 */
 	        void set_step(long new_step);
 
+			/**
+			 * @brief Replaces the parameters of this neuron copy-on-write.
+			 *
+			 * The shared profile is not changed. Instead the new parameters are interned in the
+			 * profile pool of the network.
+			 *
+			 * @param parameter    The complete new parameter set.
+			 */
+	        void set_parameter(const NeuronParameterHandler &parameter);
+
 			/**
 			 * @brief Adds a connection to another neuron in the network to this neuron.
 			 *
@@ -147,6 +169,23 @@ namespace COGNA{
             void clear_neuron_activation(int64_t network_step);
 
 		private:
+			/**
+			 * @brief Returns the interned parameter profile for a new connection of this neuron.
+			 *
+			 * The connection inherits the connection-specific parameters of this neuron.
+			 *
+			 * @param con_type            The type of connection. Can be EXCITATORY or INHIBITORY.
+			 * @param fun_type            The activation function of the connection.
+			 * @param learn_type          Decides if connection can learn via habituation, sensitization, or both.
+			 * @param transmitter_type    The transmitter the new connection uses for signal transmission.
+			 *
+			 * @return                    The profile of the new connection.
+			 */
+	        const ConnectionParameterHandler* connection_parameter(int con_type,
+	                                                               int fun_type,
+	                                                               int learn_type,
+	                                                               int transmitter_type);
+
 			/**
 			 * @brief Checks if this neuron is connected with another neuron.
 			 *
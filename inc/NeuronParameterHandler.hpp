@@ -43,12 +43,36 @@ class NeuronParameterHandler: public COGNA::ConnectionParameterHandler{
         int random_chance;                    /**< Chance of random activation per tick */
         float random_activation_value;        /**< How strong is the neuron activated when randomly activated */
 
+        const GradientEvaluator *activation_backfall_gradient;    /**< Set by bind_gradients(), not compared */
+
         /**
          * @brief Initializes neuron parameters by copying the relevant
          *        parameter values from the neural network.
          *
          */
         NeuronParameterHandler();
+
+        /**
+         * @brief Compares all neuron and connection parameters with the parameters of another handler.
+         *
+         * @param other    The handler to compare with.
+         *
+         * @return         true if all parameters are equal, false if not.
+         */
+        bool equals(const NeuronParameterHandler &other) const;
+
+        /**
+         * @brief Calculates a hash over all neuron and connection parameters.
+         *
+         * @return    The hash value.
+         */
+        size_t hash() const;
+
+        /**
+         * @brief Looks up the gradient evaluators of the current neuron and connection curvatures.
+         *
+         */
+        void bind_gradients();
 };
 
 } //namespace COGNA
@@ -0,0 +1,236 @@
+/**
+ * @file ParallelPropagator.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Runs the activation phase of a dense step of a single compiled network on several threads.
+ *
+ * **Note:**
+ * The serial step fires the neurons of the frontier one after another and adds every force directly
+ * to the target neuron. The result depends on this order, since the first force reaching a neuron
+ * also lets its old activation fall back, and a firing neuron checks its threshold with the
+ * activation it has at that moment. The parallel step reproduces the serial dense step bit by bit,
+ * independent of the number of threads:
+ *
+ * 1. Scan: The frontier bitmap is split into chunks. For every chunk, the edges between neurons of
+ *    the frontier are collected in parallel.
+ * 2. Plan: These few edges are replayed serially in ID order. This decides which neurons fire, where
+ *    a neuron firing at itself stops, and with which activation every neuron fires.
+ * 3. Activate: The chunks learn and calculate their forces in parallel. Forces are not added to their
+ *    targets, but stored per chunk and per owner of the target.
+ * 4. Reduce: Every owner adds the forces to its neurons in chunk order, which is the serial order.
+ *    Deliveries into other networks are sent in chunk order afterwards.
+ *
+ * In gather mode, the activate phase stores the force of every connection instead and marks its target
+ * as touched. Every owner pulls the forces of the incoming connections of its touched neurons in index
+ * order, untouched neurons are never visited. This keeps the work of neurons with a large fan-in at
+ * their owner and needs no buffers per chunk. It also works with a single thread.
+ *
+ * Networks containing presynaptic connections to their own connections or neurons influencing
+ * transmitters change state shared by all neurons while firing and are always stepped serially.
+ *
+ * @date 2021-07-17
+ *
+ */
+
+#ifndef INCLUDE_PARALLELPROPAGATOR_HPP
+#define INCLUDE_PARALLELPROPAGATOR_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "CompiledNetwork.hpp"
+#include "NetworkInbox.hpp"
+#include "WorkerPool.hpp"
+
+namespace COGNA{
+    const int PROPAGATION_CHUNKS_PER_WORKER = 4;    /**< Chunks of the frontier per worker, so stealing can balance them */
+
+    class NeuralNetwork;
+
+    /**
+     * @brief Class containing the chunks and buffers of parallel steps of a compiled network.
+     *
+     */
+    class ParallelPropagator{
+    public:
+        /**
+         * @brief Checks the network and splits it into chunks if it can be stepped in parallel.
+         *
+         * The propagator starts no threads of its own. The network has to be stepped by the thread
+         * running the pool and never from within WorkerPool::run(), since the pool cannot nest runs.
+         *
+         * @param compiled    The compiled network. Has to outlive the propagator.
+         * @param pool        The workers running the chunks, e.g. the pool of the CognaLauncher. Has to outlive the propagator.
+         * @param gather      true if the owners gather the forces of the incoming connections of their neurons.
+         * @param owners      Owner of every neuron, e.g. its shard of a PartitionMap. NULL splits the IDs evenly.
+         *
+         */
+        ParallelPropagator(CompiledNetwork *compiled,
+                           WorkerPool *pool,
+                           bool gather=false,
+                           const std::vector<uint16_t> *owners=NULL);
+
+        /**
+         * @brief Releases the buffers. The pool is not stopped.
+         *
+         */
+        ~ParallelPropagator();
+
+        /**
+         * @brief Returns false if the network has to be stepped serially.
+         *
+         */
+        bool is_supported() const;
+
+        /**
+         * @brief Returns the number of workers of the pool, including the thread stepping the network.
+         *
+         */
+        int worker_number() const;
+
+        /**
+         * @brief Returns the pool running the chunks.
+         *
+         */
+        WorkerPool *pool() const;
+
+        /**
+         * @brief Returns true if the owners gather the forces of their neurons.
+         *
+         */
+        bool is_gather() const;
+
+        /**
+         * @brief Parallel counterpart of the dense activation phase of NeuralNetwork::activate_compiled_entities().
+         *
+         * The frontier bitmap of the compiled network has to be loaded.
+         *
+         * @param network_id             The ID of the network.
+         * @param network_step           The current step/tick count of the network.
+         * @param transmitter_weights    The weights of all neurotransmitters in the network.
+         * @param batch_learning         true if rows marked in CompiledNetwork::_batch_learning_rows learn as batch.
+         * @param network_list           All networks of the cluster, indexed by their ID.
+         *
+         */
+        void activate(int network_id,
+                      int64_t network_step,
+                      const std::vector<float> &transmitter_weights,
+                      bool batch_learning,
+                      const std::vector<NeuralNetwork*> &network_list);
+
+    private:
+        struct TargetForce{
+            uint32_t _target;
+            float _force;
+        };
+
+        struct RemoteDelivery{
+            int _network_id;
+            NetworkDelivery _delivery;
+        };
+
+        /* A frontier neuron firing at other neurons of the frontier, its edges are in [_first, _last[ of the chunk */
+        struct ScanEntry{
+            uint32_t _neuron;
+            uint32_t _first;
+            uint32_t _last;
+        };
+
+        struct Chunk{
+            uint32_t _first_word;                           // Words [_first_word, _last_word[ of the frontier bitmap
+            uint32_t _last_word;
+            std::vector<uint32_t> _frontier_edges;
+            std::vector<ScanEntry> _entries;
+            std::vector<std::vector<TargetForce>> _forces;  // One list per owner
+            std::vector<RemoteDelivery> _deliveries;
+            LearningBuffers _learning_buffers;
+        };
+
+        CompiledNetwork *_compiled;
+        WorkerPool *_pool;
+        bool _supported;
+        bool _gather;
+        int _worker_number;
+        std::vector<Chunk> _chunks;
+        std::vector<uint16_t> _owners;                      // Owner reducing the forces of a neuron
+        std::vector<std::function<void()>> _scan_tasks;
+        std::vector<std::function<void()>> _activate_tasks;
+        std::vector<std::function<void()>> _reduce_tasks;
+
+        /* Plan of a neuron, only valid if its stamp equals the current plan epoch */
+        std::vector<int64_t> _planned_epoch;
+        int64_t _plan_epoch;
+        std::vector<float> _fire_activation;                // Activation when the neuron fires
+        std::vector<float> _self_activation;                // Activation after it first fired at itself
+        std::vector<uint32_t> _self_con;                    // Connection at which it first fired at itself
+        std::vector<uint32_t> _end_con;                     // First connection which is not activated anymore
+
+        /* Force of a connection in gather mode, only valid if its stamp equals the current plan epoch */
+        std::vector<float> _connection_forces;
+        std::vector<int64_t> _force_epoch;
+
+        /* Neurons receiving forces in gather mode. A neuron is listed once at its owner when its stamp is set
+           to the current plan epoch, the lists have room for all neurons of their owner. */
+        std::vector<std::atomic<int64_t>> _touched_epoch;
+        std::vector<std::vector<uint32_t>> _touched_neurons;
+        std::vector<std::atomic<uint32_t>> _touched_number;
+
+        /* Arguments of the current step */
+        int _network_id;
+        int64_t _network_step;
+        const std::vector<float> *_transmitter_weights;
+        bool _batch_learning;
+
+        /**
+         * @brief Collects the edges between neurons of the frontier of a chunk.
+         *
+         */
+        void scan(int chunk_id);
+
+        /**
+         * @brief Replays the edges between neurons of the frontier in serial order.
+         *
+         */
+        void plan();
+
+        /**
+         * @brief Stores the current state of a neuron as its plan.
+         *
+         */
+        void plan_neuron(uint32_t neuron);
+
+        /**
+         * @brief Learns and calculates the forces of all firing neurons of a chunk.
+         *
+         */
+        void activate_chunk(int chunk_id);
+
+        /**
+         * @brief Learns and calculates the forces of a single neuron of the frontier.
+         *
+         */
+        void activate_neuron(Chunk &chunk, uint32_t prev);
+
+        /**
+         * @brief Counterpart of NeuralNetwork::activate_compiled_run(), which stores forces instead of adding them.
+         *
+         */
+        template<int TARGET_KIND, int FUNCTION, int LEARNING_TYPE>
+        void activate_run(Chunk &chunk, uint32_t prev, uint32_t first_con, uint32_t last_con, bool learn);
+
+        /**
+         * @brief Adds the forces of all chunks to the neurons of an owner.
+         *
+         */
+        void reduce(int owner);
+
+        /**
+         * @brief Adds the forces of the incoming connections to the neurons of an owner.
+         *
+         */
+        void gather(int owner);
+    };
+}
+
+#endif /* INCLUDE_PARALLELPROPAGATOR_HPP */
@@ -0,0 +1,108 @@
+/**
+ * @file ParameterProfilePool.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief A pool of deduplicated and immutable parameter profiles for neurons and connections.
+ *
+ * Almost all neurons and connections of a network use one of a handful of parameter sets
+ * coming from the neuron types of a project. Instead of every neuron and connection owning
+ * a copy, they point to a shared profile stored in the pool of their network.
+ *
+ * Profiles are never changed after being added to the pool. Changing a parameter of a single
+ * neuron or connection is done copy-on-write: the profile is copied, the copy is changed and
+ * interned again, which either returns an already existing equal profile or stores a new one.
+ * New profiles get their gradient evaluators bound when they are stored.
+ *
+ * @date 2021-07-06
+ *
+ */
+
+#ifndef INCLUDE_PARAMETERPROFILEPOOL_HPP
+#define INCLUDE_PARAMETERPROFILEPOOL_HPP
+
+#include <cstddef>
+#include <unordered_set>
+#include "NeuronParameterHandler.hpp"
+#include "ConnectionParameterHandler.hpp"
+#include "NetworkArena.hpp"
+
+namespace COGNA{
+    /**
+     * @brief Class storing the interned parameter profiles of a network.
+     *
+     */
+    class ParameterProfilePool{
+    public:
+        /**
+         * @brief Initializes an empty pool.
+         *
+         * @param arena    The arena of the network the profiles are stored in.
+         *
+         */
+        ParameterProfilePool(NetworkArena *arena);
+
+        /**
+         * @brief Frees all profiles. No neuron or connection of the network may use them afterwards.
+         *
+         */
+        ~ParameterProfilePool();
+
+        /**
+         * @brief Returns the profile equal to the given parameters. Adds a copy to the pool if no such profile exists.
+         *
+         * @param parameter    The parameters to intern.
+         *
+         * @return             An immutable profile owned by the pool.
+         *
+         */
+        const ConnectionParameterHandler* intern(const ConnectionParameterHandler &parameter);
+
+        /**
+         * @brief Returns the profile equal to the given parameters. Adds a copy to the pool if no such profile exists.
+         *
+         * @param parameter    The parameters to intern.
+         *
+         * @return             An immutable profile owned by the pool.
+         *
+         */
+        const NeuronParameterHandler* intern(const NeuronParameterHandler &parameter);
+
+        /**
+         * @brief Returns the number of distinct connection profiles in the pool.
+         *
+         */
+        size_t connection_profile_count() const;
+
+        /**
+         * @brief Returns the number of distinct neuron profiles in the pool.
+         *
+         */
+        size_t neuron_profile_count() const;
+
+    private:
+        NetworkArena *_arena;
+
+        template <typename T>
+        struct ProfileHash{
+            size_t operator()(const T *parameter) const{
+                return parameter->hash();
+            }
+        };
+
+        template <typename T>
+        struct ProfileEqual{
+            bool operator()(const T *first, const T *second) const{
+                return first->equals(*second);
+            }
+        };
+
+        std::unordered_set<const ConnectionParameterHandler*,
+                           ProfileHash<ConnectionParameterHandler>,
+                           ProfileEqual<ConnectionParameterHandler>> _connection_profiles;
+        std::unordered_set<const NeuronParameterHandler*,
+                           ProfileHash<NeuronParameterHandler>,
+                           ProfileEqual<NeuronParameterHandler>> _neuron_profiles;
+    };
+}
+
+#endif /* INCLUDE_PARAMETERPROFILEPOOL_HPP */
@@ -0,0 +1,81 @@
+/**
+ * @file PhaseBarrier.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief A reusable barrier synchronizing the launcher and the network threads of a cluster.
+ *
+ * **Note:**
+ * Every participant calls arrive_and_wait() at the end of a phase and continues when all
+ * participants arrived. Waiting threads first spin for a short while, since the phases of a
+ * cluster step are usually short, and then sleep on a futex until the last participant arrives.
+ * The barrier is released by incrementing a phase counter, so it can be reused immediately
+ * and no notification can be missed.
+ *
+ * Everything a participant wrote before arriving is visible to all participants afterwards.
+ *
+ * @date 2021-07-15
+ *
+ */
+
+#ifndef INCLUDE_PHASEBARRIER_HPP
+#define INCLUDE_PHASEBARRIER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace COGNA{
+    const int BARRIER_SPIN_COUNT = 4000;    /**< Polls of the phase counter before a waiting thread sleeps */
+
+    /**
+     * @brief Class containing the state of a spinning and blocking barrier.
+     *
+     */
+    class PhaseBarrier{
+    public:
+        /**
+         * @brief Initializes the barrier.
+         *
+         * @param participants    Number of threads arriving in every phase.
+         * @param spin_count      Number of polls before a waiting thread sleeps. 0 sleeps immediately.
+         *
+         */
+        PhaseBarrier(int participants, int spin_count=BARRIER_SPIN_COUNT);
+
+        /**
+         * @brief Waits until all participants arrived in the current phase.
+         *
+         * @return    false if close() was called before the phase ended, otherwise true.
+         *
+         */
+        bool arrive_and_wait();
+
+        /**
+         * @brief Lets arrive_and_wait() return false from the current phase on. Used to stop the participants.
+         *
+         */
+        void close();
+
+        /**
+         * @brief Returns the number of completed phases.
+         *
+         */
+        uint32_t phase() const;
+
+        /**
+         * @brief Returns how often a participant had to sleep, because spinning was not enough.
+         *
+         */
+        uint64_t sleep_count() const;
+
+    private:
+        const int _participants;
+        const int _spin_count;
+        std::atomic<int> _arrived;
+        std::atomic<int> _sleepers;
+        std::atomic<uint32_t> _phase;               // Futex word, incremented whenever all participants arrived
+        std::atomic<bool> _closed;
+        std::atomic<uint64_t> _sleep_count;
+    };
+}
+
+#endif /* INCLUDE_PHASEBARRIER_HPP */
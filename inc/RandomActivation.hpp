@@ -0,0 +1,103 @@
+/**
+ * @file RandomActivation.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief A sampler deciding which neurons of a network fire at random in a step.
+ *
+ * **Note:**
+ * A neuron firing with probability p in every step waits a geometrically distributed number of
+ * steps between two activations. Instead of drawing a number for every neuron in every step, the
+ * sampler draws the step of the next activation whenever a neuron fires and keeps these steps in
+ * a binary heap. A step therefore only costs time for the neurons which actually fire, while the
+ * activations follow the same distribution as drawing each step.
+ *
+ * The waiting time after step s is drawn from the CounterRandom stream of the network with the
+ * counter s and the neuron ID, so the activations stay reproducible with the seed.
+ *
+ * @date 2021-07-22
+ *
+ */
+
+#ifndef INCLUDE_RANDOMACTIVATION_HPP
+#define INCLUDE_RANDOMACTIVATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CounterRandom.hpp"
+
+namespace COGNA{
+    /**
+     * @brief Class containing the next activation step of every randomly activated neuron.
+     *
+     */
+    class RandomActivation{
+    public:
+        /**
+         * @brief Initializes an empty sampler.
+         *
+         */
+        RandomActivation();
+
+        /**
+         * @brief Draws the first activation of every neuron after a step.
+         *
+         * @param neurons      IDs of the randomly activated neurons.
+         * @param chances      Chance of every neuron, it fires with (chance + 1) / MAX_CHANCE per step.
+         * @param random       The stream of the network.
+         * @param last_step    The step before the first step sampled.
+         *
+         */
+        void reset(const std::vector<uint32_t> &neurons, const std::vector<int> &chances,
+                   const CounterRandom &random, int64_t last_step);
+
+        /**
+         * @brief Returns the neurons firing in a step and draws their next activation.
+         *
+         * Has to be called for every step after the last step given to reset(), in ascending order.
+         *
+         * @param step         The step.
+         * @param random       The stream of the network.
+         * @param positions    Receives the positions of the firing neurons in the list given to reset(), ascending.
+         *
+         */
+        void collect(int64_t step, const CounterRandom &random, std::vector<uint32_t> &positions);
+
+        /**
+         * @brief Draws the step in which a neuron fires next.
+         *
+         * @param random    The stream of the network.
+         * @param step      The step the neuron last fired in.
+         * @param neuron    ID of the neuron.
+         * @param chance    Chance of the neuron, see reset().
+         *
+         * @return          The next step, at least step + 1.
+         *
+         */
+        static int64_t next_step(const CounterRandom &random, int64_t step, uint32_t neuron, int chance);
+
+        /**
+         * @brief Returns the number of neurons sampled.
+         *
+         */
+        size_t size() const;
+
+    private:
+        struct Activation{
+            int64_t _step;
+            uint32_t _position;
+        };
+
+        std::vector<Activation> _heap;               // Earliest activation first, ties by position
+        std::vector<uint32_t> _neurons;
+        std::vector<int> _chances;
+
+        /**
+         * @brief Orders the heap, true if a fires after b.
+         *
+         */
+        static bool later(const Activation &a, const Activation &b);
+    };
+}
+
+#endif /* INCLUDE_RANDOMACTIVATION_HPP */
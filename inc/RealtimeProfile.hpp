@@ -0,0 +1,100 @@
+/**
+ * @file RealtimeProfile.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief A class applying the guarantees a cluster needs for a bounded tick latency.
+ *
+ * **Note:**
+ * A tick of a cluster controlling a robot must not wait for other processes, the swap or page faults.
+ * The real-time profile therefore runs the tick and networking threads with SCHED_FIFO, locks all
+ * memory of the process with mlockall() and touches the network state and the stacks of the tick
+ * threads once before the first tick, so no page is faulted in while stepping.
+ *
+ * Most of these guarantees need privileges (CAP_SYS_NICE, CAP_IPC_LOCK) or raised resource limits
+ * (RLIMIT_RTPRIO, RLIMIT_MEMLOCK). Every function reports a failure with errno, so the launcher
+ * can tell which guarantees are missing instead of failing to start.
+ *
+ * @date 2021-07-24
+ *
+ */
+
+#ifndef INCLUDE_REALTIMEPROFILE_HPP
+#define INCLUDE_REALTIMEPROFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace COGNA{
+    const int DEFAULT_REALTIME_PRIORITY = 80;                   /**< SCHED_FIFO priority of the tick threads */
+    const size_t REALTIME_STACK_PREFAULT = 256 * 1024;          /**< Bytes of stack touched by prefault_stack() */
+
+    /**
+     * @brief Class containing static real-time functions.
+     *
+     */
+    class RealtimeProfile{
+        public:
+            /**
+             * @brief Runs a thread with SCHED_FIFO.
+             *
+             * @param thread      The native handle of the thread.
+             * @param priority    The priority from 1 to 99.
+             *
+             * @return            Error code. ERROR_CODE with errno set if the priority could not be applied.
+             */
+            static int set_fifo_priority(std::thread::native_handle_type thread, int priority);
+
+            /**
+             * @brief Runs the calling thread with SCHED_FIFO, see set_fifo_priority().
+             *
+             */
+            static int set_current_fifo_priority(int priority);
+
+            /**
+             * @brief Locks all current and future pages of the process in memory.
+             *
+             * @return    Error code. ERROR_CODE with errno set if the pages could not be locked.
+             */
+            static int lock_memory();
+
+            /**
+             * @brief Touches every page of a memory range, so it is mapped before the first tick.
+             *
+             * The content of the range is not changed.
+             *
+             */
+            static void prefault_memory(void *memory, size_t size);
+
+            /**
+             * @brief Touches the elements and the reserved capacity of a vector, see prefault_memory().
+             *
+             */
+            template<typename T>
+            static void prefault_vector(std::vector<T> &vector){
+                prefault_memory(vector.data(), vector.capacity() * sizeof(T));
+            }
+
+            /**
+             * @brief Touches REALTIME_STACK_PREFAULT bytes of the stack of the calling thread.
+             *
+             */
+            static void prefault_stack();
+
+            /**
+             * @brief Returns the highest SCHED_FIFO priority an unprivileged thread may use (RLIMIT_RTPRIO).
+             *
+             */
+            static uint64_t priority_limit();
+
+            /**
+             * @brief Returns the number of bytes an unprivileged process may lock (RLIMIT_MEMLOCK).
+             *
+             * @return    The limit, UINT64_MAX if it is unlimited.
+             */
+            static uint64_t lock_limit();
+    };
+}
+
+#endif /* INCLUDE_REALTIMEPROFILE_HPP */
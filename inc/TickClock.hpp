@@ -0,0 +1,164 @@
+/**
+ * @file TickClock.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief A clock starting the steps of a cluster at absolute deadlines.
+ *
+ * **Note:**
+ * The deadline of tick k is the start time plus k periods on CLOCK_MONOTONIC. The clock sleeps with
+ * clock_nanosleep(TIMER_ABSTIME) until the deadline, so neither the duration of a step nor the
+ * inaccuracy of a single sleep shifts the following ticks, and the frequency does not drift.
+ *
+ * A tick starting a whole period or more after its deadline is an overrun. The overrun policy decides
+ * what happens to the deadlines missed meanwhile:
+ *   - OVERRUN_SKIP drops them, the next tick starts at the next deadline of the original grid.
+ *   - OVERRUN_CATCH_UP keeps them, the missed ticks start back to back until the cluster caught up.
+ *   - OVERRUN_STRETCH moves the grid, the next tick starts one period after the late tick.
+ *
+ * The lateness of every tick is counted in a histogram of power of two buckets. The counters are
+ * atomic, so other threads can query them while the cluster runs.
+ *
+ * @date 2021-07-23
+ *
+ */
+
+#ifndef INCLUDE_TICKCLOCK_HPP
+#define INCLUDE_TICKCLOCK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace COGNA{
+    const int OVERRUN_SKIP = 1;
+    const int OVERRUN_CATCH_UP = 2;
+    const int OVERRUN_STRETCH = 3;
+
+    const int LATENESS_BUCKETS = 32;    /**< Bucket 0 counts below 1 us, bucket b from 2^(b-1) us to 2^b us */
+
+    /**
+     * @brief Class containing the deadlines and the lateness statistics of a tick loop.
+     *
+     */
+    class TickClock{
+    public:
+        /**
+         * @brief Initializes the clock, the grid starts with start().
+         *
+         * @param frequency         Ticks per second.
+         * @param overrun_policy    OVERRUN_SKIP, OVERRUN_CATCH_UP or OVERRUN_STRETCH.
+         *
+         */
+        TickClock(int frequency=1, int overrun_policy=OVERRUN_SKIP);
+
+        /**
+         * @brief Changes the frequency, takes effect with the next start().
+         *
+         */
+        void set_frequency(int frequency);
+
+        /**
+         * @brief Changes what happens to missed deadlines.
+         *
+         */
+        void set_overrun_policy(int overrun_policy);
+
+        /**
+         * @brief Returns the overrun policy.
+         *
+         */
+        int overrun_policy() const;
+
+        /**
+         * @brief Starts the grid one period from now and clears the statistics.
+         *
+         */
+        void start();
+
+        /**
+         * @brief Sleeps until the deadline of the next tick and counts its lateness.
+         *
+         * Returns immediately if the deadline already passed.
+         *
+         */
+        void wait();
+
+        /**
+         * @brief Returns the number of ticks since start().
+         *
+         */
+        uint64_t ticks() const;
+
+        /**
+         * @brief Returns the number of ticks starting a whole period or more after their deadline.
+         *
+         */
+        uint64_t overruns() const;
+
+        /**
+         * @brief Returns the number of deadlines dropped by OVERRUN_SKIP.
+         *
+         */
+        uint64_t skipped_ticks() const;
+
+        /**
+         * @brief Returns the number of ticks in a bucket of the lateness histogram.
+         *
+         */
+        uint64_t lateness_count(int bucket) const;
+
+        /**
+         * @brief Returns the upper limit of a bucket of the lateness histogram in microseconds.
+         *
+         */
+        static int64_t bucket_limit(int bucket);
+
+        /**
+         * @brief Returns a bound of the lateness of a fraction of all ticks.
+         *
+         * @param fraction    E.g. 0.99 for the 99th percentile.
+         *
+         * @return            The upper limit of the bucket the percentile falls into in microseconds.
+         *
+         */
+        int64_t lateness_percentile(double fraction) const;
+
+        /**
+         * @brief Returns the largest lateness of a tick in microseconds.
+         *
+         */
+        int64_t max_lateness() const;
+
+        /**
+         * @brief Prints the overruns and the lateness histogram.
+         *
+         */
+        void print_statistics() const;
+
+        /**
+         * @brief Converts the name of an overrun policy, "skip", "catch_up" or "stretch".
+         *
+         * @return    The policy, or ERROR_CODE if the name is unknown.
+         *
+         */
+        static int parse_overrun_policy(const std::string &name);
+
+    private:
+        int64_t _period;                // Nanoseconds
+        int _overrun_policy;
+        int64_t _deadline;              // Nanoseconds on CLOCK_MONOTONIC
+        std::atomic<uint64_t> _ticks;
+        std::atomic<uint64_t> _overruns;
+        std::atomic<uint64_t> _skipped_ticks;
+        std::atomic<int64_t> _max_lateness;
+        std::atomic<uint64_t> _lateness[LATENESS_BUCKETS];
+
+        /**
+         * @brief Returns CLOCK_MONOTONIC in nanoseconds.
+         *
+         */
+        static int64_t now();
+    };
+}
+
+#endif /* INCLUDE_TICKCLOCK_HPP */
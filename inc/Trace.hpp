@@ -0,0 +1,201 @@
+/**
+ * @file Trace.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief A tracing facility recording binary events of the network loop into a ring buffer.
+ *
+ * **Note:**
+ * Every trace point checks a single bit of a runtime category mask. Enabled events are stored
+ * as fixed size records in a global ring buffer instead of being printed, so tracing does not
+ * stall the network loop with formatted output. The buffer can be written to a binary file or
+ * printed as text after the run.
+ *
+ * Building with COGNA_TRACING=0 (make TRACING=0) turns all trace points into constant false
+ * branches, which the compiler removes entirely.
+ *
+ * @date 2021-07-12
+ *
+ */
+
+#ifndef INCLUDE_TRACE_HPP
+#define INCLUDE_TRACE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#ifndef COGNA_TRACING
+#define COGNA_TRACING 1
+#endif
+
+namespace COGNA{
+    /* Trace categories, usable as bit mask */
+    const uint32_t TRACE_NONE = 0;
+    const uint32_t TRACE_STEP = 1 << 0;
+    const uint32_t TRACE_BASE = 1 << 1;
+    const uint32_t TRACE_HABITUATION = 1 << 2;
+    const uint32_t TRACE_SENSITIZATION = 1 << 3;
+    const uint32_t TRACE_TRANSMITTER = 1 << 4;
+    const uint32_t TRACE_NEURON_BACKFALL = 1 << 5;
+    const uint32_t TRACE_LONG_LEARNING_WEIGHT = 1 << 6;
+    const uint32_t TRACE_PRESYNAPTIC = 1 << 7;
+    const uint32_t TRACE_ALL = 0xFF;
+
+    /* Traced values */
+    const uint8_t TRACE_EVENT_STEP = 1;                     /**< A network saves a step, value is the frontier size */
+    const uint8_t TRACE_EVENT_FORCE = 2;                    /**< A neuron fires at another neuron */
+    const uint8_t TRACE_EVENT_TARGET = 3;                   /**< A fired neuron is saved, value is the target network */
+    const uint8_t TRACE_EVENT_SHORT_WEIGHT = 4;
+    const uint8_t TRACE_EVENT_LONG_WEIGHT = 5;
+    const uint8_t TRACE_EVENT_LONG_LEARNING_WEIGHT = 6;
+    const uint8_t TRACE_EVENT_PRESYNAPTIC_POTENTIAL = 7;
+    const uint8_t TRACE_EVENT_ACTIVATION = 8;
+    const uint8_t TRACE_EVENT_TRANSMITTER_WEIGHT = 9;
+
+    /* Phase of a traced value */
+    const uint8_t TRACE_NOW = 0;
+    const uint8_t TRACE_BEFORE = 1;
+    const uint8_t TRACE_AFTER = 2;
+
+    const int TRACE_BUFFER_SIZE = 1 << 16;    /**< Number of events kept, has to be a power of two */
+
+    /**
+     * @brief A single binary trace record.
+     *
+     */
+    struct TraceEvent{
+        int64_t step;
+        uint32_t category;
+        uint8_t event;
+        uint8_t phase;
+        uint16_t network_id;
+        int32_t id;             /**< Neuron ID or ID of the neuron a connection stems from */
+        int32_t other_id;       /**< Target neuron or transmitter, -1 if unused */
+        float value;
+    };
+
+    /**
+     * @brief Class containing the global trace mask and ring buffer.
+     *
+     */
+    class Trace{
+        public:
+            /**
+             * @brief Checks if a category is traced. The only cost of a disabled trace point.
+             *
+             * @param category    One of the TRACE_* categories.
+             *
+             * @return            true if events of the category are recorded.
+             */
+            static inline bool enabled(uint32_t category){
+                return COGNA_TRACING && (s_categories & category) != 0;
+            }
+
+            /**
+             * @brief Stores an event in the ring buffer. Overwrites the oldest event if the buffer is full.
+             *
+             * Safe to call from several network threads at once. The event is assigned to the network
+             * set with set_network() on the calling thread.
+             *
+             */
+            static void record(uint32_t category,
+                               uint8_t event,
+                               uint8_t phase,
+                               int64_t step,
+                               int id,
+                               int other_id,
+                               float value);
+
+            /**
+             * @brief Sets the network the events of the calling thread belong to.
+             *
+             * @param network_id    The ID of the network currently stepping on this thread.
+             *
+             */
+            static void set_network(int network_id);
+
+            /**
+             * @brief Sets the traced categories.
+             *
+             * @param categories    Bit mask of TRACE_* categories.
+             *
+             */
+            static void set_categories(uint32_t categories);
+
+            /**
+             * @brief Parses a comma separated list of category names like "base,presynaptic".
+             *
+             * Known names are step, base, habituation, sensitization, transmitter, neuron_backfall,
+             * long_learning_weight, presynaptic, all and none.
+             *
+             * @param names         The list of names.
+             * @param categories    The resulting bit mask.
+             *
+             * @return              ERROR_CODE if a name is unknown, otherwise SUCCESS_CODE.
+             */
+            static int parse_categories(const std::string &names, uint32_t &categories);
+
+            /**
+             * @brief Returns the number of events recorded since the last clear(), including overwritten ones.
+             *
+             */
+            static uint64_t recorded();
+
+            /**
+             * @brief Copies the events still in the buffer, oldest first.
+             *
+             * @param events    Array with space for TRACE_BUFFER_SIZE events.
+             *
+             * @return          Number of events copied.
+             */
+            static int snapshot(TraceEvent *events);
+
+            /**
+             * @brief Drops all recorded events.
+             *
+             */
+            static void clear();
+
+            /**
+             * @brief Writes the events still in the buffer as raw TraceEvent records, oldest first.
+             *
+             * @param path    Path of the binary file.
+             *
+             * @return        ERROR_CODE if the file cannot be written, otherwise SUCCESS_CODE.
+             */
+            static int write_file(const std::string &path);
+
+            /**
+             * @brief Prints the events still in the buffer as text, oldest first.
+             *
+             * @param file    The stream to print to.
+             *
+             */
+            static void print(FILE *file);
+
+            /**
+             * @brief Sets the file flush() writes the buffer to.
+             *
+             * @param path    Path of the binary file, empty to write nothing.
+             *
+             */
+            static void set_output_file(const std::string &path);
+
+            /**
+             * @brief Writes the buffer to the output file, if one is set and events were recorded.
+             *
+             * @return        ERROR_CODE if the file cannot be written, otherwise SUCCESS_CODE.
+             */
+            static int flush();
+
+        private:
+            static uint32_t s_categories;
+            static thread_local int s_network_id;
+            static std::string s_output_file;
+            static std::atomic<uint64_t> s_head;
+            static TraceEvent s_events[TRACE_BUFFER_SIZE];
+    };
+}
+
+#endif /* INCLUDE_TRACE_HPP */
@@ -0,0 +1,58 @@
+/**
+ * @file VectorMath.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief A class containing math functions evaluated for whole arrays with SIMD instructions.
+ *
+ * The functions use AVX2 if the CPU supports it, SSE2 on other x86 CPUs and the standard
+ * library on all other platforms. The instruction set is chosen once at runtime, so the
+ * kernel does not need to be compiled for a specific CPU.
+ *
+ * @date 2021-07-10
+ *
+ */
+
+#ifndef INCLUDE_VECTORMATH_HPP
+#define INCLUDE_VECTORMATH_HPP
+
+namespace COGNA{
+    /**
+     * @brief Maximum relative difference between VectorMath::pow() and std::pow().
+     *
+     * The error grows with |exponent * log(base)|. For the small arguments of the learning
+     * gradients it stays below 1e-14.
+     *
+     */
+    const double VECTOR_POW_TOLERANCE = 1e-13;
+
+    /**
+     * @brief Class containing static array math functions.
+     */
+    class VectorMath{
+        public:
+            /**
+             * @brief Calculates result[i] = pow(base[i], exponent[i]) for a whole array.
+             *
+             * Positive normal bases are evaluated as exp(exponent * log(base)) with polynomial
+             * approximations, which differ from std::pow() by at most VECTOR_POW_TOLERANCE relative.
+             * All other cases (zero, negative or subnormal bases, infinities, NaN, results out of
+             * the range of normal doubles) are passed to std::pow().
+             *
+             * @param base        Array of bases.
+             * @param exponent    Array of exponents.
+             * @param result      Array the powers are written to. May not overlap with the inputs.
+             * @param count       Number of elements in each array.
+             *
+             */
+            static void pow(const double *base, const double *exponent, double *result, int count);
+
+            /**
+             * @brief Returns the name of the instruction set used by the array functions.
+             *
+             * @return    "AVX2", "SSE2" or "scalar".
+             */
+            static const char *instruction_set();
+    };
+}
+
+#endif /* INCLUDE_VECTORMATH_HPP */
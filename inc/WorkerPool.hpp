@@ -0,0 +1,202 @@
+/**
+ * @file WorkerPool.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief A fixed set of threads running the tasks of a cluster step with work stealing.
+ *
+ * **Note:**
+ * The tasks of a step are dealt in equal ranges to one queue per worker. Each worker first takes
+ * tasks from the front of its own queue and then steals from the back of the queues of the
+ * other workers, so a few expensive networks do not leave the rest of the pool idle. A queue is
+ * a range of task indices packed into a single atomic word, which makes taking and stealing
+ * lock free and free of allocations.
+ *
+ * The thread calling run() works as worker 0, the other workers are background threads which
+ * sleep on a PhaseBarrier between steps.
+ *
+ * @date 2021-07-16
+ *
+ */
+
+#ifndef INCLUDE_WORKERPOOL_HPP
+#define INCLUDE_WORKERPOOL_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "PhaseBarrier.hpp"
+
+namespace COGNA{
+    /**
+     * @brief Runtime statistics of a single worker.
+     *
+     */
+    struct WorkerStatistics{
+        uint64_t _busy_time;        /**< Nanoseconds spent in tasks */
+        uint64_t _tasks;            /**< Number of tasks run */
+        uint64_t _stolen_tasks;     /**< Number of tasks taken from the queue of another worker */
+    };
+
+    /**
+     * @brief Class containing the threads and queues of the pool.
+     *
+     */
+    class WorkerPool{
+    public:
+        /**
+         * @brief Starts the background threads.
+         *
+         * @param worker_number    Number of workers including the calling thread. 0 uses one worker per hardware thread.
+         *
+         */
+        WorkerPool(int worker_number);
+
+        /**
+         * @brief Stops and joins the background threads.
+         *
+         */
+        ~WorkerPool();
+
+        /**
+         * @brief Runs all tasks once and returns when all of them finished.
+         *
+         * The tasks have to be independent of each other, since their order is not defined.
+         *
+         * @param tasks    The tasks. Must not change while run() is executed.
+         *
+         */
+        void run(const std::vector<std::function<void()>> &tasks);
+
+        /**
+         * @brief Runs all tasks once, starting worker i with the tasks [first_tasks[i], first_tasks[i+1]).
+         *
+         * Used to place related tasks on the same worker, idle workers still steal the others.
+         *
+         * @param tasks          The tasks. Must not change while run() is executed.
+         * @param first_tasks    Ascending index of the first task of every worker, followed by the number of tasks.
+         *
+         */
+        void run(const std::vector<std::function<void()>> &tasks, const std::vector<uint32_t> &first_tasks);
+
+        /**
+         * @brief Pins every worker to a single CPU of a set, worker i to cpus[i % cpus.size()].
+         *
+         * Worker 0 is the calling thread, so this has to be called from the thread calling run().
+         *
+         * @param cpus    The CPUs of the workers.
+         *
+         * @return        Error code. ERROR_CODE if a worker could not be pinned.
+         *
+         */
+        int pin_workers(const std::vector<int> &cpus);
+
+        /**
+         * @brief Runs every worker with SCHED_FIFO, see RealtimeProfile::set_fifo_priority().
+         *
+         * Worker 0 is the calling thread, so this has to be called from the thread calling run().
+         *
+         * @param priority    The priority from 1 to 99.
+         *
+         * @return            Error code. ERROR_CODE with errno set if a worker kept its priority.
+         *
+         */
+        int set_fifo_priority(int priority);
+
+        /**
+         * @brief Runs a task once on every worker and returns when all of them finished.
+         *
+         * Unlike run(), no task is stolen, so the task can set up the thread it runs on.
+         *
+         * @param task    Called with the index of the worker.
+         *
+         */
+        void run_on_every_worker(const std::function<void(int)> &task);
+
+        /**
+         * @brief Returns the CPU a worker is pinned to, -1 if it is not pinned.
+         *
+         */
+        int worker_cpu(int worker) const;
+
+        /**
+         * @brief Returns the number of workers including the calling thread.
+         *
+         */
+        int worker_number() const;
+
+        /**
+         * @brief Returns the statistics of a worker since the pool was created.
+         *
+         */
+        WorkerStatistics statistics(int worker) const;
+
+        /**
+         * @brief Returns the fraction of the time spent in run() a worker was running tasks.
+         *
+         */
+        float utilization(int worker) const;
+
+        /**
+         * @brief Prints the utilization and stolen tasks of every worker to std output.
+         *
+         */
+        void print_statistics() const;
+
+    private:
+        /* Padded, so the queues of two workers never share a cache line */
+        struct WorkerQueue{
+            std::atomic<uint64_t> _range;           // Task indices [low 32 bits, high 32 bits[
+            uint64_t _busy_time;
+            uint64_t _tasks;
+            uint64_t _stolen_tasks;
+            char _padding[96];
+        };
+
+        int _worker_number;
+        std::vector<std::thread> _threads;
+        std::vector<WorkerQueue> _queues;
+        std::vector<int> _worker_cpus;                      // -1 for workers which are not pinned
+        const std::vector<std::function<void()>> *_tasks;
+        const std::function<void(int)> *_worker_task;      // Set during run_on_every_worker()
+        PhaseBarrier *_barrier;
+        uint64_t _run_time;                                 // Nanoseconds spent in run()
+
+        /**
+         * @brief Runs the tasks with the ranges already stored in the queues.
+         *
+         */
+        void run_queues(const std::vector<std::function<void()>> &tasks, uint64_t start_time);
+
+        /**
+         * @brief Loop of a background thread.
+         *
+         */
+        void work(int worker);
+
+        /**
+         * @brief Runs tasks of the own queue and stolen tasks until all queues are empty.
+         *
+         */
+        void process(int worker);
+
+        /**
+         * @brief Takes a task from the front of a queue.
+         *
+         * @return    The index of the task, -1 if the queue is empty.
+         *
+         */
+        int64_t take(int worker);
+
+        /**
+         * @brief Takes a task from the back of a queue.
+         *
+         * @return    The index of the task, -1 if the queue is empty.
+         *
+         */
+        int64_t steal(int victim);
+    };
+}
+
+#endif /* INCLUDE_WORKERPOOL_HPP */
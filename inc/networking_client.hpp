@@ -17,6 +17,8 @@
 #ifndef NETWORKING_CLIENT_HPP
 #define NETWORKING_CLIENT_HPP
 
+#include <atomic>
+#include <mutex>
 #include <string>
 #include "json.hpp"
 #include "client_server.hpp"
@@ -59,14 +61,24 @@ public:
 	 * @brief Receives a message via UDP and stores it as a string.
 	 *
 	 * Should be called in its own worker thread, so that it can continuously receive messages.
+	 * Returns after stop_receiving() was called.
 	 */
 	void receive_message();
 
+	/**
+	 * @brief Lets receive_message() return within RECEIVE_TIMEOUT_MS milliseconds.
+	 */
+	void stop_receiving();
+
 	/**
 	 * @brief Stores the message in a returnable variable.
 	 *
-	 * This function makes a snapshot of the incoming message stream. This snapshot can later be accessed to
-	 * via different functions. To receive the latest message, this function must be called.
+	 * This function takes the latest message out of the incoming message stream, so every message is stored
+	 * at most once. It can later be accessed to via different functions. To receive the latest message, this
+	 * function must be called.
+	 * If nothing arrived since the last call, the previous message is kept until clear_message() is called.
+	 * Never waits for the receiving thread. If it is just writing a message, the message is taken with the
+	 * next call.
 	 */
 	void store_message();
 
@@ -87,7 +99,7 @@ public:
 	 *
 	 * @return		The supposed value as a json. 0 if no value could be extracted for some reason.
 	 */
-	nlohmann::json get_json_value(std::string key);
+	nlohmann::json get_json_value(const std::string &key);
 
 	/**
 	 * @brief Returns the complete json hashtable.
@@ -96,10 +108,16 @@ public:
 	 */
 	nlohmann::json get_hashtable();
 
+	/**
+	 * @brief Forgets the stored message. Messages received after the last store_message() are kept.
+	 *
+	 */
 	void clear_message();
 
 private:
 	std::string _msg;
+	std::mutex _msg_lock;				// Guards _msg between the receiving and the stepping thread
+	std::atomic<bool> _receiving;
 	std::string _stored_message;
 	udp_client_server::udp_server *_receiver;
 	nlohmann::json _hashtable;
@@ -16,6 +16,7 @@
 #ifndef NETWORKING_SENDER_HPP
 #define NETWORKING_SENDER_HPP
 
+#include <memory>
 #include <string>
 #include <mutex>
 #include "json.hpp"
@@ -64,9 +65,9 @@ public:
 	 * @param value	The value of the new data inserted in the json. Adapts automatically to the type of the value.
 	 *
 	 */
-	void add_data(std::string key, float value);
-	void add_data(std::string key, int value);
-	void add_data(std::string key, std::string value);
+	void add_data(const std::string &key, float value);
+	void add_data(const std::string &key, int value);
+	void add_data(const std::string &key, std::string value);
 
 	/**
 	 * @brief Removes a single key-value pair from the json, if it exists.
@@ -95,7 +96,8 @@ public:
 	/**
 	 * @brief Sends the whole payload at once to the designated ip and port.
 	 *
-	 * The json payload sent is cleared afterwards.
+	 * The json payload sent is cleared afterwards. Its keys are kept with a null value, so a payload with
+	 * the same keys as the previous one is sent without allocating. Keys not added again are not sent.
 	 *
 	 */
 	void send_payload();
@@ -104,6 +106,14 @@ private:
 	udp_client_server::udp_client *_sender;
 	nlohmann::json _payload;
 	std::mutex _payload_mutex;
+	std::string _serialized;										// Reused by every send_payload()
+	nlohmann::detail::serializer<nlohmann::json> *_serializer;		// Writes into _serialized
+
+	/**
+	 * @brief Removes the keys which were sent with the previous payload and not added again.
+	 *
+	 */
+	static void remove_sent_data(nlohmann::json &payload);
 };
 
 } //namespace utils
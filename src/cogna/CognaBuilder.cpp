@@ -10,12 +10,18 @@
 
 #include "CognaBuilder.hpp"
 #include "Constants.hpp"
+#include "CpuPlacement.hpp"
 #include "NeuralNetwork.hpp"
 #include "Connection.hpp"
 #include "Neuron.hpp"
+#include "RealtimeProfile.hpp"
+#include "TickClock.hpp"
+#include "Trace.hpp"
 
 #include <iostream>
 #include <fstream>
+#include <random>
+#include <ctime>
 
 namespace COGNA{
 
@@ -23,6 +29,15 @@ CognaBuilder::CognaBuilder(std::string project_name){
     _project_name = project_name;
     _project_path = "../../Projects/" + project_name + "/";
     _frequency = 0;
+    _worker_threads = 0;
+    _partition_profile_steps = 0;
+    _dataflow_scheduling = false;
+    _random_seed = 0;
+    _free_running = false;
+    _max_steps = 0;
+    _overrun_policy = OVERRUN_SKIP;
+    _realtime = false;
+    _realtime_priority = DEFAULT_REALTIME_PRIORITY;
     _curr_network_neuron_number = 0;
 }
 
@@ -92,6 +107,66 @@ int CognaBuilder::get_frequency(){
     return _frequency;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+//
+int CognaBuilder::get_worker_threads(){
+    return _worker_threads;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int CognaBuilder::get_partition_profile_steps(){
+    return _partition_profile_steps;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+bool CognaBuilder::get_dataflow_scheduling(){
+    return _dataflow_scheduling;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+std::vector<int> CognaBuilder::get_worker_cpus(){
+    return _worker_cpus;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+std::vector<int> CognaBuilder::get_io_cpus(){
+    return _io_cpus;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+bool CognaBuilder::get_free_running(){
+    return _free_running;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+unsigned long long CognaBuilder::get_max_steps(){
+    return _max_steps;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int CognaBuilder::get_overrun_policy(){
+    return _overrun_policy;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+bool CognaBuilder::get_realtime(){
+    return _realtime;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int CognaBuilder::get_realtime_priority(){
+    return _realtime_priority;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 //
 int CognaBuilder::build_cogna_cluster(){
@@ -118,6 +193,20 @@ int CognaBuilder::build_cogna_cluster(){
 
     for(unsigned int i=0; i < _network_list.size(); i++){
         if(_network_list[i]->setup_network() == ERROR_CODE) return ERROR_CODE;
+        _network_list[i]->set_random_seed(_random_seed);
+    }
+    for(unsigned int i=0; i < _network_list.size(); i++){
+        _network_list[i]->reserve_deliveries(_network_list);
+    }
+    std::cout << "[INFO] Random activation uses seed " << _random_seed << "." << std::endl;
+
+    std::cout << "[INFO] Compiling network cluster." << std::endl;
+    for(unsigned int i=0; i < _network_list.size(); i++){
+        if(_network_list[i]->compile_network(_network_list) == ERROR_CODE) return ERROR_CODE;
+        std::cout << "[INFO] Network " << _network_list[i]->_network_name << " uses "
+                  << _network_list[i]->_profiles->neuron_profile_count() << " neuron and "
+                  << _network_list[i]->_profiles->connection_profile_count() << " connection parameter profiles."
+                  << std::endl;
     }
 
     return SUCCESS_CODE;
@@ -141,6 +230,111 @@ int CognaBuilder::load_globals_file(){
     _frequency = std::stoi((std::string)global_json["frequency"]);
     _main_network = global_json["main_network"];
 
+    /* Optional, one worker per hardware thread if not set */
+    if(global_json.find("worker_threads") != global_json.end()){
+        _worker_threads = std::stoi((std::string)global_json["worker_threads"]);
+        if(_worker_threads < 0){
+            std::cout << "[ERROR] Invalid number of worker threads in global.config file of project "
+                      << _project_name << std::endl;
+            return ERROR_CODE;
+        }
+    }
+
+    /* Optional, the networks are not partitioned if not set */
+    if(global_json.find("partition_profile_steps") != global_json.end()){
+        _partition_profile_steps = std::stoi((std::string)global_json["partition_profile_steps"]);
+        if(_partition_profile_steps < 0){
+            std::cout << "[ERROR] Invalid number of partition profile steps in global.config file of project "
+                      << _project_name << std::endl;
+            return ERROR_CODE;
+        }
+    }
+
+    /* Optional, all networks are stepped as one batch if not set */
+    if(global_json.find("dataflow_scheduling") != global_json.end()){
+        _dataflow_scheduling = std::stoi((std::string)global_json["dataflow_scheduling"]) != 0;
+    }
+
+    /* Optional, the cluster holds its frequency and runs until it is stopped if not set */
+    if(global_json.find("free_running") != global_json.end()){
+        _free_running = std::stoi((std::string)global_json["free_running"]) != 0;
+    }
+    if(global_json.find("max_steps") != global_json.end()){
+        std::string steps_text = global_json["max_steps"];
+        if(steps_text == "" || steps_text.find_first_not_of("0123456789") != std::string::npos || steps_text.size() > 19){
+            std::cout << "[ERROR] Invalid maximum number of steps in global.config file of project "
+                      << _project_name << std::endl;
+            return ERROR_CODE;
+        }
+        _max_steps = std::stoull(steps_text);
+    }
+
+    /* Optional, missed ticks are skipped if not set */
+    if(global_json.find("overrun_policy") != global_json.end()){
+        _overrun_policy = TickClock::parse_overrun_policy((std::string)global_json["overrun_policy"]);
+        if(_overrun_policy == ERROR_CODE){
+            std::cout << "[ERROR] Invalid overrun policy in global.config file of project "
+                      << _project_name << std::endl;
+            return ERROR_CODE;
+        }
+    }
+
+    /* Optional, the cluster runs without real-time guarantees if not set */
+    if(global_json.find("realtime") != global_json.end()){
+        _realtime = std::stoi((std::string)global_json["realtime"]) != 0;
+    }
+    if(global_json.find("realtime_priority") != global_json.end()){
+        _realtime_priority = std::stoi((std::string)global_json["realtime_priority"]);
+        if(_realtime_priority < 1 || _realtime_priority > 99){
+            std::cout << "[ERROR] Invalid real-time priority in global.config file of project "
+                      << _project_name << std::endl;
+            return ERROR_CODE;
+        }
+    }
+
+    /* Optional, a new seed every run if not set */
+    if(global_json.find("random_seed") != global_json.end()){
+        std::string seed_text = global_json["random_seed"];
+        if(seed_text == "" || seed_text.find_first_not_of("0123456789") != std::string::npos || seed_text.size() > 19){
+            std::cout << "[ERROR] Invalid random seed in global.config file of project "
+                      << _project_name << std::endl;
+            return ERROR_CODE;
+        }
+        _random_seed = std::stoull(seed_text);
+    }
+    else{
+        std::random_device device;
+        _random_seed = ((uint64_t)device() << 32) ^ device() ^ (uint64_t)time(NULL);
+    }
+
+    /* Optional, the threads may run on every CPU if not set */
+    if(global_json.find("worker_cpus") != global_json.end()){
+        if(CpuPlacement::parse_cpu_list((std::string)global_json["worker_cpus"], _worker_cpus) == ERROR_CODE){
+            std::cout << "[ERROR] Invalid worker CPUs in global.config file of project "
+                      << _project_name << std::endl;
+            return ERROR_CODE;
+        }
+    }
+    if(global_json.find("io_cpus") != global_json.end()){
+        if(CpuPlacement::parse_cpu_list((std::string)global_json["io_cpus"], _io_cpus) == ERROR_CODE){
+            std::cout << "[ERROR] Invalid networking CPUs in global.config file of project "
+                      << _project_name << std::endl;
+            return ERROR_CODE;
+        }
+    }
+
+    /* Optional, tracing is off if not set */
+    if(global_json.find("trace") != global_json.end()){
+        uint32_t categories = TRACE_NONE;
+        if(Trace::parse_categories((std::string)global_json["trace"], categories) == ERROR_CODE){
+            std::cout << "[ERROR] Invalid trace categories in global.config file of project "
+                      << _project_name << std::endl;
+            return ERROR_CODE;
+        }
+        Trace::set_categories(categories);
+        Trace::set_output_file(_project_path + "trace.bin");
+    }
+
     return SUCCESS_CODE;
 }
 
@@ -218,51 +412,53 @@ int CognaBuilder::load_neurons(NeuralNetwork *nn, nlohmann::json network_json){
             nn->set_random_neuron_activation(n_id, random_chance, random_value);
         }
 
-        nn->_neurons[n_id]->_parameter->initial_base_weight = load_neuron_parameter(network_json["neurons"][i], "base_weight", neuron_type);
-        nn->_neurons[n_id]->_parameter->max_weight = load_neuron_parameter(network_json["neurons"][i], "max_weight", neuron_type);
-        nn->_neurons[n_id]->_parameter->min_weight = load_neuron_parameter(network_json["neurons"][i], "min_weight", neuron_type);
-        nn->_neurons[n_id]->_parameter->activation_type = load_neuron_parameter(network_json["neurons"][i], "activation_type", neuron_type);
-        nn->_neurons[n_id]->_parameter->activation_function = load_neuron_parameter(network_json["neurons"][i], "activation_function", neuron_type);
-        nn->_neurons[n_id]->_parameter->learning_type = load_neuron_parameter(network_json["neurons"][i], "learning_type", neuron_type);
-        nn->_neurons[n_id]->_parameter->transmitter_type = load_neuron_parameter(network_json["neurons"][i], "transmitter_type", neuron_type);
-
-        nn->_neurons[n_id]->_parameter->short_habituation_curvature = load_neuron_parameter(network_json["neurons"][i], "short_habituation_curvature", neuron_type);
-        nn->_neurons[n_id]->_parameter->short_habituation_steepness = load_neuron_parameter(network_json["neurons"][i], "short_habituation_steepness", neuron_type);
-        nn->_neurons[n_id]->_parameter->short_sensitization_curvature = load_neuron_parameter(network_json["neurons"][i], "short_sensitization_curvature", neuron_type);
-        nn->_neurons[n_id]->_parameter->short_sensitization_steepness = load_neuron_parameter(network_json["neurons"][i], "short_sensitization_steepness", neuron_type);
-        nn->_neurons[n_id]->_parameter->short_dehabituation_curvature = load_neuron_parameter(network_json["neurons"][i], "short_dehabituation_curvature", neuron_type);
-        nn->_neurons[n_id]->_parameter->short_dehabituation_steepness = load_neuron_parameter(network_json["neurons"][i], "short_dehabituation_steepness", neuron_type);
-        nn->_neurons[n_id]->_parameter->short_desensitization_curvature = load_neuron_parameter(network_json["neurons"][i], "short_desensitization_curvature", neuron_type);
-        nn->_neurons[n_id]->_parameter->short_desensitization_steepness = load_neuron_parameter(network_json["neurons"][i], "short_desensitization_steepness", neuron_type);
-
-        nn->_neurons[n_id]->_parameter->long_habituation_curvature = load_neuron_parameter(network_json["neurons"][i], "long_habituation_curvature", neuron_type);
-        nn->_neurons[n_id]->_parameter->long_habituation_steepness = load_neuron_parameter(network_json["neurons"][i], "long_habituation_steepness", neuron_type);
-        nn->_neurons[n_id]->_parameter->long_sensitization_curvature = load_neuron_parameter(network_json["neurons"][i], "long_sensitization_curvature", neuron_type);
-        nn->_neurons[n_id]->_parameter->long_sensitization_steepness = load_neuron_parameter(network_json["neurons"][i], "long_sensitization_steepness", neuron_type);
-        nn->_neurons[n_id]->_parameter->long_dehabituation_curvature = load_neuron_parameter(network_json["neurons"][i], "long_dehabituation_curvature", neuron_type);
-        nn->_neurons[n_id]->_parameter->long_dehabituation_steepness = load_neuron_parameter(network_json["neurons"][i], "long_dehabituation_steepness", neuron_type);
-        nn->_neurons[n_id]->_parameter->long_desensitization_curvature = load_neuron_parameter(network_json["neurons"][i], "long_desensitization_curvature", neuron_type);
-        nn->_neurons[n_id]->_parameter->long_desensitization_steepness = load_neuron_parameter(network_json["neurons"][i], "long_desensitization_steepness", neuron_type);
-
-        nn->_neurons[n_id]->_parameter->presynaptic_potential_curvature = load_neuron_parameter(network_json["neurons"][i], "presynaptic_potential_curvature", neuron_type);
-        nn->_neurons[n_id]->_parameter->presynaptic_potential_steepness = load_neuron_parameter(network_json["neurons"][i], "presynaptic_potential_steepness", neuron_type);
-        nn->_neurons[n_id]->_parameter->presynaptic_backfall_curvature = load_neuron_parameter(network_json["neurons"][i], "presynaptic_backfall_curvature", neuron_type);
-        nn->_neurons[n_id]->_parameter->presynaptic_backfall_steepness = load_neuron_parameter(network_json["neurons"][i], "presynaptic_backfall_steepness", neuron_type);
-
-        nn->_neurons[n_id]->_parameter->long_learning_weight_reduction_curvature = load_neuron_parameter(network_json["neurons"][i], "long_learning_weight_reduction_curvature", neuron_type);
-        nn->_neurons[n_id]->_parameter->long_learning_weight_reduction_steepness = load_neuron_parameter(network_json["neurons"][i], "long_learning_weight_reduction_steepness", neuron_type);
-        nn->_neurons[n_id]->_parameter->long_learning_weight_backfall_curvature = load_neuron_parameter(network_json["neurons"][i], "long_learning_weight_backfall_curvature", neuron_type);
-        nn->_neurons[n_id]->_parameter->long_learning_weight_backfall_steepness = load_neuron_parameter(network_json["neurons"][i], "long_learning_weight_backfall_steepness", neuron_type);
-
-        nn->_neurons[n_id]->_parameter->habituation_threshold = load_neuron_parameter(network_json["neurons"][i], "habituation_threshold", neuron_type);
-        nn->_neurons[n_id]->_parameter->sensitization_threshold = load_neuron_parameter(network_json["neurons"][i], "sensitization_threshold", neuron_type);
-
-        nn->_neurons[n_id]->_parameter->max_activation = load_neuron_parameter(network_json["neurons"][i], "max_activation", neuron_type);
-        nn->_neurons[n_id]->_parameter->min_activation = load_neuron_parameter(network_json["neurons"][i], "min_activation", neuron_type);
-        nn->_neurons[n_id]->_parameter->activation_backfall_curvature = load_neuron_parameter(network_json["neurons"][i], "activation_backfall_curvature", neuron_type);
-        nn->_neurons[n_id]->_parameter->activation_backfall_steepness = load_neuron_parameter(network_json["neurons"][i], "activation_backfall_steepness", neuron_type);
-        nn->_neurons[n_id]->_parameter->transmitter_change_curvature = load_neuron_parameter(network_json["neurons"][i], "transmitter_change_curvature", neuron_type);
-        nn->_neurons[n_id]->_parameter->transmitter_change_steepness = load_neuron_parameter(network_json["neurons"][i], "transmitter_change_steepness", neuron_type);
+        NeuronParameterHandler parameter = *nn->_neurons[n_id]->_parameter;
+        parameter.initial_base_weight = load_neuron_parameter(network_json["neurons"][i], "base_weight", neuron_type);
+        parameter.max_weight = load_neuron_parameter(network_json["neurons"][i], "max_weight", neuron_type);
+        parameter.min_weight = load_neuron_parameter(network_json["neurons"][i], "min_weight", neuron_type);
+        parameter.activation_type = load_neuron_parameter(network_json["neurons"][i], "activation_type", neuron_type);
+        parameter.activation_function = load_neuron_parameter(network_json["neurons"][i], "activation_function", neuron_type);
+        parameter.learning_type = load_neuron_parameter(network_json["neurons"][i], "learning_type", neuron_type);
+        parameter.transmitter_type = load_neuron_parameter(network_json["neurons"][i], "transmitter_type", neuron_type);
+
+        parameter.short_habituation_curvature = load_neuron_parameter(network_json["neurons"][i], "short_habituation_curvature", neuron_type);
+        parameter.short_habituation_steepness = load_neuron_parameter(network_json["neurons"][i], "short_habituation_steepness", neuron_type);
+        parameter.short_sensitization_curvature = load_neuron_parameter(network_json["neurons"][i], "short_sensitization_curvature", neuron_type);
+        parameter.short_sensitization_steepness = load_neuron_parameter(network_json["neurons"][i], "short_sensitization_steepness", neuron_type);
+        parameter.short_dehabituation_curvature = load_neuron_parameter(network_json["neurons"][i], "short_dehabituation_curvature", neuron_type);
+        parameter.short_dehabituation_steepness = load_neuron_parameter(network_json["neurons"][i], "short_dehabituation_steepness", neuron_type);
+        parameter.short_desensitization_curvature = load_neuron_parameter(network_json["neurons"][i], "short_desensitization_curvature", neuron_type);
+        parameter.short_desensitization_steepness = load_neuron_parameter(network_json["neurons"][i], "short_desensitization_steepness", neuron_type);
+
+        parameter.long_habituation_curvature = load_neuron_parameter(network_json["neurons"][i], "long_habituation_curvature", neuron_type);
+        parameter.long_habituation_steepness = load_neuron_parameter(network_json["neurons"][i], "long_habituation_steepness", neuron_type);
+        parameter.long_sensitization_curvature = load_neuron_parameter(network_json["neurons"][i], "long_sensitization_curvature", neuron_type);
+        parameter.long_sensitization_steepness = load_neuron_parameter(network_json["neurons"][i], "long_sensitization_steepness", neuron_type);
+        parameter.long_dehabituation_curvature = load_neuron_parameter(network_json["neurons"][i], "long_dehabituation_curvature", neuron_type);
+        parameter.long_dehabituation_steepness = load_neuron_parameter(network_json["neurons"][i], "long_dehabituation_steepness", neuron_type);
+        parameter.long_desensitization_curvature = load_neuron_parameter(network_json["neurons"][i], "long_desensitization_curvature", neuron_type);
+        parameter.long_desensitization_steepness = load_neuron_parameter(network_json["neurons"][i], "long_desensitization_steepness", neuron_type);
+
+        parameter.presynaptic_potential_curvature = load_neuron_parameter(network_json["neurons"][i], "presynaptic_potential_curvature", neuron_type);
+        parameter.presynaptic_potential_steepness = load_neuron_parameter(network_json["neurons"][i], "presynaptic_potential_steepness", neuron_type);
+        parameter.presynaptic_backfall_curvature = load_neuron_parameter(network_json["neurons"][i], "presynaptic_backfall_curvature", neuron_type);
+        parameter.presynaptic_backfall_steepness = load_neuron_parameter(network_json["neurons"][i], "presynaptic_backfall_steepness", neuron_type);
+
+        parameter.long_learning_weight_reduction_curvature = load_neuron_parameter(network_json["neurons"][i], "long_learning_weight_reduction_curvature", neuron_type);
+        parameter.long_learning_weight_reduction_steepness = load_neuron_parameter(network_json["neurons"][i], "long_learning_weight_reduction_steepness", neuron_type);
+        parameter.long_learning_weight_backfall_curvature = load_neuron_parameter(network_json["neurons"][i], "long_learning_weight_backfall_curvature", neuron_type);
+        parameter.long_learning_weight_backfall_steepness = load_neuron_parameter(network_json["neurons"][i], "long_learning_weight_backfall_steepness", neuron_type);
+
+        parameter.habituation_threshold = load_neuron_parameter(network_json["neurons"][i], "habituation_threshold", neuron_type);
+        parameter.sensitization_threshold = load_neuron_parameter(network_json["neurons"][i], "sensitization_threshold", neuron_type);
+
+        parameter.max_activation = load_neuron_parameter(network_json["neurons"][i], "max_activation", neuron_type);
+        parameter.min_activation = load_neuron_parameter(network_json["neurons"][i], "min_activation", neuron_type);
+        parameter.activation_backfall_curvature = load_neuron_parameter(network_json["neurons"][i], "activation_backfall_curvature", neuron_type);
+        parameter.activation_backfall_steepness = load_neuron_parameter(network_json["neurons"][i], "activation_backfall_steepness", neuron_type);
+        parameter.transmitter_change_curvature = load_neuron_parameter(network_json["neurons"][i], "transmitter_change_curvature", neuron_type);
+        parameter.transmitter_change_steepness = load_neuron_parameter(network_json["neurons"][i], "transmitter_change_steepness", neuron_type);
+        nn->_neurons[n_id]->set_parameter(parameter);
     }
 
     return SUCCESS_CODE;
@@ -347,67 +543,71 @@ int CognaBuilder::load_nodes(NeuralNetwork *nn, nlohmann::json network_json){
 //----------------------------------------------------------------------------------------------------------------------
 //
 int CognaBuilder::load_all_connection_parameter(Connection *connection_object, nlohmann::json connection_json){
-    connection_object->_parameter->max_weight = load_connection_parameter(connection_object->_parameter->short_habituation_curvature,
-                                                                                                  connection_json, "max_weight");
-    connection_object->_parameter->min_weight = load_connection_parameter(connection_object->_parameter->short_habituation_curvature,
-                                                                                                  connection_json, "min_weight");
-
-    connection_object->_parameter->short_habituation_curvature = load_connection_parameter(connection_object->_parameter->short_habituation_curvature,
-                                                                                                  connection_json, "short_habituation_curvature");
-    connection_object->_parameter->short_habituation_steepness = load_connection_parameter(connection_object->_parameter->short_habituation_steepness,
-                                                                                                  connection_json, "short_habituation_steepness");
-    connection_object->_parameter-> short_sensitization_curvature = load_connection_parameter(connection_object->_parameter->short_sensitization_curvature,
-                                                                                                  connection_json, "short_sensitization_curvature");
-    connection_object->_parameter->short_sensitization_steepness = load_connection_parameter(connection_object->_parameter->short_sensitization_steepness,
-                                                                                                  connection_json, "short_sensitization_steepness");
-    connection_object->_parameter->short_dehabituation_curvature = load_connection_parameter(connection_object->_parameter->short_dehabituation_curvature,
-                                                                                                  connection_json, "short_dehabituation_curvature");
-    connection_object->_parameter->short_dehabituation_steepness = load_connection_parameter(connection_object->_parameter->short_dehabituation_steepness,
-                                                                                                  connection_json, "short_dehabituation_steepness");
-    connection_object->_parameter->short_desensitization_curvature = load_connection_parameter(connection_object->_parameter->short_desensitization_curvature,
-                                                                                                  connection_json, "short_desensitization_curvature");
-    connection_object->_parameter->short_desensitization_steepness = load_connection_parameter(connection_object->_parameter->short_desensitization_steepness,
-                                                                                                  connection_json, "short_desensitization_steepness");
-
-    connection_object->_parameter->long_habituation_curvature = load_connection_parameter(connection_object->_parameter->long_habituation_curvature,
-                                                                                                  connection_json, "long_habituation_curvature");
-    connection_object->_parameter->long_habituation_steepness = load_connection_parameter(connection_object->_parameter->long_habituation_steepness,
-                                                                                                  connection_json, "long_habituation_steepness");
-    connection_object->_parameter->long_sensitization_curvature = load_connection_parameter(connection_object->_parameter->long_sensitization_curvature,
-                                                                                                  connection_json, "long_sensitization_curvature");
-    connection_object->_parameter->long_sensitization_steepness = load_connection_parameter(connection_object->_parameter->long_sensitization_steepness,
-                                                                                                  connection_json, "long_sensitization_steepness");
-    connection_object->_parameter->long_dehabituation_curvature = load_connection_parameter(connection_object->_parameter->long_dehabituation_curvature,
-                                                                                                  connection_json, "long_dehabituation_curvature");
-    connection_object->_parameter->long_dehabituation_steepness = load_connection_parameter(connection_object->_parameter->long_dehabituation_steepness,
-                                                                                                  connection_json, "long_dehabituation_steepness");
-    connection_object->_parameter->long_desensitization_curvature = load_connection_parameter(connection_object->_parameter->long_desensitization_curvature,
-                                                                                                  connection_json, "long_desensitization_curvature");
-    connection_object->_parameter->long_desensitization_steepness = load_connection_parameter(connection_object->_parameter->long_desensitization_steepness,
-                                                                                                  connection_json, "long_desensitization_steepness");
-
-    connection_object->_parameter->presynaptic_potential_curvature = load_connection_parameter(connection_object->_parameter->presynaptic_potential_curvature,
-                                                                                                  connection_json, "presynaptic_potential_curvature");
-    connection_object->_parameter->presynaptic_potential_steepness = load_connection_parameter(connection_object->_parameter->presynaptic_potential_steepness,
-                                                                                                  connection_json, "presynaptic_potential_steepness");
-    connection_object->_parameter->presynaptic_backfall_curvature = load_connection_parameter(connection_object->_parameter->presynaptic_backfall_curvature,
-                                                                                                  connection_json, "presynaptic_backfall_curvature");
-    connection_object->_parameter->presynaptic_backfall_steepness = load_connection_parameter(connection_object->_parameter->presynaptic_backfall_steepness,
-                                                                                                  connection_json, "presynaptic_backfall_steepness");
-
-    connection_object->_parameter->long_learning_weight_reduction_curvature = load_connection_parameter(connection_object->_parameter->long_learning_weight_reduction_curvature,
-                                                                                                  connection_json, "long_learning_weight_reduction_curvature");
-    connection_object->_parameter->long_learning_weight_reduction_steepness = load_connection_parameter(connection_object->_parameter->long_learning_weight_reduction_steepness,
-                                                                                                  connection_json, "long_learning_weight_reduction_steepness");
-    connection_object->_parameter->long_learning_weight_backfall_curvature = load_connection_parameter(connection_object->_parameter->long_learning_weight_backfall_curvature,
-                                                                                                  connection_json, "long_learning_weight_backfall_curvature");
-    connection_object->_parameter->long_learning_weight_backfall_steepness = load_connection_parameter(connection_object->_parameter->long_learning_weight_backfall_steepness,
-                                                                                                  connection_json, "long_learning_weight_backfall_steepness");
-
-    connection_object->_parameter->habituation_threshold = load_connection_parameter(connection_object->_parameter->habituation_threshold,
-                                                                                                  connection_json, "habituation_threshold");
-    connection_object->_parameter->sensitization_threshold = load_connection_parameter(connection_object->_parameter->sensitization_threshold,
-                                                                                                  connection_json, "sensitization_threshold");
+    ConnectionParameterHandler parameter = *connection_object->_parameter;
+
+    parameter.max_weight = load_connection_parameter(parameter.short_habituation_curvature,
+                                                     connection_json, "max_weight");
+    parameter.min_weight = load_connection_parameter(parameter.short_habituation_curvature,
+                                                     connection_json, "min_weight");
+
+    parameter.short_habituation_curvature = load_connection_parameter(parameter.short_habituation_curvature,
+                                                                      connection_json, "short_habituation_curvature");
+    parameter.short_habituation_steepness = load_connection_parameter(parameter.short_habituation_steepness,
+                                                                      connection_json, "short_habituation_steepness");
+    parameter.short_sensitization_curvature = load_connection_parameter(parameter.short_sensitization_curvature,
+                                                                        connection_json, "short_sensitization_curvature");
+    parameter.short_sensitization_steepness = load_connection_parameter(parameter.short_sensitization_steepness,
+                                                                        connection_json, "short_sensitization_steepness");
+    parameter.short_dehabituation_curvature = load_connection_parameter(parameter.short_dehabituation_curvature,
+                                                                        connection_json, "short_dehabituation_curvature");
+    parameter.short_dehabituation_steepness = load_connection_parameter(parameter.short_dehabituation_steepness,
+                                                                        connection_json, "short_dehabituation_steepness");
+    parameter.short_desensitization_curvature = load_connection_parameter(parameter.short_desensitization_curvature,
+                                                                          connection_json, "short_desensitization_curvature");
+    parameter.short_desensitization_steepness = load_connection_parameter(parameter.short_desensitization_steepness,
+                                                                          connection_json, "short_desensitization_steepness");
+
+    parameter.long_habituation_curvature = load_connection_parameter(parameter.long_habituation_curvature,
+                                                                     connection_json, "long_habituation_curvature");
+    parameter.long_habituation_steepness = load_connection_parameter(parameter.long_habituation_steepness,
+                                                                     connection_json, "long_habituation_steepness");
+    parameter.long_sensitization_curvature = load_connection_parameter(parameter.long_sensitization_curvature,
+                                                                       connection_json, "long_sensitization_curvature");
+    parameter.long_sensitization_steepness = load_connection_parameter(parameter.long_sensitization_steepness,
+                                                                       connection_json, "long_sensitization_steepness");
+    parameter.long_dehabituation_curvature = load_connection_parameter(parameter.long_dehabituation_curvature,
+                                                                       connection_json, "long_dehabituation_curvature");
+    parameter.long_dehabituation_steepness = load_connection_parameter(parameter.long_dehabituation_steepness,
+                                                                       connection_json, "long_dehabituation_steepness");
+    parameter.long_desensitization_curvature = load_connection_parameter(parameter.long_desensitization_curvature,
+                                                                         connection_json, "long_desensitization_curvature");
+    parameter.long_desensitization_steepness = load_connection_parameter(parameter.long_desensitization_steepness,
+                                                                         connection_json, "long_desensitization_steepness");
+
+    parameter.presynaptic_potential_curvature = load_connection_parameter(parameter.presynaptic_potential_curvature,
+                                                                          connection_json, "presynaptic_potential_curvature");
+    parameter.presynaptic_potential_steepness = load_connection_parameter(parameter.presynaptic_potential_steepness,
+                                                                          connection_json, "presynaptic_potential_steepness");
+    parameter.presynaptic_backfall_curvature = load_connection_parameter(parameter.presynaptic_backfall_curvature,
+                                                                         connection_json, "presynaptic_backfall_curvature");
+    parameter.presynaptic_backfall_steepness = load_connection_parameter(parameter.presynaptic_backfall_steepness,
+                                                                         connection_json, "presynaptic_backfall_steepness");
+
+    parameter.long_learning_weight_reduction_curvature = load_connection_parameter(parameter.long_learning_weight_reduction_curvature,
+                                                                                   connection_json, "long_learning_weight_reduction_curvature");
+    parameter.long_learning_weight_reduction_steepness = load_connection_parameter(parameter.long_learning_weight_reduction_steepness,
+                                                                                   connection_json, "long_learning_weight_reduction_steepness");
+    parameter.long_learning_weight_backfall_curvature = load_connection_parameter(parameter.long_learning_weight_backfall_curvature,
+                                                                                  connection_json, "long_learning_weight_backfall_curvature");
+    parameter.long_learning_weight_backfall_steepness = load_connection_parameter(parameter.long_learning_weight_backfall_steepness,
+                                                                                  connection_json, "long_learning_weight_backfall_steepness");
+
+    parameter.habituation_threshold = load_connection_parameter(parameter.habituation_threshold,
+                                                                connection_json, "habituation_threshold");
+    parameter.sensitization_threshold = load_connection_parameter(parameter.sensitization_threshold,
+                                                                  connection_json, "sensitization_threshold");
+
+    connection_object->set_parameter(parameter);
 
     return SUCCESS_CODE;
 }
@@ -575,6 +775,24 @@ int CognaBuilder::load_network_parameter(NeuralNetwork *nn, nlohmann::json netwo
     nn->_parameter->max_transmitter_weight = std::stof((std::string)network_json["network"]["max_transmitter_weight"]);
     nn->_parameter->min_transmitter_weight = std::stof((std::string)network_json["network"]["min_transmitter_weight"]);
 
+    /* Optional, since older projects do not know about it */
+    if(network_json["network"].find("dense_frontier_threshold") != network_json["network"].end()){
+        nn->_parameter->dense_frontier_threshold = std::stof((std::string)network_json["network"]["dense_frontier_threshold"]);
+    }
+    if(network_json["network"].find("batch_learning") != network_json["network"].end()){
+        nn->_parameter->batch_learning = std::stoi((std::string)network_json["network"]["batch_learning"]) != 0;
+    }
+    if(network_json["network"].find("parallel_threads") != network_json["network"].end()){
+        nn->_parameter->parallel_threads = std::stoi((std::string)network_json["network"]["parallel_threads"]);
+    }
+    if(network_json["network"].find("gather_propagation") != network_json["network"].end()){
+        nn->_parameter->gather_propagation = std::stoi((std::string)network_json["network"]["gather_propagation"]) != 0;
+    }
+    if(network_json["network"].find("huge_pages") != network_json["network"].end()){
+        /* Loaded before the neurons, so all of them are stored in huge pages */
+        nn->_arena->set_huge_pages(std::stoi((std::string)network_json["network"]["huge_pages"]) != 0);
+    }
+
     return SUCCESS_CODE;
 }
 
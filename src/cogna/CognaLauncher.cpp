@@ -10,28 +10,57 @@
 
 #include "CognaLauncher.hpp"
 #include "Constants.hpp"
+#include "CpuPlacement.hpp"
 #include "HelperFunctions.hpp"
+#include "RealtimeProfile.hpp"
+#include "Trace.hpp"
+#include <algorithm>
 #include <iostream>
+#include <iomanip>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
 #include <unistd.h>
 #include <ctime>
-#include <mutex>
 
 namespace COGNA{
+    namespace{
+        /**
+         * @brief Stops a free-running cluster on SIGINT and SIGTERM, so that it still reports its statistics.
+         *
+         */
+        void stop_cluster(int){
+            NeuralNetwork::m_cluster_state = STATE_STOPPED;
+        }
+    }
 
 CognaLauncher::CognaLauncher(std::vector<NeuralNetwork*> network_list,
                              std::vector<utils::networking_client*> client_list,
                              std::vector<utils::networking_sender*> sender_list,
-                             int frequency){
+                             int frequency,
+                             int worker_threads){
     _network_list = network_list;
     _client_list = client_list;
     _sender_list = sender_list;
+    _worker_pool = nullptr;
+    _partitioner = nullptr;
+    _partition_profile_steps = 0;
+    _scheduler = nullptr;
+    _dataflow_scheduling = false;
     _frequency = frequency;
+    _tick_clock.set_frequency(frequency);
+    _free_running = false;
+    _realtime = false;
+    _realtime_priority = DEFAULT_REALTIME_PRIORITY;
+    _max_steps = 0;
+    _worker_threads = worker_threads;
     _curr_cluster_step = new unsigned long long(0);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 //
 CognaLauncher::~CognaLauncher(){
+    stop_networking_workers();
     for(unsigned int i=0; i < _network_list.size(); i++){
         delete _network_list[i];
         _network_list[i] = nullptr;
@@ -44,11 +73,11 @@ CognaLauncher::~CognaLauncher(){
         delete _client_list[i];
         _client_list[i] = nullptr;
     }
-    for(unsigned int i=0; i < _client_worker_list.size(); i++){
-        delete _client_worker_list[i];
-        _client_worker_list[i] = nullptr;
-    }
 
+    delete _partitioner;
+    _partitioner = nullptr;
+    delete _scheduler;
+    _scheduler = nullptr;
     delete _curr_cluster_step;
 }
 
@@ -61,82 +90,153 @@ void CognaLauncher::tester(){
 //----------------------------------------------------------------------------------------------------------------------
 //
 int CognaLauncher::run_cogna(){
-    // TODO Split in multiple functions
     std::cout << std::endl;
     std::cout << "####################### Starting COGNA #######################"
               << std::endl << std::endl;
 
     struct timeval _cluster_time;
-    long curr_time, prev_time, time_delta, sleep_time = 0;
 
-    std::condition_variable *thread_condition_lock = new std::condition_variable;
+    /* Real-time workers default to the CPUs the kernel keeps free for them */
+    if(_realtime && _worker_cpus.empty()){
+        CpuPlacement::isolated_cpus(_worker_cpus);
+    }
 
     create_networking_workers();
-    create_cogna_workers(thread_condition_lock);
+    create_cogna_workers();
+    if(_realtime){
+        apply_realtime_profile();
+    }
+
+    /* Wait 0.1 seconds to ensure networking sockets and networks to connect */
+    bool has_io = (_client_list.empty() == false || _sender_list.empty() == false);
+    if(_free_running == false || has_io){
+        usleep(100000);
+    }
 
-    usleep(100000); //wait 0.1 seconds to ensure networking sockets and networks to connect
-    int iterator = 0;
+    void (*prev_sigint)(int) = SIG_DFL;
+    void (*prev_sigterm)(int) = SIG_DFL;
+    if(_free_running){
+        prev_sigint = std::signal(SIGINT, stop_cluster);
+        prev_sigterm = std::signal(SIGTERM, stop_cluster);
+        std::cout << "[INFO] Running free";
+        if(_max_steps > 0){
+            std::cout << " for " << _max_steps << " steps";
+        }
+        std::cout << ", stop with SIGINT." << std::endl;
+    }
 
-    curr_time = utils::get_time_microsec(_cluster_time);
-    prev_time = curr_time;
+    *_curr_cluster_step = 0;
+    long start_time = utils::get_time_microsec(_cluster_time);
+    _tick_clock.start();
     while(NeuralNetwork::m_cluster_state != STATE_STOPPED){
-        if(NeuralNetwork::m_cluster_state != STATE_PAUSE){
-            prev_time = utils::get_time_microsec(_cluster_time);
-            for(unsigned int i=0; i < _client_list.size(); i++){
-                _client_list[i]->store_message();
-            }
+        if(_max_steps > 0 && *_curr_cluster_step >= _max_steps){
+            break;
+        }
 
-            for(unsigned int i=0; i < _network_list.size(); i++){
-                _network_list[i]->receive_data();   // Here happens seg fault
+        /* A paused cluster keeps its ticks, so it continues on the same grid */
+        unsigned long long steps = 1;
+        if(_free_running){
+            steps = FREE_RUNNING_BATCH;
+            if(_max_steps > 0 && _max_steps - *_curr_cluster_step < steps){
+                steps = _max_steps - *_curr_cluster_step;
             }
+        }
+        else{
+            _tick_clock.wait();
+        }
 
-            thread_condition_lock->notify_all();
-
-            // std::cout << std::endl;
-            // std::cout << iterator << std::endl;
-            // Waiting and checking if all threads have finished
-            int finished_thread_number = 0;
-            while(finished_thread_number < (int)_cogna_worker_list.size()){
-                finished_thread_number = 0;
-                for(unsigned int i=0; i < _network_list.size(); i++){
-                    finished_thread_number += (int)_network_list[i]->_is_finished;
-                }
-            }
-            for(unsigned int i=0; i < _network_list.size(); i++){
-                _network_list[i]->_is_finished = false;
-            }
+        if(NeuralNetwork::m_cluster_state != STATE_PAUSE){
+            *_curr_cluster_step += step_cluster(steps);
+        }
+        else if(_free_running){
+            usleep(MICROSECOND_FACTOR / _frequency);
+        }
+    }
 
-            for(unsigned int i=0; i < _sender_list.size(); i++){
-                _sender_list[i]->send_payload();
-            }
+    double run_time = (utils::get_time_microsec(_cluster_time) - start_time) / (double)MICROSECOND_FACTOR;
+    if(_free_running){
+        std::signal(SIGINT, prev_sigint);
+        std::signal(SIGTERM, prev_sigterm);
+    }
+    std::cout << "[INFO] Ran " << *_curr_cluster_step << " steps in " << std::fixed << std::setprecision(3)
+              << run_time << " s, " << std::setprecision(1)
+              << ((run_time > 0.0) ? *_curr_cluster_step / run_time : 0.0) << " steps per second."
+              << std::defaultfloat << std::endl;
 
-            for(unsigned int i=0; i < _client_list.size(); i++){
-                _client_list[i]->clear_message();
-            }
+    if(_free_running == false){
+        _tick_clock.print_statistics();
+    }
+    _worker_pool->print_statistics();
+    if(_scheduler){
+        _scheduler->print_statistics();
+    }
+    delete _scheduler;
+    _scheduler = nullptr;
+    for(unsigned int i=0; i < _parallel_networks.size(); i++){
+        _parallel_networks[i]->set_worker_pool(NULL);
+    }
+    _parallel_networks.clear();
+    delete _worker_pool;
+    _worker_pool = nullptr;
+    _step_tasks.clear();
+    _first_tasks.clear();
+    delete _partitioner;
+    _partitioner = nullptr;
 
-            curr_time = utils::get_time_microsec(_cluster_time);
+    if(Trace::flush() == ERROR_CODE){
+        std::cout << "[ERROR] Could not write trace file." << std::endl;
+    }
 
-            time_delta = curr_time - prev_time;
-            sleep_time = (MICROSECOND_FACTOR / _frequency) - time_delta;
+    return SUCCESS_CODE;
+}
 
-            iterator ++;
+//----------------------------------------------------------------------------------------------------------------------
+//
+unsigned long long CognaLauncher::step_cluster(unsigned long long steps){
+    for(unsigned int i=0; i < _client_list.size(); i++){
+        _client_list[i]->store_message();
+    }
 
-            if(sleep_time > 0){
-                usleep(sleep_time);
-            }
+    for(unsigned int i=0; i < _network_list.size(); i++){
+        _network_list[i]->receive_data();
+    }
+
+    /* The launcher steps networks itself and returns when all networks finished the step */
+    bool has_io = (_client_list.empty() == false || _sender_list.empty() == false);
+    if(has_io || _partitioner || _scheduler == nullptr){
+        steps = 1;
+    }
+    if(_scheduler){
+        _scheduler->run(steps);
+    }
+    else if(_first_tasks.empty()){
+        _worker_pool->run(_step_tasks);
+    }
+    else{
+        _worker_pool->run(_step_tasks, _first_tasks);
+    }
+
+    /* Their chunks run on the workers, which cannot nest runs, so they are stepped by the calling thread */
+    for(unsigned int i=0; i < _parallel_networks.size(); i++){
+        _parallel_networks[i]->feed_forward(_network_list);
+    }
+
+    if(_partitioner){
+        _partitioner->profile_step();
+        if(_partitioner->profiled_steps() >= _partition_profile_steps){
+            partition_cluster();
         }
     }
 
-    for(unsigned int i=0; i < _cogna_worker_list.size(); i++){
-        delete _cogna_worker_list[i];
-        _cogna_worker_list[i] = nullptr;
+    for(unsigned int i=0; i < _sender_list.size(); i++){
+        _sender_list[i]->send_payload();
     }
-    _cogna_worker_list.clear();
 
-    delete thread_condition_lock;
-    thread_condition_lock = nullptr;
+    for(unsigned int i=0; i < _client_list.size(); i++){
+        _client_list[i]->clear_message();
+    }
 
-    return SUCCESS_CODE;
+    return steps;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -145,6 +245,16 @@ int CognaLauncher::create_networking_workers(){
     for(unsigned int i=0; i < _client_list.size(); i++){
         std::thread *client_worker = new std::thread(&utils::networking_client::receive_message, _client_list[i]);
         _client_worker_list.push_back(client_worker);
+
+        if(_io_cpus.empty() == false &&
+           CpuPlacement::pin_thread(client_worker->native_handle(), _io_cpus) == ERROR_CODE){
+            std::cout << "[ERROR] Could not pin networking thread " << i << " to CPUs "
+                      << CpuPlacement::format_cpu_list(_io_cpus) << "." << std::endl;
+        }
+    }
+    if(_io_cpus.empty() == false && _client_list.empty() == false){
+        std::cout << "[INFO] Receiving UDP messages with " << _client_list.size() << " threads on CPUs "
+                  << CpuPlacement::format_cpu_list(_io_cpus) << "." << std::endl;
     }
 
     return SUCCESS_CODE;
@@ -152,16 +262,347 @@ int CognaLauncher::create_networking_workers(){
 
 //----------------------------------------------------------------------------------------------------------------------
 //
-int CognaLauncher::create_cogna_workers(std::condition_variable *thread_lock){
+int CognaLauncher::apply_realtime_profile(){
+    int guarantees = 0;
+    int missing = 0;
+    std::cout << "[INFO] Applying the real-time profile with priority " << _realtime_priority << "." << std::endl;
+
+    /* Locked first, so the pages touched below stay in memory */
+    guarantees++;
+    if(RealtimeProfile::lock_memory() == ERROR_CODE){
+        uint64_t limit = RealtimeProfile::lock_limit();
+        std::cout << "[ERROR] Real-time: memory is not locked, mlockall() failed: " << strerror(errno)
+                  << ". Needs CAP_IPC_LOCK or a larger RLIMIT_MEMLOCK, currently ";
+        if(limit == UINT64_MAX){
+            std::cout << "unlimited." << std::endl;
+        }
+        else{
+            std::cout << limit / 1024 << " kB." << std::endl;
+        }
+        missing++;
+    }
+    else{
+        std::cout << "[INFO] Real-time: memory is locked." << std::endl;
+    }
+
+    guarantees++;
+    for(unsigned int i=0; i < _network_list.size(); i++){
+        _network_list[i]->prefault();
+    }
+    _worker_pool->run_on_every_worker([](int){ RealtimeProfile::prefault_stack(); });
+    std::cout << "[INFO] Real-time: " << _network_list.size() << " networks and " << REALTIME_STACK_PREFAULT / 1024
+              << " kB of stack of every worker are pre-faulted." << std::endl;
+
+    guarantees++;
+    if(_worker_pool->set_fifo_priority(_realtime_priority) == ERROR_CODE){
+        std::cout << "[ERROR] Real-time: workers do not run with SCHED_FIFO: " << strerror(errno)
+                  << ". Needs CAP_SYS_NICE or RLIMIT_RTPRIO of at least " << _realtime_priority << ", currently "
+                  << RealtimeProfile::priority_limit() << "." << std::endl;
+        missing++;
+    }
+    else{
+        std::cout << "[INFO] Real-time: workers run with SCHED_FIFO priority " << _realtime_priority << "."
+                  << std::endl;
+    }
+
+    if(_client_worker_list.empty() == false){
+        guarantees++;
+        int io_priority = (_realtime_priority > 1) ? _realtime_priority - 1 : 1;
+        int result = SUCCESS_CODE;
+        for(unsigned int i=0; i < _client_worker_list.size(); i++){
+            if(RealtimeProfile::set_fifo_priority(_client_worker_list[i]->native_handle(), io_priority) == ERROR_CODE){
+                result = ERROR_CODE;
+            }
+        }
+        if(result == ERROR_CODE){
+            std::cout << "[ERROR] Real-time: networking threads do not run with SCHED_FIFO: " << strerror(errno)
+                      << ". Needs CAP_SYS_NICE or RLIMIT_RTPRIO of at least " << io_priority << "." << std::endl;
+            missing++;
+        }
+        else{
+            std::cout << "[INFO] Real-time: networking threads run with SCHED_FIFO priority " << io_priority << "."
+                      << std::endl;
+        }
+    }
+
+    guarantees++;
+    std::vector<int> isolated;
+    CpuPlacement::isolated_cpus(isolated);
+    std::vector<int> shared;
+    for(int worker=0; worker < _worker_pool->worker_number(); worker++){
+        int cpu = _worker_pool->worker_cpu(worker);
+        if(cpu < 0 || std::find(isolated.begin(), isolated.end(), cpu) == isolated.end()){
+            shared.push_back(worker);
+        }
+    }
+    if(isolated.empty()){
+        std::cout << "[ERROR] Real-time: no CPU is isolated, the workers share their CPUs with other tasks. "
+                  << "Isolate CPUs with the boot parameter isolcpus." << std::endl;
+        missing++;
+    }
+    else if(shared.empty() == false){
+        std::cout << "[ERROR] Real-time: " << shared.size() << " workers do not run on the isolated CPUs "
+                  << CpuPlacement::format_cpu_list(isolated) << "." << std::endl;
+        missing++;
+    }
+    else{
+        std::cout << "[INFO] Real-time: workers run on the isolated CPUs " << CpuPlacement::format_cpu_list(isolated)
+                  << "." << std::endl;
+    }
+
+    std::cout << "[INFO] Real-time profile applied " << guarantees - missing << " of " << guarantees
+              << " guarantees." << std::endl;
+    return missing;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CognaLauncher::stop_networking_workers(){
+    for(unsigned int i=0; i < _client_list.size(); i++){
+        _client_list[i]->stop_receiving();
+    }
+    for(unsigned int i=0; i < _client_worker_list.size(); i++){
+        _client_worker_list[i]->join();
+        delete _client_worker_list[i];
+        _client_worker_list[i] = nullptr;
+    }
+    _client_worker_list.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int CognaLauncher::create_cogna_workers(){
+    int worker_number = _worker_threads;
+    if(worker_number <= 0){
+        /* More workers than networks would only spin without work, unless a network splits its steps */
+        int max_workers = _network_list.size();
+        for(unsigned int i=0; i < _network_list.size(); i++){
+            if(_network_list[i]->is_parallel() && _network_list[i]->_parameter->parallel_threads > max_workers){
+                max_workers = _network_list[i]->_parameter->parallel_threads;
+            }
+        }
+        worker_number = std::thread::hardware_concurrency();
+        if(worker_number <= 0 || worker_number > max_workers){
+            worker_number = max_workers;
+        }
+    }
+    if(worker_number <= 0){
+        worker_number = 1;
+    }
+
+    _worker_pool = new WorkerPool(worker_number);
+    _parallel_networks.clear();
     for(unsigned int i=0; i < _network_list.size(); i++){
-        std::thread *cogna_worker1 = new std::thread(&NeuralNetwork::listen_to_cluster,
-                                                    _network_list[i],
-                                                    _network_list,
-                                                    thread_lock);
-        _cogna_worker_list.push_back(cogna_worker1);
+        if(_network_list[i]->is_parallel()){
+            _network_list[i]->set_worker_pool(_worker_pool);
+            _parallel_networks.push_back(_network_list[i]);
+            std::cout << "[INFO] NN-" << _network_list[i]->_id << " runs its dense steps on all workers." << std::endl;
+        }
+        else if(_network_list[i]->_parameter->parallel_threads > 1){
+            std::cout << "[WARNING] NN-" << _network_list[i]->_id << " sets parallel_threads, but takes no dense "
+                      << "steps on a compiled network. It is stepped as a single task." << std::endl;
+        }
+    }
+    create_step_tasks();
+    std::cout << "[INFO] Stepping " << _network_list.size() << " networks with "
+              << _worker_pool->worker_number() << " worker threads." << std::endl;
+
+    if(_worker_cpus.empty() == false){
+        if(_worker_pool->pin_workers(_worker_cpus) == ERROR_CODE){
+            std::cout << "[ERROR] Could not pin all workers to CPUs "
+                      << CpuPlacement::format_cpu_list(_worker_cpus) << "." << std::endl;
+        }
+        for(int worker=0; worker < _worker_pool->worker_number(); worker++){
+            int cpu = _worker_pool->worker_cpu(worker);
+            if(cpu >= 0){
+                std::cout << "[INFO] Worker " << worker << " runs on CPU " << cpu << " of NUMA node "
+                          << CpuPlacement::numa_node(cpu) << "." << std::endl;
+            }
+        }
+        place_networks();
+    }
+
+    if(_dataflow_scheduling && _parallel_networks.empty() == false){
+        std::cout << "[INFO] Dataflow scheduling is not used, since networks step on all workers." << std::endl;
+    }
+    else if(_dataflow_scheduling){
+        _scheduler = new DataflowScheduler(_network_list, _worker_pool);
+        std::cout << "[INFO] Scheduling " << _network_list.size() << " networks in "
+                  << _scheduler->group_count() << " independent groups by their deliveries." << std::endl;
+    }
+
+    /* A single worker has nothing to place */
+    if(_partition_profile_steps > 0 && _worker_pool->worker_number() > 1){
+        _partitioner = new GraphPartitioner(_network_list);
     }
 
     return SUCCESS_CODE;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CognaLauncher::set_partition_map(const PartitionMap &partition_map){
+    _partition_map = partition_map;
+    for(unsigned int i=0; i < _network_list.size() && i < _partition_map._neuron_shards.size(); i++){
+        _network_list[i]->set_partition(_partition_map._neuron_shards[i]);
+    }
+    if(_worker_pool){
+        create_step_tasks();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CognaLauncher::set_partition_profile_steps(int profile_steps){
+    _partition_profile_steps = profile_steps;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CognaLauncher::set_dataflow_scheduling(bool dataflow_scheduling){
+    _dataflow_scheduling = dataflow_scheduling;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CognaLauncher::set_worker_cpus(const std::vector<int> &cpus){
+    _worker_cpus = cpus;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CognaLauncher::set_io_cpus(const std::vector<int> &cpus){
+    _io_cpus = cpus;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CognaLauncher::set_free_running(bool free_running){
+    _free_running = free_running;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CognaLauncher::set_max_steps(unsigned long long max_steps){
+    _max_steps = max_steps;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CognaLauncher::set_realtime(bool realtime){
+    _realtime = realtime;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CognaLauncher::set_realtime_priority(int priority){
+    _realtime_priority = priority;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CognaLauncher::set_overrun_policy(int overrun_policy){
+    _tick_clock.set_overrun_policy(overrun_policy);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+const TickClock &CognaLauncher::get_tick_clock() const{
+    return _tick_clock;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+unsigned long long CognaLauncher::get_cluster_step() const{
+    return *_curr_cluster_step;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CognaLauncher::create_step_tasks(){
+    _step_tasks.clear();
+    _first_tasks.clear();
+    if(_partition_map._network_shards.size() != _network_list.size()){
+        for(unsigned int i=0; i < _network_list.size(); i++){
+            NeuralNetwork *network = _network_list[i];
+            if(network->is_parallel()){
+                continue;
+            }
+            _step_tasks.push_back([this, network](){ network->feed_forward(_network_list); });
+        }
+        return;
+    }
+
+    int worker_number = _worker_pool->worker_number();
+    for(int worker=0; worker < worker_number; worker++){
+        _first_tasks.push_back(_step_tasks.size());
+        for(unsigned int i=0; i < _network_list.size(); i++){
+            int shard = _partition_map._network_shards[i] < 0 ? 0 : _partition_map._network_shards[i];
+            if(shard % worker_number == worker && _network_list[i]->is_parallel() == false){
+                NeuralNetwork *network = _network_list[i];
+                _step_tasks.push_back([this, network](){ network->feed_forward(_network_list); });
+            }
+        }
+    }
+    _first_tasks.push_back(_step_tasks.size());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CognaLauncher::partition_cluster(){
+    std::cout << "[INFO] Partitioning the cluster after " << _partitioner->profiled_steps() << " profiled steps."
+              << std::endl;
+    /* One shard per worker, which are also the workers splitting the steps of parallel networks */
+    PartitionMap partition_map = _partitioner->partition(_worker_pool->worker_number());
+    partition_map.print_statistics();
+    set_partition_map(partition_map);
+    if(_worker_cpus.empty() == false){
+        place_networks();
+    }
+
+    delete _partitioner;
+    _partitioner = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int CognaLauncher::home_worker(unsigned int network_index){
+    int worker_number = _worker_pool->worker_number();
+    if(_first_tasks.empty() == false){
+        int shard = _partition_map._network_shards[network_index];
+        return (shard < 0) ? 0 : shard % worker_number;
+    }
+
+    /* Same ranges as WorkerPool::run() and the first networks the DataflowScheduler tries */
+    for(int worker=worker_number - 1; worker > 0; worker--){
+        if(network_index >= (uint64_t)_network_list.size() * worker / worker_number){
+            return worker;
+        }
+    }
+    return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CognaLauncher::place_networks(){
+    for(unsigned int i=0; i < _network_list.size(); i++){
+        int worker = home_worker(i);
+        int cpu = _worker_pool->worker_cpu(worker);
+        int node = (cpu >= 0) ? CpuPlacement::numa_node(cpu) : -1;
+        if(node < 0){
+            std::cout << "[INFO] NN-" << _network_list[i]->_id << " starts on worker " << worker
+                      << ", its NUMA node is unknown." << std::endl;
+            continue;
+        }
+
+        if(_network_list[i]->bind_to_node(node) == ERROR_CODE){
+            std::cout << "[ERROR] Could not move NN-" << _network_list[i]->_id << " to NUMA node " << node
+                      << "." << std::endl;
+            continue;
+        }
+        std::cout << "[INFO] NN-" << _network_list[i]->_id << " starts on worker " << worker
+                  << " and is stored on NUMA node " << node << "." << std::endl;
+    }
+}
+
 } //namespace COGNA
@@ -0,0 +1,682 @@
+/**
+ * @file CompiledNetwork.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the CompiledNetwork class.
+ *
+ * @date 2021-07-05
+ *
+ */
+
+#include "CompiledNetwork.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "NeuralNetwork.hpp"
+#include "Neuron.hpp"
+#include "Connection.hpp"
+#include "Constants.hpp"
+#include "CpuPlacement.hpp"
+#include "MathUtils.hpp"
+#include "RealtimeProfile.hpp"
+#include "Trace.hpp"
+#include "VectorMath.hpp"
+#include "NeuronParameterHandler.hpp"
+#include "ConnectionParameterHandler.hpp"
+
+using namespace COGNA;
+
+namespace COGNA{
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+static uint32_t find_connection_index(NeuralNetwork *nn, Connection *con){
+    uint32_t index = 0;
+    Neuron *source = con->prev_neuron;
+
+    for(int n=0; n<source->_id; n++){
+        index += nn->_neurons[n]->_connections.size();
+    }
+    for(unsigned int i=0; i<source->_connections.size(); i++){
+        if(source->_connections[i] == con){
+            return index + i;
+        }
+    }
+    return index;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+CompiledNetwork::CompiledNetwork(NeuralNetwork *nn, const std::vector<NeuralNetwork*> &network_list){
+    _network_id = nn->_id;
+    _neuron_count = nn->_neurons.size();
+
+    _offsets.resize(_neuron_count + 1);
+    _offsets[0] = 0;
+    for(uint32_t n=0; n<_neuron_count; n++){
+        _offsets[n+1] = _offsets[n] + nn->_neurons[n]->_connections.size();
+    }
+    _connection_count = _offsets[_neuron_count];
+
+    _activation.resize(_neuron_count);
+    _next_activation.resize(_neuron_count);
+    _threshold.resize(_neuron_count);
+    _was_activated.resize(_neuron_count);
+    _last_activated_step.resize(_neuron_count);
+    _last_fired_step.resize(_neuron_count);
+    _neuron_parameter.resize(_neuron_count);
+    _neuron_objects = nn->_neurons;
+
+    _targets.resize(_connection_count);
+    _target_networks.resize(_connection_count);
+    _target_kinds.resize(_connection_count);
+    _sources.resize(_connection_count);
+    _base_weight.resize(_connection_count);
+    _short_weight.resize(_connection_count);
+    _long_weight.resize(_connection_count);
+    _long_learning_weight.resize(_connection_count);
+    _presynaptic_potential.resize(_connection_count);
+    _last_presynaptic_activated_step.resize(_connection_count);
+    _last_connection_step.resize(_connection_count);
+    _activation_type.resize(_connection_count);
+    _activation_function.resize(_connection_count);
+    _transmitter_type.resize(_connection_count);
+    _connection_parameter.resize(_connection_count);
+    _connection_objects.resize(_connection_count);
+
+    for(uint32_t n=0; n<_neuron_count; n++){
+        Neuron *neuron = nn->_neurons[n];
+        _activation[n] = neuron->_activation;
+        _next_activation[n] = neuron->_next_activation;
+        _threshold[n] = neuron->_parameter->activation_threshold;
+        _was_activated[n] = neuron->_was_activated;
+        _last_activated_step[n] = neuron->_last_activated_step;
+        _last_fired_step[n] = neuron->_last_fired_step;
+        _neuron_parameter[n] = neuron->_parameter;
+
+        for(uint32_t i=0; i<neuron->_connections.size(); i++){
+            uint32_t con = _offsets[n] + i;
+            Connection *connection = neuron->_connections[i];
+
+            _sources[con] = n;
+            if(connection->next_neuron){
+                _targets[con] = connection->next_neuron->_id;
+                _target_networks[con] = connection->next_neuron->_network_id;
+                _target_kinds[con] = EDGE_TARGET_NEURON;
+            }
+            else{
+                Connection *next_connection = connection->next_connection;
+                int next_network_id = next_connection->prev_neuron->_network_id;
+                if(next_network_id == _network_id){
+                    _targets[con] = find_connection_index(nn, next_connection);
+                }
+                else{
+                    _targets[con] = find_connection_index(network_list[next_network_id], next_connection);
+                }
+                _target_networks[con] = next_network_id;
+                _target_kinds[con] = EDGE_TARGET_CONNECTION;
+            }
+
+            _base_weight[con] = connection->base_weight;
+            _short_weight[con] = connection->short_weight;
+            _long_weight[con] = connection->long_weight;
+            _long_learning_weight[con] = connection->long_learning_weight;
+            _presynaptic_potential[con] = connection->presynaptic_potential;
+            _last_presynaptic_activated_step[con] = connection->last_presynaptic_activated_step;
+            _last_connection_step[con] = connection->last_activated_step;
+            _activation_type[con] = connection->_parameter->activation_type;
+            _activation_function[con] = connection->_parameter->activation_function;
+            _transmitter_type[con] = connection->_parameter->transmitter_type;
+            _connection_parameter[con] = connection->_parameter;
+            _connection_objects[con] = connection;
+        }
+    }
+
+    _run_offsets.resize(_neuron_count + 1);
+    for(uint32_t n=0; n<_neuron_count; n++){
+        _run_offsets[n] = _run_starts.size();
+        for(uint32_t con=_offsets[n]; con<_offsets[n+1]; con++){
+            int kernel = kernel_id(_target_kinds[con], _activation_function[con],
+                                   _connection_parameter[con]->learning_type);
+            if(con == _offsets[n] || kernel != _run_kernels.back()){
+                _run_starts.push_back(con);
+                _run_kernels.push_back(kernel);
+            }
+        }
+
+        /* Rows of mixed kernels keep their order, since the forces reach the targets in connection order */
+        uint32_t runs = _run_starts.size() - _run_offsets[n];
+        if(runs > 1 && _offsets[n+1] - _offsets[n] < runs * MIN_KERNEL_RUN_LENGTH){
+            _run_starts.resize(_run_offsets[n] + 1);
+            _run_kernels.resize(_run_offsets[n] + 1);
+            _run_kernels.back() = KERNEL_ANY_TYPE;
+        }
+    }
+    _run_offsets[_neuron_count] = _run_starts.size();
+    _run_starts.push_back(_connection_count);
+
+    uint32_t max_row = 0;
+    _batch_learning_rows.assign(_neuron_count, 1);
+    for(uint32_t n=0; n<_neuron_count; n++){
+        if(_offsets[n+1] - _offsets[n] > max_row){
+            max_row = _offsets[n+1] - _offsets[n];
+        }
+        for(uint32_t con=_offsets[n]; con<_offsets[n+1]; con++){
+            if(_target_networks[con] != _network_id){
+                continue;
+            }
+            if((_target_kinds[con] == EDGE_TARGET_NEURON && _targets[con] == n) ||
+               (_target_kinds[con] == EDGE_TARGET_CONNECTION && _sources[_targets[con]] == n)){
+                _batch_learning_rows[n] = 0;
+            }
+        }
+    }
+    _max_row_length = max_row;
+    reserve_learning_buffers(_learning_buffers);
+
+    _curr_neurons.reserve(_neuron_count);
+    _next_neurons.reserve(_neuron_count);
+    load_scheduled_neurons(nn->_curr_neurons, _curr_neurons);
+    load_scheduled_neurons(nn->_next_neurons, _next_neurons);
+
+    /* Starts at 1, so no neuron is marked as received into the current step */
+    _schedule_epoch = 1;
+    _scheduled_epoch.assign(_neuron_count, -1);
+    _frontier_bits.assign((_neuron_count + 63) / 64, 0);
+    for(unsigned int i=0; i<_next_neurons.size(); i++){
+        _scheduled_epoch[_next_neurons[i]] = _schedule_epoch;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+CompiledNetwork::~CompiledNetwork(){
+    _neuron_objects.clear();
+    _connection_objects.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::load_scheduled_neurons(const std::vector<Neuron*> &neuron_objects,
+                                             std::vector<uint32_t> &neurons){
+    neurons.clear();
+    for(unsigned int i=0; i<neuron_objects.size(); i++){
+        neurons.push_back(neuron_objects[i]->_id);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::store_scheduled_neurons(const std::vector<uint32_t> &neurons,
+                                              std::vector<Neuron*> &neuron_objects){
+    neuron_objects.clear();
+    for(unsigned int i=0; i<neurons.size(); i++){
+        neuron_objects.push_back(_neuron_objects[neurons[i]]);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::store_state(NeuralNetwork *nn){
+    for(uint32_t n=0; n<_neuron_count; n++){
+        Neuron *neuron = _neuron_objects[n];
+        neuron->_activation = _activation[n];
+        neuron->_next_activation = _next_activation[n];
+        neuron->_was_activated = _was_activated[n];
+        neuron->_last_activated_step = _last_activated_step[n];
+        neuron->_last_fired_step = (int)_last_fired_step[n];
+    }
+
+    for(uint32_t con=0; con<_connection_count; con++){
+        Connection *connection = _connection_objects[con];
+        connection->base_weight = _base_weight[con];
+        connection->short_weight = _short_weight[con];
+        connection->long_weight = _long_weight[con];
+        connection->long_learning_weight = _long_learning_weight[con];
+        connection->presynaptic_potential = _presynaptic_potential[con];
+        connection->last_presynaptic_activated_step = _last_presynaptic_activated_step[con];
+        connection->last_activated_step = _last_connection_step[con];
+    }
+
+    store_scheduled_neurons(_curr_neurons, nn->_curr_neurons);
+    store_scheduled_neurons(_next_neurons, nn->_next_neurons);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int CompiledNetwork::kernel_id(int target_kind, int activation_function, int learning_type){
+    if(learning_type < LEARNING_NONE || learning_type > LEARNING_HABISENS){
+        return KERNEL_ANY_TYPE;
+    }
+    if(target_kind == EDGE_TARGET_CONNECTION){
+        return 13 + learning_type - LEARNING_NONE;
+    }
+    if(activation_function < FUNCTION_SIGMOID || activation_function > FUNCTION_RELU){
+        return KERNEL_ANY_TYPE;
+    }
+    return 1 + 4 * (activation_function - FUNCTION_SIGMOID) + learning_type - LEARNING_NONE;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+ConnectionStateRef CompiledNetwork::connection_state(uint32_t con){
+    ConnectionStateRef connection_state = {_base_weight[con],
+                                           _short_weight[con],
+                                           _long_weight[con],
+                                           _long_learning_weight[con],
+                                           _presynaptic_potential[con],
+                                           _last_presynaptic_activated_step[con],
+                                           _last_connection_step[con]};
+    return connection_state;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+bool CompiledNetwork::is_active(uint32_t neuron){
+    return _activation[neuron] >= _threshold[neuron];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::init_activation(uint32_t neuron, float activation){
+    _activation[neuron] += activation;
+    _curr_neurons.push_back(neuron);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::reserve_learning_buffers(LearningBuffers &buffers) const{
+    buffers._pow_base.resize(4 * _max_row_length);
+    buffers._pow_exponent.resize(4 * _max_row_length);
+    buffers._pow_result.resize(4 * _max_row_length);
+    buffers._habituation_jobs.resize(_max_row_length);
+    buffers._sensitization_jobs.resize(_max_row_length);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::batch_learning(uint32_t neuron, int64_t network_step){
+    batch_learning(neuron, network_step, _learning_buffers);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::batch_learning(uint32_t neuron, int64_t network_step, LearningBuffers &buffers){
+    uint32_t first_con = _offsets[neuron];
+    uint32_t row_length = _offsets[neuron+1] - first_con;
+    float activation = _activation[neuron];
+    int jobs = 0;
+
+    /* The powers only depend on the activation and the long learning weight, which is updated first */
+    for(uint32_t i=0; i<row_length; i++){
+        uint32_t con = first_con + i;
+        const ConnectionParameterHandler *parameter = _connection_parameter[con];
+        ConnectionStateRef state = connection_state(con);
+        NetworkKernels::long_learning_weight_backfall(state, parameter, network_step, neuron);
+
+        buffers._habituation_jobs[i] = -1;
+        if((parameter->learning_type == LEARNING_HABITUATION || parameter->learning_type == LEARNING_HABISENS) &&
+           activation < parameter->habituation_threshold){
+            float x = parameter->habituation_threshold - activation;
+            buffers._habituation_jobs[i] = jobs;
+            buffers._pow_base[jobs] = x;
+            buffers._pow_exponent[jobs++] = parameter->short_habituation_curvature;
+            buffers._pow_base[jobs] = x * state.long_learning_weight;
+            buffers._pow_exponent[jobs++] = parameter->long_habituation_curvature;
+            NetworkKernels::long_learning_weight_reduction(state, parameter, network_step, neuron);
+        }
+
+        buffers._sensitization_jobs[i] = -1;
+        if((parameter->learning_type == LEARNING_SENSITIZATION || parameter->learning_type == LEARNING_HABISENS) &&
+           activation > parameter->sensitization_threshold){
+            float x = activation - parameter->sensitization_threshold;
+            buffers._sensitization_jobs[i] = jobs;
+            buffers._pow_base[jobs] = x;
+            buffers._pow_exponent[jobs++] = parameter->short_sensitization_curvature;
+            buffers._pow_base[jobs] = x * state.long_learning_weight;
+            buffers._pow_exponent[jobs++] = parameter->long_sensitization_curvature;
+            NetworkKernels::long_learning_weight_reduction(state, parameter, network_step, neuron);
+        }
+    }
+
+    if(jobs > 0){
+        VectorMath::pow(buffers._pow_base.data(), buffers._pow_exponent.data(), buffers._pow_result.data(), jobs);
+    }
+
+    for(uint32_t i=0; i<row_length; i++){
+        uint32_t con = first_con + i;
+        const ConnectionParameterHandler *parameter = _connection_parameter[con];
+        ConnectionStateRef state = connection_state(con);
+
+        if(parameter->learning_type == LEARNING_HABITUATION || parameter->learning_type == LEARNING_HABISENS){
+            NetworkKernels::dehabituate(state, parameter, network_step, neuron);
+            int32_t job = buffers._habituation_jobs[i];
+            if(job >= 0){
+                state.short_weight = MathUtils::apply_dynamic_gradient(state.short_weight,
+                                                                       parameter->short_habituation_steepness,
+                                                                       buffers._pow_result[job],
+                                                                       SUBTRACT,
+                                                                       parameter->max_weight,
+                                                                       parameter->min_weight);
+                state.long_weight = MathUtils::apply_dynamic_gradient(state.long_weight,
+                                                                      parameter->long_habituation_steepness,
+                                                                      buffers._pow_result[job+1],
+                                                                      SUBTRACT,
+                                                                      parameter->max_weight,
+                                                                      parameter->min_weight);
+            }
+        }
+
+        if(parameter->learning_type == LEARNING_SENSITIZATION || parameter->learning_type == LEARNING_HABISENS){
+            NetworkKernels::desensitize(state, parameter, network_step, neuron);
+            int32_t job = buffers._sensitization_jobs[i];
+            if(job >= 0){
+                state.short_weight = MathUtils::apply_dynamic_gradient(state.short_weight,
+                                                                       parameter->short_sensitization_steepness,
+                                                                       buffers._pow_result[job],
+                                                                       ADD,
+                                                                       parameter->max_weight,
+                                                                       parameter->min_weight);
+                state.long_weight = MathUtils::apply_dynamic_gradient(state.long_weight,
+                                                                      parameter->long_sensitization_steepness,
+                                                                      buffers._pow_result[job+1],
+                                                                      ADD,
+                                                                      parameter->max_weight,
+                                                                      parameter->min_weight);
+            }
+        }
+
+        state.last_activated_step = network_step;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+template<int FUNCTION>
+void CompiledNetwork::activate_next_neuron(uint32_t con,
+                                           CompiledNetwork *target,
+                                           int64_t network_step,
+                                           const std::vector<float> &transmitter_weights){
+    uint32_t prev = _sources[con];
+    uint32_t next = _targets[con];
+
+    NetworkKernels::neuron_backfall(target->_activation[next],
+                                    target->_was_activated[next],
+                                    target->_last_activated_step[next],
+                                    target->_neuron_parameter[next],
+                                    network_step,
+                                    next);
+
+    target->_next_activation[next] += neuron_force<FUNCTION>(con, transmitter_weights);
+    target->_was_activated[next] = true;
+
+    if(next != 0){
+        if(Trace::enabled(TRACE_BASE)){
+            Trace::record(TRACE_BASE, TRACE_EVENT_FORCE, TRACE_NOW, network_step, prev, next, _activation[prev]);
+        }
+    }
+}
+
+template void CompiledNetwork::activate_next_neuron<KERNEL_ANY_TYPE>(uint32_t, CompiledNetwork*, int64_t,
+                                                                     const std::vector<float>&);
+template void CompiledNetwork::activate_next_neuron<FUNCTION_SIGMOID>(uint32_t, CompiledNetwork*, int64_t,
+                                                                      const std::vector<float>&);
+template void CompiledNetwork::activate_next_neuron<FUNCTION_LINEAR>(uint32_t, CompiledNetwork*, int64_t,
+                                                                     const std::vector<float>&);
+template void CompiledNetwork::activate_next_neuron<FUNCTION_RELU>(uint32_t, CompiledNetwork*, int64_t,
+                                                                   const std::vector<float>&);
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+template<int FUNCTION>
+float CompiledNetwork::neuron_force(uint32_t con, const std::vector<float> &transmitter_weights){
+    uint32_t prev = _sources[con];
+    float temp_activation = _short_weight[con] * _activation[prev];
+
+    return NetworkKernels::typed_activation_function<FUNCTION>(_activation_function[con], temp_activation, prev) *
+           _activation_type[con] *
+           transmitter_weights[_transmitter_type[con]];
+}
+
+template float CompiledNetwork::neuron_force<KERNEL_ANY_TYPE>(uint32_t, const std::vector<float>&);
+template float CompiledNetwork::neuron_force<FUNCTION_SIGMOID>(uint32_t, const std::vector<float>&);
+template float CompiledNetwork::neuron_force<FUNCTION_LINEAR>(uint32_t, const std::vector<float>&);
+template float CompiledNetwork::neuron_force<FUNCTION_RELU>(uint32_t, const std::vector<float>&);
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::presynaptic_potential_backfall(uint32_t con, int64_t network_step){
+    ConnectionStateRef state = connection_state(con);
+    NetworkKernels::presynaptic_potential_backfall(state, _connection_parameter[con], network_step, _sources[con]);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::receive_delivery(const NetworkDelivery &delivery){
+    uint32_t next = delivery.target;
+
+    if(delivery.kind == DELIVERY_CONNECTION){
+        if(_presynaptic_potential[next] > DEFAULT_PRESYNAPTIC_POTENTIAL){
+            ConnectionStateRef next_state = connection_state(next);
+            NetworkKernels::basic_learning(next_state,
+                                           _connection_parameter[next],
+                                           delivery.value,
+                                           delivery.activation_type,
+                                           delivery.step,
+                                           _sources[next]);
+            _presynaptic_potential[next] = DEFAULT_PRESYNAPTIC_POTENTIAL;
+        }
+        _last_presynaptic_activated_step[next] = delivery.step;
+        return;
+    }
+
+    /* Activation the neuron already got from its own network in the same step is added to */
+    if(_was_activated[next] == false && _last_activated_step[next] == delivery.step){
+        _next_activation[next] = _activation[next];
+        _was_activated[next] = true;
+    }
+    NetworkKernels::neuron_backfall(_activation[next],
+                                    _was_activated[next],
+                                    _last_activated_step[next],
+                                    _neuron_parameter[next],
+                                    delivery.step,
+                                    next);
+    _next_activation[next] += delivery.value;
+    _was_activated[next] = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::save_received_neuron(uint32_t neuron, int64_t network_step){
+    if(_was_activated[neuron] == true){
+        _activation[neuron] = _next_activation[neuron];
+        _next_activation[neuron] = 0.0f;
+    }
+    _was_activated[neuron] = false;
+
+    /* Neurons of the current step were scheduled in the previous epoch */
+    if(_activation[neuron] > 0.0f){
+        _last_activated_step[neuron] = network_step;
+        if(_scheduled_epoch[neuron] != _schedule_epoch - 1){
+            _scheduled_epoch[neuron] = _schedule_epoch - 1;
+            _curr_neurons.push_back(neuron);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::activate_next_connection(uint32_t con, CompiledNetwork *target, int64_t network_step){
+    uint32_t prev = _sources[con];
+    uint32_t next = _targets[con];
+
+    if(Trace::enabled(TRACE_PRESYNAPTIC)){
+        Trace::record(TRACE_PRESYNAPTIC, TRACE_EVENT_PRESYNAPTIC_POTENTIAL, TRACE_BEFORE,
+                      network_step, prev, -1, target->_presynaptic_potential[next]);
+    }
+
+    presynaptic_potential_backfall(con, network_step);
+    if(target->_presynaptic_potential[next] > DEFAULT_PRESYNAPTIC_POTENTIAL){
+        ConnectionStateRef next_state = target->connection_state(next);
+        NetworkKernels::basic_learning(next_state,
+                                       target->_connection_parameter[next],
+                                       _activation[prev],
+                                       _activation_type[con],
+                                       network_step,
+                                       target->_sources[next]);
+        target->_presynaptic_potential[next] = DEFAULT_PRESYNAPTIC_POTENTIAL;
+    }
+
+    target->_last_presynaptic_activated_step[next] = network_step;
+
+    if(Trace::enabled(TRACE_PRESYNAPTIC)){
+        Trace::record(TRACE_PRESYNAPTIC, TRACE_EVENT_PRESYNAPTIC_POTENTIAL, TRACE_AFTER,
+                      network_step, prev, -1, target->_presynaptic_potential[next]);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::clear_neuron_activation(uint32_t neuron, int64_t network_step){
+    NetworkKernels::clear_neuron_activation(_activation[neuron], _neuron_parameter[neuron], network_step, neuron);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::schedule_neuron(uint32_t neuron){
+    if(_scheduled_epoch[neuron] != _schedule_epoch){
+        _scheduled_epoch[neuron] = _schedule_epoch;
+        _next_neurons.push_back(neuron);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::load_frontier_bits(){
+    for(unsigned int i=0; i<_curr_neurons.size(); i++){
+        _frontier_bits[_curr_neurons[i] >> 6] |= (uint64_t)1 << (_curr_neurons[i] & 63);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::clear_frontier_bits(){
+    for(unsigned int i=0; i<_curr_neurons.size(); i++){
+        _frontier_bits[_curr_neurons[i] >> 6] = 0;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::build_incoming_connections(){
+    _incoming_offsets.assign(_neuron_count + 1, 0);
+    _incoming.clear();
+
+    for(uint32_t next=0; next<_neuron_count; next++){
+        _incoming_offsets[next] = _incoming.size();
+        const std::vector<Neuron*> &previous = _neuron_objects[next]->_previous;
+        for(unsigned int i=0; i<previous.size(); i++){
+            if(previous[i]->_network_id != _network_id){
+                continue;
+            }
+            uint32_t prev = previous[i]->_id;
+            for(uint32_t con=_offsets[prev]; con<_offsets[prev+1]; con++){
+                if(_target_kinds[con] == EDGE_TARGET_NEURON && _target_networks[con] == _network_id &&
+                   _targets[con] == next){
+                    _incoming.push_back(con);
+                }
+            }
+        }
+
+        /* Index order is the order in which a serial step adds the forces. A predecessor may be listed twice. */
+        std::vector<uint32_t>::iterator first = _incoming.begin() + _incoming_offsets[next];
+        std::sort(first, _incoming.end());
+        _incoming.erase(std::unique(first, _incoming.end()), _incoming.end());
+    }
+    _incoming_offsets[_neuron_count] = _incoming.size();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int CompiledNetwork::bind_to_node(int node){
+    int result = SUCCESS_CODE;
+    if(CpuPlacement::bind_vector(_offsets, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_targets, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_target_networks, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_target_kinds, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_sources, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_activation, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_next_activation, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_threshold, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_was_activated, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_last_activated_step, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_last_fired_step, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_neuron_parameter, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_base_weight, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_short_weight, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_long_weight, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_long_learning_weight, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_presynaptic_potential, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_last_presynaptic_activated_step, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_last_connection_step, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_activation_type, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_activation_function, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_transmitter_type, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_connection_parameter, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_scheduled_epoch, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_frontier_bits, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_run_offsets, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_run_starts, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_run_kernels, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_incoming_offsets, node) == ERROR_CODE) result = ERROR_CODE;
+    if(CpuPlacement::bind_vector(_incoming, node) == ERROR_CODE) result = ERROR_CODE;
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::prefault(){
+    RealtimeProfile::prefault_vector(_offsets);
+    RealtimeProfile::prefault_vector(_targets);
+    RealtimeProfile::prefault_vector(_target_networks);
+    RealtimeProfile::prefault_vector(_target_kinds);
+    RealtimeProfile::prefault_vector(_sources);
+    RealtimeProfile::prefault_vector(_activation);
+    RealtimeProfile::prefault_vector(_next_activation);
+    RealtimeProfile::prefault_vector(_threshold);
+    RealtimeProfile::prefault_vector(_was_activated);
+    RealtimeProfile::prefault_vector(_last_activated_step);
+    RealtimeProfile::prefault_vector(_last_fired_step);
+    RealtimeProfile::prefault_vector(_neuron_parameter);
+    RealtimeProfile::prefault_vector(_base_weight);
+    RealtimeProfile::prefault_vector(_short_weight);
+    RealtimeProfile::prefault_vector(_long_weight);
+    RealtimeProfile::prefault_vector(_long_learning_weight);
+    RealtimeProfile::prefault_vector(_presynaptic_potential);
+    RealtimeProfile::prefault_vector(_last_presynaptic_activated_step);
+    RealtimeProfile::prefault_vector(_last_connection_step);
+    RealtimeProfile::prefault_vector(_activation_type);
+    RealtimeProfile::prefault_vector(_activation_function);
+    RealtimeProfile::prefault_vector(_transmitter_type);
+    RealtimeProfile::prefault_vector(_connection_parameter);
+    RealtimeProfile::prefault_vector(_scheduled_epoch);
+    RealtimeProfile::prefault_vector(_frontier_bits);
+    RealtimeProfile::prefault_vector(_run_offsets);
+    RealtimeProfile::prefault_vector(_run_starts);
+    RealtimeProfile::prefault_vector(_run_kernels);
+    RealtimeProfile::prefault_vector(_incoming_offsets);
+    RealtimeProfile::prefault_vector(_incoming);
+    RealtimeProfile::prefault_vector(_curr_neurons);
+    RealtimeProfile::prefault_vector(_next_neurons);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void CompiledNetwork::switch_vectors(){
+    _curr_neurons.swap(_next_neurons);
+    _next_neurons.clear();
+    _schedule_epoch++;
+}
+
+} //namespace COGNA
@@ -10,6 +10,9 @@
 
 #include "ConnectionParameterHandler.hpp"
 
+#include "HelperFunctions.hpp"
+#include "GradientEvaluator.hpp"
+
 using namespace COGNA;
 
 namespace COGNA{
@@ -56,5 +59,104 @@ namespace COGNA{
         long_learning_weight_reduction_steepness = 0.0f;
         long_learning_weight_backfall_curvature = 0.0f;
         long_learning_weight_backfall_steepness = 0.0f;
+
+        short_dehabituation_gradient = NULL;
+        short_desensitization_gradient = NULL;
+        long_dehabituation_gradient = NULL;
+        long_desensitization_gradient = NULL;
+        presynaptic_backfall_gradient = NULL;
+        long_learning_weight_reduction_gradient = NULL;
+        long_learning_weight_backfall_gradient = NULL;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    bool ConnectionParameterHandler::equals(const ConnectionParameterHandler &other) const{
+        if(activation_type != other.activation_type) return false;
+        if(activation_function != other.activation_function) return false;
+        if(learning_type != other.learning_type) return false;
+        if(transmitter_type != other.transmitter_type) return false;
+        if(initial_base_weight != other.initial_base_weight) return false;
+        if(max_weight != other.max_weight) return false;
+        if(min_weight != other.min_weight) return false;
+        if(short_habituation_curvature != other.short_habituation_curvature) return false;
+        if(short_habituation_steepness != other.short_habituation_steepness) return false;
+        if(short_sensitization_curvature != other.short_sensitization_curvature) return false;
+        if(short_sensitization_steepness != other.short_sensitization_steepness) return false;
+        if(short_dehabituation_curvature != other.short_dehabituation_curvature) return false;
+        if(short_dehabituation_steepness != other.short_dehabituation_steepness) return false;
+        if(short_desensitization_curvature != other.short_desensitization_curvature) return false;
+        if(short_desensitization_steepness != other.short_desensitization_steepness) return false;
+        if(long_habituation_curvature != other.long_habituation_curvature) return false;
+        if(long_habituation_steepness != other.long_habituation_steepness) return false;
+        if(long_sensitization_curvature != other.long_sensitization_curvature) return false;
+        if(long_sensitization_steepness != other.long_sensitization_steepness) return false;
+        if(long_dehabituation_curvature != other.long_dehabituation_curvature) return false;
+        if(long_dehabituation_steepness != other.long_dehabituation_steepness) return false;
+        if(long_desensitization_curvature != other.long_desensitization_curvature) return false;
+        if(long_desensitization_steepness != other.long_desensitization_steepness) return false;
+        if(presynaptic_potential_curvature != other.presynaptic_potential_curvature) return false;
+        if(presynaptic_potential_steepness != other.presynaptic_potential_steepness) return false;
+        if(presynaptic_backfall_curvature != other.presynaptic_backfall_curvature) return false;
+        if(presynaptic_backfall_steepness != other.presynaptic_backfall_steepness) return false;
+        if(long_learning_weight_reduction_curvature != other.long_learning_weight_reduction_curvature) return false;
+        if(long_learning_weight_reduction_steepness != other.long_learning_weight_reduction_steepness) return false;
+        if(long_learning_weight_backfall_curvature != other.long_learning_weight_backfall_curvature) return false;
+        if(long_learning_weight_backfall_steepness != other.long_learning_weight_backfall_steepness) return false;
+        if(habituation_threshold != other.habituation_threshold) return false;
+        if(sensitization_threshold != other.sensitization_threshold) return false;
+        return true;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    size_t ConnectionParameterHandler::hash() const{
+        size_t seed = 0;
+        utils::hash_combine(seed, activation_type);
+        utils::hash_combine(seed, activation_function);
+        utils::hash_combine(seed, learning_type);
+        utils::hash_combine(seed, transmitter_type);
+        utils::hash_combine(seed, initial_base_weight);
+        utils::hash_combine(seed, max_weight);
+        utils::hash_combine(seed, min_weight);
+        utils::hash_combine(seed, short_habituation_curvature);
+        utils::hash_combine(seed, short_habituation_steepness);
+        utils::hash_combine(seed, short_sensitization_curvature);
+        utils::hash_combine(seed, short_sensitization_steepness);
+        utils::hash_combine(seed, short_dehabituation_curvature);
+        utils::hash_combine(seed, short_dehabituation_steepness);
+        utils::hash_combine(seed, short_desensitization_curvature);
+        utils::hash_combine(seed, short_desensitization_steepness);
+        utils::hash_combine(seed, long_habituation_curvature);
+        utils::hash_combine(seed, long_habituation_steepness);
+        utils::hash_combine(seed, long_sensitization_curvature);
+        utils::hash_combine(seed, long_sensitization_steepness);
+        utils::hash_combine(seed, long_dehabituation_curvature);
+        utils::hash_combine(seed, long_dehabituation_steepness);
+        utils::hash_combine(seed, long_desensitization_curvature);
+        utils::hash_combine(seed, long_desensitization_steepness);
+        utils::hash_combine(seed, presynaptic_potential_curvature);
+        utils::hash_combine(seed, presynaptic_potential_steepness);
+        utils::hash_combine(seed, presynaptic_backfall_curvature);
+        utils::hash_combine(seed, presynaptic_backfall_steepness);
+        utils::hash_combine(seed, long_learning_weight_reduction_curvature);
+        utils::hash_combine(seed, long_learning_weight_reduction_steepness);
+        utils::hash_combine(seed, long_learning_weight_backfall_curvature);
+        utils::hash_combine(seed, long_learning_weight_backfall_steepness);
+        utils::hash_combine(seed, habituation_threshold);
+        utils::hash_combine(seed, sensitization_threshold);
+        return seed;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void ConnectionParameterHandler::bind_gradients(){
+        short_dehabituation_gradient = GradientEvaluator::get(short_dehabituation_curvature);
+        short_desensitization_gradient = GradientEvaluator::get(short_desensitization_curvature);
+        long_dehabituation_gradient = GradientEvaluator::get(long_dehabituation_curvature);
+        long_desensitization_gradient = GradientEvaluator::get(long_desensitization_curvature);
+        presynaptic_backfall_gradient = GradientEvaluator::get(presynaptic_backfall_curvature);
+        long_learning_weight_reduction_gradient = GradientEvaluator::get(long_learning_weight_reduction_curvature);
+        long_learning_weight_backfall_gradient = GradientEvaluator::get(long_learning_weight_backfall_curvature);
     }
 }
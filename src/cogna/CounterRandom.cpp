@@ -0,0 +1,92 @@
+/**
+ * @file CounterRandom.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the CounterRandom class.
+ *
+ * @date 2021-07-21
+ *
+ */
+
+#include "CounterRandom.hpp"
+
+using namespace COGNA;
+
+namespace COGNA{
+    namespace{
+        const uint32_t PHILOX_M0 = 0xD2511F53;
+        const uint32_t PHILOX_M1 = 0xCD9E8D57;
+        const uint32_t PHILOX_W0 = 0x9E3779B9;     // Golden ratio
+        const uint32_t PHILOX_W1 = 0xBB67AE85;     // sqrt(3) - 1
+        const int PHILOX_ROUNDS = 10;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    CounterRandom::CounterRandom(uint64_t seed, uint32_t stream){
+        _stream = stream;
+        set_seed(seed);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void CounterRandom::set_seed(uint64_t seed){
+        _key[0] = seed & 0xFFFFFFFF;
+        _key[1] = seed >> 32;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    uint64_t CounterRandom::seed() const{
+        return ((uint64_t)_key[1] << 32) | _key[0];
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void CounterRandom::block(uint64_t counter, uint32_t index, uint32_t words[4]) const{
+        uint32_t x0 = counter & 0xFFFFFFFF;
+        uint32_t x1 = counter >> 32;
+        uint32_t x2 = index;
+        uint32_t x3 = _stream;
+        uint32_t k0 = _key[0];
+        uint32_t k1 = _key[1];
+
+        for(int round=0; round<PHILOX_ROUNDS; round++){
+            uint64_t product0 = (uint64_t)PHILOX_M0 * x0;
+            uint64_t product1 = (uint64_t)PHILOX_M1 * x2;
+            uint32_t y0 = (product1 >> 32) ^ x1 ^ k0;
+            uint32_t y1 = product1 & 0xFFFFFFFF;
+            uint32_t y2 = (product0 >> 32) ^ x3 ^ k1;
+            uint32_t y3 = product0 & 0xFFFFFFFF;
+            x0 = y0;
+            x1 = y1;
+            x2 = y2;
+            x3 = y3;
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+
+        words[0] = x0;
+        words[1] = x1;
+        words[2] = x2;
+        words[3] = x3;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    uint32_t CounterRandom::below(uint32_t bound, uint64_t counter, uint32_t index) const{
+        uint32_t words[4];
+        block(counter, index, words);
+        return ((uint64_t)words[0] * bound) >> 32;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    double CounterRandom::uniform(uint64_t counter, uint32_t index) const{
+        uint32_t words[4];
+        block(counter, index, words);
+        uint64_t bits = (((uint64_t)words[2] << 32) | words[3]) >> 11;
+        return (bits + 1) * (1.0 / 9007199254740992.0);
+    }
+
+} //namespace COGNA
@@ -0,0 +1,199 @@
+/**
+ * @file CpuPlacement.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the CpuPlacement class.
+ *
+ * @date 2021-07-20
+ *
+ */
+
+#include "CpuPlacement.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#endif
+
+#include "Constants.hpp"
+
+using namespace COGNA;
+
+namespace COGNA{
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int CpuPlacement::parse_cpu_list(const std::string &text, std::vector<int> &cpus){
+    std::stringstream text_stream(text);
+    std::string range;
+    cpus.clear();
+
+    while(std::getline(text_stream, range, ',')){
+        range.erase(0, range.find_first_not_of(" \t"));
+        range.erase(range.find_last_not_of(" \t") + 1);
+        if(range == "" || range.find_first_not_of("0123456789-") != std::string::npos){
+            return ERROR_CODE;
+        }
+
+        size_t dash = range.find('-');
+        std::string first_text = range.substr(0, dash);
+        std::string last_text = (dash == std::string::npos) ? first_text : range.substr(dash + 1);
+        if(first_text == "" || last_text == "" || last_text.find('-') != std::string::npos ||
+           first_text.size() > 6 || last_text.size() > 6){
+            return ERROR_CODE;
+        }
+
+        int first = std::stoi(first_text);
+        int last = std::stoi(last_text);
+        if(first > last){
+            return ERROR_CODE;
+        }
+        for(int cpu=first; cpu<=last; cpu++){
+            cpus.push_back(cpu);
+        }
+    }
+    if(cpus.empty()){
+        return ERROR_CODE;
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return SUCCESS_CODE;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+std::string CpuPlacement::format_cpu_list(const std::vector<int> &cpus){
+    std::stringstream text;
+    unsigned int i = 0;
+    while(i < cpus.size()){
+        unsigned int last = i;
+        while(last + 1 < cpus.size() && cpus[last + 1] == cpus[last] + 1){
+            last++;
+        }
+        text << (i > 0 ? "," : "") << cpus[i];
+        if(last > i){
+            text << "-" << cpus[last];
+        }
+        i = last + 1;
+    }
+    return text.str();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int CpuPlacement::pin_thread(std::thread::native_handle_type thread, const std::vector<int> &cpus){
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for(unsigned int i=0; i<cpus.size(); i++){
+        if(cpus[i] < 0 || cpus[i] >= CPU_SETSIZE){
+            return ERROR_CODE;
+        }
+        CPU_SET(cpus[i], &cpu_set);
+    }
+    if(cpus.empty() || pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set) != 0){
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+#else
+    (void)thread;
+    (void)cpus;
+    return ERROR_CODE;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int CpuPlacement::pin_current_thread(const std::vector<int> &cpus){
+#ifdef __linux__
+    return pin_thread(pthread_self(), cpus);
+#else
+    (void)cpus;
+    return ERROR_CODE;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int CpuPlacement::numa_node(int cpu){
+    int node = -1;
+#ifdef __linux__
+    /* The directory of a CPU contains a link named after its node */
+    std::string cpu_path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    DIR *cpu_directory = opendir(cpu_path.c_str());
+    if(cpu_directory == NULL){
+        return -1;
+    }
+    struct dirent *entry;
+    while((entry = readdir(cpu_directory)) != NULL){
+        std::string name = entry->d_name;
+        if(name.size() > 4 && name.compare(0, 4, "node") == 0 &&
+           name.find_first_not_of("0123456789", 4) == std::string::npos){
+            node = std::stoi(name.substr(4));
+            break;
+        }
+    }
+    closedir(cpu_directory);
+#else
+    (void)cpu;
+#endif
+    return node;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int CpuPlacement::isolated_cpus(std::vector<int> &cpus){
+    cpus.clear();
+    std::ifstream isolated_file("/sys/devices/system/cpu/isolated");
+    if(isolated_file.is_open() == false){
+        return ERROR_CODE;
+    }
+    std::string text;
+    std::getline(isolated_file, text);
+    if(text.find_first_not_of(" \t\r\n") == std::string::npos){
+        return SUCCESS_CODE;
+    }
+    return parse_cpu_list(text, cpus);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int CpuPlacement::bind_memory(const void *memory, size_t size, int node){
+#ifdef __linux__
+    if(node < 0){
+        return ERROR_CODE;
+    }
+    uintptr_t page_size = sysconf(_SC_PAGESIZE);
+    uintptr_t begin = ((uintptr_t)memory + page_size - 1) & ~(page_size - 1);
+    uintptr_t end = ((uintptr_t)memory + size) & ~(page_size - 1);
+    if(end <= begin){
+        return SUCCESS_CODE;
+    }
+
+    const int mask_bits = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> node_mask(node / mask_bits + 1, 0);
+    node_mask[node / mask_bits] |= 1UL << (node % mask_bits);
+    if(syscall(SYS_mbind, begin, end - begin, MPOL_PREFERRED, node_mask.data(),
+               node_mask.size() * mask_bits + 1, MPOL_MF_MOVE) != 0){
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+#else
+    (void)memory;
+    (void)size;
+    (void)node;
+    return ERROR_CODE;
+#endif
+}
+
+} //namespace COGNA
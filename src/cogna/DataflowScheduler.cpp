@@ -0,0 +1,201 @@
+/**
+ * @file DataflowScheduler.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the DataflowScheduler class.
+ *
+ * @date 2021-07-19
+ *
+ */
+
+#include "DataflowScheduler.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include "NeuralNetwork.hpp"
+
+using namespace COGNA;
+
+namespace COGNA{
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+DataflowScheduler::DataflowScheduler(const std::vector<NeuralNetwork*> &network_list, WorkerPool *pool){
+    _network_list = network_list;
+    _pool = pool;
+    _target_steps = 0;
+    _finished_networks = 0;
+    _idle_scans = 0;
+    _max_lead = 0;
+
+    _upstream.resize(_network_list.size());
+    _downstream.resize(_network_list.size());
+    _neighbours.resize(_network_list.size());
+    _slots = std::vector<NetworkSlot>(_network_list.size());
+    for(unsigned int i=0; i<_network_list.size(); i++){
+        _slots[i]._steps = 0;
+        _slots[i]._claimed = 0;
+        if(_network_list[i] == NULL){
+            continue;
+        }
+        _networks.push_back(i);
+
+        std::vector<int> target_networks = _network_list[i]->get_target_networks();
+        for(unsigned int t=0; t<target_networks.size(); t++){
+            int target = target_networks[t];
+            if(target < 0 || target >= (int)_network_list.size() || _network_list[target] == NULL){
+                continue;
+            }
+            _downstream[i].push_back(target);
+            _upstream[target].push_back(i);
+        }
+    }
+
+    for(unsigned int i=0; i<_network_list.size(); i++){
+        _neighbours[i] = _upstream[i];
+        _neighbours[i].insert(_neighbours[i].end(), _downstream[i].begin(), _downstream[i].end());
+        std::sort(_neighbours[i].begin(), _neighbours[i].end());
+        _neighbours[i].erase(std::unique(_neighbours[i].begin(), _neighbours[i].end()), _neighbours[i].end());
+    }
+
+    _groups.assign(_network_list.size(), -1);
+    _group_count = 0;
+    for(unsigned int n=0; n<_networks.size(); n++){
+        if(_groups[_networks[n]] >= 0){
+            continue;
+        }
+        std::vector<int> stack(1, _networks[n]);
+        _groups[_networks[n]] = _group_count;
+        while(stack.empty() == false){
+            int network_id = stack.back();
+            stack.pop_back();
+            for(unsigned int i=0; i<_neighbours[network_id].size(); i++){
+                int neighbour = _neighbours[network_id][i];
+                if(_groups[neighbour] < 0){
+                    _groups[neighbour] = _group_count;
+                    stack.push_back(neighbour);
+                }
+            }
+        }
+        _group_count++;
+    }
+
+    for(int worker=0; worker<_pool->worker_number(); worker++){
+        _tasks.push_back([this, worker](){ process(worker); });
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void DataflowScheduler::run(int64_t steps){
+    if(steps <= 0 || _networks.empty()){
+        return;
+    }
+    _target_steps += steps;
+    _finished_networks = 0;
+    _pool->run(_tasks);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+bool DataflowScheduler::is_ready(int network_id, int64_t steps) const{
+    const std::vector<int> &neighbours = _neighbours[network_id];
+    for(unsigned int i=0; i<neighbours.size(); i++){
+        if(_slots[neighbours[i]]._steps.load(std::memory_order_acquire) < steps){
+            return false;
+        }
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void DataflowScheduler::process(int worker){
+    uint32_t network_number = _networks.size();
+    uint32_t first = (uint64_t)network_number * worker / _pool->worker_number();
+
+    while(_finished_networks.load(std::memory_order_acquire) < network_number){
+        bool stepped = false;
+        int64_t slowest = _target_steps;
+        int64_t fastest = 0;
+
+        for(uint32_t n=0; n<network_number; n++){
+            int network_id = _networks[(first + n) % network_number];
+            NetworkSlot &slot = _slots[network_id];
+            int64_t steps = slot._steps.load(std::memory_order_acquire);
+            slowest = (steps < slowest) ? steps : slowest;
+            fastest = (steps > fastest) ? steps : fastest;
+            if(steps >= _target_steps || is_ready(network_id, steps) == false){
+                continue;
+            }
+
+            int unclaimed = 0;
+            if(slot._claimed.compare_exchange_strong(unclaimed, 1, std::memory_order_acquire) == false){
+                continue;
+            }
+
+            /* Another worker may have stepped the network between loading its steps and claiming it */
+            steps = slot._steps.load(std::memory_order_acquire);
+            if(steps < _target_steps && is_ready(network_id, steps)){
+                _network_list[network_id]->feed_forward(_network_list);
+                slot._steps.store(steps + 1, std::memory_order_release);
+                if(steps + 1 == _target_steps){
+                    _finished_networks.fetch_add(1, std::memory_order_acq_rel);
+                }
+                stepped = true;
+            }
+            slot._claimed.store(0, std::memory_order_release);
+        }
+
+        int64_t lead = fastest - slowest;
+        int64_t max_lead = _max_lead.load(std::memory_order_relaxed);
+        while(lead > max_lead && _max_lead.compare_exchange_weak(max_lead, lead, std::memory_order_relaxed) == false){
+        }
+
+        if(stepped == false){
+            _idle_scans.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::yield();
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+const std::vector<int> &DataflowScheduler::upstream_networks(int network_id) const{
+    return _upstream[network_id];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+const std::vector<int> &DataflowScheduler::downstream_networks(int network_id) const{
+    return _downstream[network_id];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int DataflowScheduler::group_count() const{
+    return _group_count;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int64_t DataflowScheduler::max_lead() const{
+    return _max_lead.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void DataflowScheduler::print_statistics() const{
+    std::cout << "[INFO] Dataflow scheduling of " << _networks.size() << " networks in " << _group_count
+              << " independent groups." << std::endl;
+    for(unsigned int n=0; n<_networks.size(); n++){
+        int network_id = _networks[n];
+        std::cout << "[INFO] NN-" << network_id << " is in group " << _groups[network_id] << " and waits for "
+                  << _neighbours[network_id].size() << " networks." << std::endl;
+    }
+    std::cout << "[INFO] Networks were up to " << max_lead() << " steps apart, workers found no ready network "
+              << _idle_scans.load() << " times." << std::endl;
+}
+
+} //namespace COGNA
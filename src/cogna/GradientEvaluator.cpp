@@ -0,0 +1,72 @@
+/**
+ * @file GradientEvaluator.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the GradientEvaluator class.
+ *
+ * @date 2021-07-09
+ *
+ */
+
+#include "GradientEvaluator.hpp"
+
+#include <cmath>
+#include <map>
+#include <mutex>
+
+using namespace COGNA;
+
+namespace COGNA{
+    GradientEvaluator::GradientEvaluator(float curvature){
+        _curvature = curvature;
+        for(int k=0; k<POWER_TABLE_SIZE; k++){
+            _powers[k] = pow((double)k, _curvature);
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    const GradientEvaluator *GradientEvaluator::get(float curvature){
+        static std::mutex s_evaluator_mutex;
+        static std::map<float, GradientEvaluator> s_evaluators;
+
+        if(std::isnan(curvature)){
+            return NULL;
+        }
+
+        std::lock_guard<std::mutex> guard(s_evaluator_mutex);
+        auto evaluator = s_evaluators.find(curvature);
+        if(evaluator == s_evaluators.end()){
+            evaluator = s_evaluators.emplace(curvature, GradientEvaluator(curvature)).first;
+        }
+        return &evaluator->second;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    float GradientEvaluator::static_gradient(const GradientEvaluator *evaluator,
+                                             float source_value,
+                                             float curve_factor,
+                                             int64_t x,
+                                             float power_factor,
+                                             int method,
+                                             float max,
+                                             float min){
+        double power;
+        if(evaluator != NULL && evaluator->_curvature == power_factor && x >= 0 && x < POWER_TABLE_SIZE){
+            power = evaluator->_powers[x];
+        }
+        else{
+            power = pow((double)x, power_factor);
+        }
+
+        float return_value = source_value + method*(curve_factor * power);
+        if(return_value < min){
+            return_value = min;
+        }
+        else if(return_value > max){
+            return_value = max;
+        }
+        return return_value;
+    }
+}
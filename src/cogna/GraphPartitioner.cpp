@@ -0,0 +1,329 @@
+/**
+ * @file GraphPartitioner.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the GraphPartitioner and PartitionMap classes.
+ *
+ * @date 2021-07-18
+ *
+ */
+
+#include "GraphPartitioner.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include "NeuralNetwork.hpp"
+#include "Neuron.hpp"
+#include "Connection.hpp"
+
+using namespace COGNA;
+
+namespace COGNA{
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+PartitionMap::PartitionMap(){
+    _shard_number = 0;
+    _cut_weight = 0.0;
+    _connection_weight = 0.0;
+    _cut_connections = 0;
+    _connections = 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int PartitionMap::shard_of(int network_id, uint32_t neuron_id) const{
+    if(network_id < 0 || network_id >= (int)_neuron_shards.size() || neuron_id >= _neuron_shards[network_id].size()){
+        return 0;
+    }
+    return _neuron_shards[network_id][neuron_id];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+float PartitionMap::imbalance() const{
+    double total = 0.0;
+    double heaviest = 0.0;
+    for(unsigned int s=0; s<_shard_weights.size(); s++){
+        total += _shard_weights[s];
+        if(_shard_weights[s] > heaviest){
+            heaviest = _shard_weights[s];
+        }
+    }
+    if(total <= 0.0){
+        return 1.0f;
+    }
+    return heaviest * _shard_weights.size() / total;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void PartitionMap::print_statistics() const{
+    for(unsigned int s=0; s<_shard_weights.size(); s++){
+        std::cout << "[INFO] Shard " << s << " has a weight of " << std::fixed << std::setprecision(1)
+                  << _shard_weights[s] << "." << std::endl;
+    }
+
+    float cut_fraction = (_connection_weight > 0.0) ? _cut_weight / _connection_weight : 0.0f;
+    std::cout << "[INFO] " << _cut_connections << " of " << _connections << " connections cross shards, "
+              << std::fixed << std::setprecision(1) << 100.0f * cut_fraction << "% of the weight. Imbalance is "
+              << std::setprecision(3) << imbalance() << "." << std::endl;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+GraphPartitioner::GraphPartitioner(const std::vector<NeuralNetwork*> &network_list){
+    _network_list = network_list;
+    _profiled_steps = 0;
+
+    _network_offsets.assign(_network_list.size() + 1, 0);
+    _fired_counts.resize(_network_list.size());
+    for(unsigned int i=0; i<_network_list.size(); i++){
+        uint32_t neuron_number = _network_list[i] ? _network_list[i]->_neurons.size() : 0;
+        _network_offsets[i+1] = _network_offsets[i] + neuron_number;
+        _fired_counts[i].assign(neuron_number, 0);
+    }
+    uint32_t vertex_number = _network_offsets[_network_list.size()];
+
+    std::vector<uint32_t> sources;
+    std::vector<uint32_t> targets;
+    _fan_out.assign(vertex_number, 0);
+    for(unsigned int i=0; i<_network_list.size(); i++){
+        if(_network_list[i] == NULL){
+            continue;
+        }
+        for(unsigned int n=0; n<_network_list[i]->_neurons.size(); n++){
+            uint32_t source = _network_offsets[i] + n;
+            const std::vector<Connection*> &connections = _network_list[i]->_neurons[n]->_connections;
+            _fan_out[source] = connections.size();
+
+            for(unsigned int c=0; c<connections.size(); c++){
+                if(connections[c]->next_neuron){
+                    Neuron *next_neuron = connections[c]->next_neuron;
+                    add_connection(sources, targets, source, next_neuron->_network_id, next_neuron->_id);
+                }
+                else if(connections[c]->next_connection){
+                    Neuron *next_source = connections[c]->next_connection->prev_neuron;
+                    add_connection(sources, targets, source, next_source->_network_id, next_source->_id);
+                }
+            }
+        }
+    }
+
+    /* Every connection is a neighbour of both of its ends */
+    _offsets.assign(vertex_number + 1, 0);
+    for(unsigned int e=0; e<sources.size(); e++){
+        _offsets[sources[e] + 1]++;
+        _offsets[targets[e] + 1]++;
+    }
+    for(uint32_t v=0; v<vertex_number; v++){
+        _offsets[v+1] += _offsets[v];
+    }
+
+    std::vector<uint32_t> fill(_offsets.begin(), _offsets.end() - 1);
+    _neighbours.resize(2 * sources.size());
+    _sources.resize(2 * sources.size());
+    for(unsigned int e=0; e<sources.size(); e++){
+        _neighbours[fill[sources[e]]] = targets[e];
+        _sources[fill[sources[e]]++] = sources[e];
+        _neighbours[fill[targets[e]]] = sources[e];
+        _sources[fill[targets[e]]++] = sources[e];
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void GraphPartitioner::add_connection(std::vector<uint32_t> &sources, std::vector<uint32_t> &targets,
+                                      uint32_t source, int target_network_id, uint32_t target_id){
+    if(target_network_id < 0 || target_network_id >= (int)_network_list.size() ||
+       _network_list[target_network_id] == NULL){
+        return;
+    }
+
+    uint32_t target = _network_offsets[target_network_id] + target_id;
+    if(target >= _network_offsets[target_network_id + 1] || target == source){
+        return;
+    }
+    sources.push_back(source);
+    targets.push_back(target);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void GraphPartitioner::profile_step(){
+    for(unsigned int i=0; i<_network_list.size(); i++){
+        if(_network_list[i]){
+            _network_list[i]->count_fired_neurons(_fired_counts[i]);
+        }
+    }
+    _profiled_steps++;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int64_t GraphPartitioner::profiled_steps() const{
+    return _profiled_steps;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+std::vector<float> GraphPartitioner::firing_rates() const{
+    std::vector<float> rates(_fan_out.size(), 1.0f);
+    if(_profiled_steps == 0){
+        return rates;
+    }
+
+    for(unsigned int i=0; i<_network_list.size(); i++){
+        for(uint32_t v=_network_offsets[i]; v<_network_offsets[i+1]; v++){
+            rates[v] = (float)_fired_counts[i][v - _network_offsets[i]] / _profiled_steps;
+            if(rates[v] < PARTITION_MIN_RATE){
+                rates[v] = PARTITION_MIN_RATE;
+            }
+        }
+    }
+    return rates;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void GraphPartitioner::propagate_labels(std::vector<uint32_t> &labels, std::vector<double> &label_weights, double capacity,
+                                        const std::vector<double> &weights, const std::vector<float> &rates) const{
+    std::vector<double> label_connection(label_weights.size(), 0.0);
+    std::vector<uint32_t> touched_labels;
+
+    for(int pass=0; pass<PARTITION_PASSES; pass++){
+        uint32_t moves = 0;
+        for(uint32_t v=0; v<labels.size(); v++){
+            uint32_t current = labels[v];
+            touched_labels.clear();
+            for(uint32_t i=_offsets[v]; i<_offsets[v+1]; i++){
+                uint32_t label = labels[_neighbours[i]];
+                if(label_connection[label] == 0.0){
+                    touched_labels.push_back(label);
+                }
+                label_connection[label] += rates[_sources[i]];
+            }
+
+            /* Only a stronger connection moves a neuron, ties go to the lighter label */
+            uint32_t best = current;
+            for(unsigned int t=0; t<touched_labels.size(); t++){
+                uint32_t label = touched_labels[t];
+                if(label == current || label_weights[label] + weights[v] > capacity ||
+                   label_connection[label] <= label_connection[current]){
+                    continue;
+                }
+                if(best == current || label_connection[label] > label_connection[best] ||
+                   (label_connection[label] == label_connection[best] && label_weights[label] < label_weights[best])){
+                    best = label;
+                }
+            }
+            for(unsigned int t=0; t<touched_labels.size(); t++){
+                label_connection[touched_labels[t]] = 0.0;
+            }
+
+            if(best != current){
+                label_weights[current] -= weights[v];
+                label_weights[best] += weights[v];
+                labels[v] = best;
+                moves++;
+            }
+        }
+        if(moves == 0){
+            break;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+PartitionMap GraphPartitioner::partition(int shard_number){
+    if(shard_number < 1){
+        shard_number = 1;
+    }
+    if(shard_number > 0xFFFF){
+        shard_number = 0xFFFF;
+    }
+
+    uint32_t vertex_number = _fan_out.size();
+    std::vector<float> rates = firing_rates();
+    std::vector<double> weights(vertex_number);
+    double total_weight = 0.0;
+    for(uint32_t v=0; v<vertex_number; v++){
+        weights[v] = 1.0 + _fan_out[v] * rates[v];
+        total_weight += weights[v];
+    }
+
+    /* Clusters stay below the average weight of a shard, so they can be packed evenly */
+    std::vector<uint32_t> clusters(vertex_number);
+    std::vector<double> cluster_weights(weights);
+    for(uint32_t v=0; v<vertex_number; v++){
+        clusters[v] = v;
+    }
+    propagate_labels(clusters, cluster_weights, total_weight / shard_number, weights, rates);
+
+    std::vector<uint32_t> packing_order;
+    for(uint32_t v=0; v<vertex_number; v++){
+        if(cluster_weights[v] > 0.0){
+            packing_order.push_back(v);
+        }
+    }
+    std::stable_sort(packing_order.begin(), packing_order.end(), [&cluster_weights](uint32_t a, uint32_t b){
+        return cluster_weights[a] > cluster_weights[b];
+    });
+
+    std::vector<double> loads(shard_number, 0.0);
+    std::vector<uint32_t> cluster_shards(vertex_number, 0);
+    for(unsigned int i=0; i<packing_order.size(); i++){
+        int lightest = 0;
+        for(int s=1; s<shard_number; s++){
+            if(loads[s] < loads[lightest]){
+                lightest = s;
+            }
+        }
+        cluster_shards[packing_order[i]] = lightest;
+        loads[lightest] += cluster_weights[packing_order[i]];
+    }
+
+    std::vector<uint32_t> shards(vertex_number);
+    for(uint32_t v=0; v<vertex_number; v++){
+        shards[v] = cluster_shards[clusters[v]];
+    }
+    propagate_labels(shards, loads, (1.0 + PARTITION_IMBALANCE) * total_weight / shard_number, weights, rates);
+
+    PartitionMap partition_map;
+    partition_map._shard_number = shard_number;
+    partition_map._shard_weights = loads;
+    partition_map._neuron_shards.resize(_network_list.size());
+    partition_map._network_shards.assign(_network_list.size(), -1);
+    for(unsigned int i=0; i<_network_list.size(); i++){
+        std::vector<double> network_loads(shard_number, 0.0);
+        for(uint32_t v=_network_offsets[i]; v<_network_offsets[i+1]; v++){
+            partition_map._neuron_shards[i].push_back(shards[v]);
+            network_loads[shards[v]] += weights[v];
+        }
+        for(int s=0; s<shard_number && _network_offsets[i+1] > _network_offsets[i]; s++){
+            if(partition_map._network_shards[i] < 0 || network_loads[s] > network_loads[partition_map._network_shards[i]]){
+                partition_map._network_shards[i] = s;
+            }
+        }
+    }
+
+    /* Every connection is counted at its source */
+    for(uint32_t v=0; v<vertex_number; v++){
+        for(uint32_t i=_offsets[v]; i<_offsets[v+1]; i++){
+            if(_sources[i] != v){
+                continue;
+            }
+            partition_map._connections++;
+            partition_map._connection_weight += rates[v];
+            if(shards[_neighbours[i]] != shards[v]){
+                partition_map._cut_connections++;
+                partition_map._cut_weight += rates[v];
+            }
+        }
+    }
+    return partition_map;
+}
+
+} //namespace COGNA
@@ -49,8 +49,29 @@ namespace COGNA{
                                                 int method,
                                                 float max,
                                                 float min){
-        float return_value = source_value + method*(source_value * curve_factor *
-                             pow((x), power_factor));
+        return apply_dynamic_gradient(source_value, curve_factor, pow((x), power_factor), method, max, min);
+    }
+
+    /***********************************************************
+     * MathUtils::apply_dynamic_gradient()
+     *
+     * Description: Calculates a gradient curve like calculate_dynamic_gradient with
+     *              an already calculated power of x
+     *
+     * Parameters:  float   source_value    the value to be changed
+     *              float   curve_factor    the steepness of the gradient
+     *              double  power           x raised to the curvature of the gradient
+     *              int     method          ADD or SUBTRACT - indicates in what direction the gradient goes
+     *
+     * Return:      float  the function value of the gradient to the value time/x
+     */
+    float MathUtils::apply_dynamic_gradient(float source_value,
+                                            float curve_factor,
+                                            double power,
+                                            int method,
+                                            float max,
+                                            float min){
+        float return_value = source_value + method*(source_value * curve_factor * power);
 
         if(return_value < min){
             return_value = min;
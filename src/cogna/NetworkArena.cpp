@@ -0,0 +1,144 @@
+/**
+ * @file NetworkArena.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the NetworkArena class.
+ *
+ * @date 2021-07-13
+ *
+ */
+
+#include "NetworkArena.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <sys/mman.h>
+
+#include "Constants.hpp"
+#include "CpuPlacement.hpp"
+#include "RealtimeProfile.hpp"
+
+using namespace COGNA;
+
+namespace COGNA{
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+NetworkArena::NetworkArena(){
+    _current = NULL;
+    _remaining = 0;
+    _next_chunk_size = ARENA_MIN_CHUNK_SIZE;
+    _allocated_bytes = 0;
+    _huge_pages = false;
+    _numa_node = -1;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+NetworkArena::~NetworkArena(){
+    for(unsigned int i=0; i<_chunks.size(); i++){
+        free(_chunks[i]);
+    }
+    _chunks.clear();
+    _chunk_sizes.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NetworkArena::set_huge_pages(bool huge_pages){
+    if(huge_pages && _huge_pages == false){
+        /* Objects created from now on should not end up in the rest of a small chunk */
+        _remaining = 0;
+    }
+    _huge_pages = huge_pages;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int NetworkArena::bind_to_node(int node){
+    _numa_node = node;
+    int result = SUCCESS_CODE;
+    for(unsigned int i=0; i<_chunks.size(); i++){
+        if(CpuPlacement::bind_memory(_chunks[i], _chunk_sizes[i], node) == ERROR_CODE){
+            result = ERROR_CODE;
+        }
+    }
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int NetworkArena::numa_node() const{
+    return _numa_node;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NetworkArena::prefault(){
+    for(unsigned int i=0; i<_chunks.size(); i++){
+        RealtimeProfile::prefault_memory(_chunks[i], _chunk_sizes[i]);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NetworkArena::add_chunk(size_t min_size){
+    size_t chunk_size = _huge_pages ? ARENA_MAX_CHUNK_SIZE : _next_chunk_size;
+    while(chunk_size < min_size){
+        chunk_size *= 2;
+    }
+
+    void *chunk = NULL;
+    size_t alignment = _huge_pages ? ARENA_MAX_CHUNK_SIZE : alignof(std::max_align_t);
+    if(posix_memalign(&chunk, alignment, chunk_size) != 0){
+        throw std::bad_alloc();
+    }
+#ifdef MADV_HUGEPAGE
+    if(_huge_pages){
+        madvise(chunk, chunk_size, MADV_HUGEPAGE);
+    }
+#endif
+
+    /* Binding before the first write places the pages on the node without moving them */
+    if(_numa_node >= 0){
+        CpuPlacement::bind_memory(chunk, chunk_size, _numa_node);
+    }
+
+    _chunks.push_back(chunk);
+    _chunk_sizes.push_back(chunk_size);
+    _current = (char*)chunk;
+    _remaining = chunk_size;
+    if(_next_chunk_size < ARENA_MAX_CHUNK_SIZE){
+        _next_chunk_size *= 2;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void *NetworkArena::allocate(size_t size, size_t alignment){
+    size_t padding = (alignment - ((uintptr_t)_current & (alignment - 1))) & (alignment - 1);
+    if(_current == NULL || padding + size > _remaining){
+        add_chunk(size + alignment);
+        padding = (alignment - ((uintptr_t)_current & (alignment - 1))) & (alignment - 1);
+    }
+
+    void *memory = _current + padding;
+    _current += padding + size;
+    _remaining -= padding + size;
+    _allocated_bytes += size;
+    return memory;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+size_t NetworkArena::allocated_bytes() const{
+    return _allocated_bytes;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+size_t NetworkArena::chunk_count() const{
+    return _chunks.size();
+}
+
+} //namespace COGNA
@@ -0,0 +1,62 @@
+/**
+ * @file NetworkInbox.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the NetworkInbox class.
+ *
+ * @date 2021-07-14
+ *
+ */
+
+#include "NetworkInbox.hpp"
+
+#include <cassert>
+
+using namespace COGNA;
+
+namespace COGNA{
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+NetworkInbox::NetworkInbox(){
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NetworkInbox::reserve(int source_network_id, size_t deliveries){
+    if(_buffers.size() < 2 * (size_t)(source_network_id + 1)){
+        _buffers.resize(2 * (source_network_id + 1));
+    }
+    _buffers[2 * source_network_id].reserve(deliveries);
+    _buffers[2 * source_network_id + 1].reserve(deliveries);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NetworkInbox::push(int source_network_id, const NetworkDelivery &delivery){
+    /* Several senders push at the same time, so the buffers of a sender must not be created here */
+    assert(_buffers.size() >= 2 * (size_t)(source_network_id + 1));
+    _buffers[2 * source_network_id + (delivery.step & 1)].push_back(delivery);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int NetworkInbox::source_count() const{
+    return _buffers.size() / 2;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+const std::vector<NetworkDelivery> &NetworkInbox::deliveries(int source_network_id, int64_t network_step) const{
+    return _buffers[2 * source_network_id + (network_step & 1)];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NetworkInbox::clear(int64_t network_step){
+    for(unsigned int i=(network_step & 1); i<_buffers.size(); i+=2){
+        _buffers[i].clear();
+    }
+}
+
+} //namespace COGNA
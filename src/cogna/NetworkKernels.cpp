@@ -0,0 +1,422 @@
+/**
+ * @file NetworkKernels.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the shared neuron and connection update rules.
+ *
+ * @date 2021-07-05
+ *
+ */
+
+#include "NetworkKernels.hpp"
+
+#include <cstdio>
+
+#include "MathUtils.hpp"
+#include "GradientEvaluator.hpp"
+#include "Constants.hpp"
+#include "Trace.hpp"
+#include "NeuronParameterHandler.hpp"
+#include "ConnectionParameterHandler.hpp"
+
+using namespace COGNA;
+
+namespace COGNA{
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void NetworkKernels::long_learning_weight_backfall(ConnectionStateRef &state,
+                                                       const ConnectionParameterHandler *parameter,
+                                                       int64_t network_step,
+                                                       int debug_id){
+        if(Trace::enabled(TRACE_LONG_LEARNING_WEIGHT))
+            Trace::record(TRACE_LONG_LEARNING_WEIGHT, TRACE_EVENT_LONG_LEARNING_WEIGHT, TRACE_BEFORE,
+                          network_step, debug_id, -1, state.long_learning_weight);
+
+        state.long_learning_weight =  GradientEvaluator::static_gradient(parameter->long_learning_weight_backfall_gradient,
+                                                              state.long_learning_weight,
+                                                              parameter->long_learning_weight_backfall_steepness,
+                                                              network_step - state.last_activated_step,
+                                                              parameter->long_learning_weight_backfall_curvature,
+                                                              ADD,
+                                                              MAX_LONG_LEARNING_WEIGHT,
+                                                              MIN_LONG_LEARNING_WEIGHT);
+
+        if(Trace::enabled(TRACE_LONG_LEARNING_WEIGHT))
+            Trace::record(TRACE_LONG_LEARNING_WEIGHT, TRACE_EVENT_LONG_LEARNING_WEIGHT, TRACE_AFTER,
+                          network_step, debug_id, -1, state.long_learning_weight);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void NetworkKernels::long_learning_weight_reduction(ConnectionStateRef &state,
+                                                        const ConnectionParameterHandler *parameter,
+                                                        int64_t network_step,
+                                                        int debug_id){
+        if(Trace::enabled(TRACE_LONG_LEARNING_WEIGHT))
+            Trace::record(TRACE_LONG_LEARNING_WEIGHT, TRACE_EVENT_LONG_LEARNING_WEIGHT, TRACE_BEFORE,
+                          network_step, debug_id, -1, state.long_learning_weight);
+
+        state.long_learning_weight =  GradientEvaluator::static_gradient(parameter->long_learning_weight_reduction_gradient,
+                                                              state.long_learning_weight,
+                                                              parameter->long_learning_weight_reduction_steepness,
+                                                              1,
+                                                              parameter->long_learning_weight_reduction_curvature,
+                                                              SUBTRACT,
+                                                              MAX_LONG_LEARNING_WEIGHT,
+                                                              MIN_LONG_LEARNING_WEIGHT);
+        if(Trace::enabled(TRACE_LONG_LEARNING_WEIGHT))
+            Trace::record(TRACE_LONG_LEARNING_WEIGHT, TRACE_EVENT_LONG_LEARNING_WEIGHT, TRACE_AFTER,
+                          network_step, debug_id, -1, state.long_learning_weight);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void NetworkKernels::habituate(ConnectionStateRef &state,
+                                   const ConnectionParameterHandler *parameter,
+                                   float activation,
+                                   int conditioning_type,
+                                   int64_t network_step,
+                                   int debug_id){
+        if((conditioning_type == NONDIRECTIONAL && activation < parameter->habituation_threshold) ||
+           (conditioning_type == INHIBITORY)){
+            if(Trace::enabled(TRACE_HABITUATION)){
+                Trace::record(TRACE_HABITUATION, TRACE_EVENT_SHORT_WEIGHT, TRACE_BEFORE,
+                              network_step, debug_id, -1, state.short_weight);
+                Trace::record(TRACE_HABITUATION, TRACE_EVENT_LONG_WEIGHT, TRACE_BEFORE,
+                              network_step, debug_id, -1, state.long_weight);
+            }
+            if(Trace::enabled(TRACE_LONG_LEARNING_WEIGHT))
+                Trace::record(TRACE_LONG_LEARNING_WEIGHT, TRACE_EVENT_LONG_LEARNING_WEIGHT, TRACE_BEFORE,
+                              network_step, debug_id, -1, state.long_learning_weight);
+
+            if(conditioning_type == NONDIRECTIONAL)
+                activation = parameter->habituation_threshold - activation;
+
+            state.short_weight =  MathUtils::calculate_dynamic_gradient(state.short_weight,
+                                                   parameter->short_habituation_steepness,
+                                                   activation,
+                                                   parameter->short_habituation_curvature,
+                                                   SUBTRACT,
+                                                   parameter->max_weight,
+                                                   parameter->min_weight);
+
+            state.long_weight =  MathUtils::calculate_dynamic_gradient(state.long_weight,
+                                                  parameter->long_habituation_steepness,
+                                                  activation * state.long_learning_weight,
+                                                  parameter->long_habituation_curvature,
+                                                  SUBTRACT,
+                                                  parameter->max_weight,
+                                                  parameter->min_weight);
+
+            long_learning_weight_reduction(state, parameter, network_step, debug_id);
+
+            if(Trace::enabled(TRACE_HABITUATION)){
+                Trace::record(TRACE_HABITUATION, TRACE_EVENT_SHORT_WEIGHT, TRACE_AFTER,
+                              network_step, debug_id, -1, state.short_weight);
+                Trace::record(TRACE_HABITUATION, TRACE_EVENT_LONG_WEIGHT, TRACE_AFTER,
+                              network_step, debug_id, -1, state.long_weight);
+            }
+            if(Trace::enabled(TRACE_LONG_LEARNING_WEIGHT))
+                Trace::record(TRACE_LONG_LEARNING_WEIGHT, TRACE_EVENT_LONG_LEARNING_WEIGHT, TRACE_AFTER,
+                              network_step, debug_id, -1, state.long_learning_weight);
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void NetworkKernels::sensitize(ConnectionStateRef &state,
+                                   const ConnectionParameterHandler *parameter,
+                                   float activation,
+                                   int conditioning_type,
+                                   int64_t network_step,
+                                   int debug_id){
+        if((conditioning_type == NONDIRECTIONAL && activation > parameter->sensitization_threshold) ||
+           (conditioning_type == EXCITATORY)){
+            if(Trace::enabled(TRACE_SENSITIZATION)){
+                Trace::record(TRACE_SENSITIZATION, TRACE_EVENT_SHORT_WEIGHT, TRACE_BEFORE,
+                              network_step, debug_id, -1, state.short_weight);
+                Trace::record(TRACE_SENSITIZATION, TRACE_EVENT_LONG_WEIGHT, TRACE_BEFORE,
+                              network_step, debug_id, -1, state.long_weight);
+            }
+            if(Trace::enabled(TRACE_LONG_LEARNING_WEIGHT))
+                Trace::record(TRACE_LONG_LEARNING_WEIGHT, TRACE_EVENT_LONG_LEARNING_WEIGHT, TRACE_BEFORE,
+                              network_step, debug_id, -1, state.long_learning_weight);
+
+            if(conditioning_type == NONDIRECTIONAL)
+                activation = activation - parameter->sensitization_threshold;
+
+            state.short_weight =  MathUtils::calculate_dynamic_gradient(state.short_weight,
+                                                   parameter->short_sensitization_steepness,
+                                                   activation,
+                                                   parameter->short_sensitization_curvature,
+                                                   ADD,
+                                                   parameter->max_weight,
+                                                   parameter->min_weight);
+
+            state.long_weight =  MathUtils::calculate_dynamic_gradient(state.long_weight,
+                                                  parameter->long_sensitization_steepness,
+                                                  activation * state.long_learning_weight,
+                                                  parameter->long_sensitization_curvature,
+                                                  ADD,
+                                                  parameter->max_weight,
+                                                  parameter->min_weight);
+
+            long_learning_weight_reduction(state, parameter, network_step, debug_id);
+
+            if(Trace::enabled(TRACE_SENSITIZATION)){
+                Trace::record(TRACE_SENSITIZATION, TRACE_EVENT_SHORT_WEIGHT, TRACE_AFTER,
+                              network_step, debug_id, -1, state.short_weight);
+                Trace::record(TRACE_SENSITIZATION, TRACE_EVENT_LONG_WEIGHT, TRACE_AFTER,
+                              network_step, debug_id, -1, state.long_weight);
+            }
+            if(Trace::enabled(TRACE_LONG_LEARNING_WEIGHT))
+                Trace::record(TRACE_LONG_LEARNING_WEIGHT, TRACE_EVENT_LONG_LEARNING_WEIGHT, TRACE_AFTER,
+                              network_step, debug_id, -1, state.long_learning_weight);
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void NetworkKernels::dehabituate(ConnectionStateRef &state,
+                                     const ConnectionParameterHandler *parameter,
+                                     int64_t network_step,
+                                     int debug_id){
+        if(Trace::enabled(TRACE_HABITUATION)){
+            Trace::record(TRACE_HABITUATION, TRACE_EVENT_SHORT_WEIGHT, TRACE_BEFORE,
+                          network_step, debug_id, -1, state.short_weight);
+            Trace::record(TRACE_HABITUATION, TRACE_EVENT_LONG_WEIGHT, TRACE_BEFORE,
+                          network_step, debug_id, -1, state.long_weight);
+        }
+
+        if(state.long_weight < state.base_weight){
+           state.long_weight =  GradientEvaluator::static_gradient(parameter->long_dehabituation_gradient,
+                                                        state.long_weight,
+                                                        parameter->long_dehabituation_steepness,
+                                                        network_step - state.last_activated_step,
+                                                        parameter->long_dehabituation_curvature,
+                                                        ADD,
+                                                        state.base_weight,
+                                                        parameter->min_weight);
+        }
+
+        if(state.short_weight < state.long_weight){
+           state.short_weight =  GradientEvaluator::static_gradient(parameter->short_dehabituation_gradient,
+                                                         state.short_weight,
+                                                         parameter->short_dehabituation_steepness,
+                                                         network_step - state.last_activated_step,
+                                                         parameter->short_dehabituation_curvature,
+                                                         ADD,
+                                                         state.long_weight,
+                                                         parameter->min_weight);
+        }
+
+        if(Trace::enabled(TRACE_HABITUATION)){
+            Trace::record(TRACE_HABITUATION, TRACE_EVENT_SHORT_WEIGHT, TRACE_AFTER,
+                          network_step, debug_id, -1, state.short_weight);
+            Trace::record(TRACE_HABITUATION, TRACE_EVENT_LONG_WEIGHT, TRACE_AFTER,
+                          network_step, debug_id, -1, state.long_weight);
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void NetworkKernels::desensitize(ConnectionStateRef &state,
+                                     const ConnectionParameterHandler *parameter,
+                                     int64_t network_step,
+                                     int debug_id){
+        if(Trace::enabled(TRACE_SENSITIZATION)){
+            Trace::record(TRACE_SENSITIZATION, TRACE_EVENT_SHORT_WEIGHT, TRACE_BEFORE,
+                          network_step, debug_id, -1, state.short_weight);
+            Trace::record(TRACE_SENSITIZATION, TRACE_EVENT_LONG_WEIGHT, TRACE_BEFORE,
+                          network_step, debug_id, -1, state.long_weight);
+        }
+
+        if(state.long_weight > state.base_weight){
+            state.long_weight =  GradientEvaluator::static_gradient(parameter->long_desensitization_gradient,
+                                                         state.long_weight,
+                                                         parameter->long_desensitization_steepness,
+                                                         network_step - state.last_activated_step,
+                                                         parameter->long_desensitization_curvature,
+                                                         SUBTRACT,
+                                                         parameter->max_weight,
+                                                         state.base_weight);
+        }
+
+        if(state.short_weight > state.long_weight){
+            state.short_weight =  GradientEvaluator::static_gradient(parameter->short_desensitization_gradient,
+                                                          state.short_weight,
+                                                          parameter->short_desensitization_steepness,
+                                                          network_step - state.last_activated_step,
+                                                          parameter->short_desensitization_curvature,
+                                                          SUBTRACT,
+                                                          parameter->max_weight,
+                                                          state.long_weight);
+        }
+
+        if(Trace::enabled(TRACE_SENSITIZATION)){
+            Trace::record(TRACE_SENSITIZATION, TRACE_EVENT_SHORT_WEIGHT, TRACE_AFTER,
+                          network_step, debug_id, -1, state.short_weight);
+            Trace::record(TRACE_SENSITIZATION, TRACE_EVENT_LONG_WEIGHT, TRACE_AFTER,
+                          network_step, debug_id, -1, state.long_weight);
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void NetworkKernels::basic_learning(ConnectionStateRef &state,
+                                        const ConnectionParameterHandler *parameter,
+                                        float activation,
+                                        int conditioning_type,
+                                        int64_t network_step,
+                                        int debug_id){
+        typed_learning<KERNEL_ANY_TYPE>(state, parameter, activation, conditioning_type, network_step, debug_id);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    template<int LEARNING_TYPE>
+    void NetworkKernels::typed_learning(ConnectionStateRef &state,
+                                        const ConnectionParameterHandler *parameter,
+                                        float activation,
+                                        int conditioning_type,
+                                        int64_t network_step,
+                                        int debug_id){
+        const int learning_type = (LEARNING_TYPE == KERNEL_ANY_TYPE) ? parameter->learning_type : LEARNING_TYPE;
+
+        long_learning_weight_backfall(state, parameter, network_step, debug_id);
+
+        if(learning_type == LEARNING_HABITUATION ||
+           learning_type == LEARNING_HABISENS){
+            dehabituate(state, parameter, network_step, debug_id);
+            habituate(state, parameter, activation, conditioning_type, network_step, debug_id);
+        }
+
+        if(learning_type == LEARNING_SENSITIZATION ||
+           learning_type == LEARNING_HABISENS){
+             desensitize(state, parameter, network_step, debug_id);
+             sensitize(state, parameter, activation, conditioning_type, network_step, debug_id);
+        }
+
+        state.last_activated_step = network_step;
+    }
+
+    template void NetworkKernels::typed_learning<KERNEL_ANY_TYPE>(ConnectionStateRef&, const ConnectionParameterHandler*,
+                                                                  float, int, int64_t, int);
+    template void NetworkKernels::typed_learning<LEARNING_NONE>(ConnectionStateRef&, const ConnectionParameterHandler*,
+                                                                float, int, int64_t, int);
+    template void NetworkKernels::typed_learning<LEARNING_HABITUATION>(ConnectionStateRef&,
+                                                                       const ConnectionParameterHandler*,
+                                                                       float, int, int64_t, int);
+    template void NetworkKernels::typed_learning<LEARNING_SENSITIZATION>(ConnectionStateRef&,
+                                                                         const ConnectionParameterHandler*,
+                                                                         float, int, int64_t, int);
+    template void NetworkKernels::typed_learning<LEARNING_HABISENS>(ConnectionStateRef&, const ConnectionParameterHandler*,
+                                                                    float, int, int64_t, int);
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void NetworkKernels::presynaptic_potential_backfall(ConnectionStateRef &state,
+                                                        const ConnectionParameterHandler *parameter,
+                                                        int64_t network_step,
+                                                        int debug_id){
+        if(Trace::enabled(TRACE_PRESYNAPTIC))
+            Trace::record(TRACE_PRESYNAPTIC, TRACE_EVENT_PRESYNAPTIC_POTENTIAL, TRACE_BEFORE,
+                          network_step, debug_id, -1, state.presynaptic_potential);
+
+        state.presynaptic_potential =  GradientEvaluator::static_gradient(parameter->presynaptic_backfall_gradient,
+                                                         state.presynaptic_potential,
+                                                         parameter->presynaptic_backfall_steepness,
+                                                         network_step - state.last_presynaptic_activated_step,
+                                                         parameter->presynaptic_backfall_curvature,
+                                                         SUBTRACT,
+                                                         parameter->max_weight,
+                                                         DEFAULT_PRESYNAPTIC_POTENTIAL);
+
+        if(Trace::enabled(TRACE_PRESYNAPTIC))
+            Trace::record(TRACE_PRESYNAPTIC, TRACE_EVENT_PRESYNAPTIC_POTENTIAL, TRACE_AFTER,
+                          network_step, debug_id, -1, state.presynaptic_potential);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    float NetworkKernels::activation_function(int activation_function, float input, int debug_id){
+        return typed_activation_function<KERNEL_ANY_TYPE>(activation_function, input, debug_id);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    template<int FUNCTION>
+    float NetworkKernels::typed_activation_function(int activation_function, float input, int debug_id){
+        switch((FUNCTION == KERNEL_ANY_TYPE) ? activation_function : FUNCTION){
+          case FUNCTION_SIGMOID:
+              return MathUtils::sigmoid(input);
+              break;
+
+          case FUNCTION_LINEAR:
+              return MathUtils::linear(input);
+              break;
+
+          case FUNCTION_RELU:
+              return MathUtils::relu(input);
+              break;
+
+          default:
+              printf("[WARNING] Invalid activation function for connection of N-%d\n",
+                     debug_id);
+              return 0.0f;
+              break;
+        }
+    }
+
+    template float NetworkKernels::typed_activation_function<KERNEL_ANY_TYPE>(int, float, int);
+    template float NetworkKernels::typed_activation_function<FUNCTION_SIGMOID>(int, float, int);
+    template float NetworkKernels::typed_activation_function<FUNCTION_LINEAR>(int, float, int);
+    template float NetworkKernels::typed_activation_function<FUNCTION_RELU>(int, float, int);
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void NetworkKernels::neuron_backfall(float &activation,
+                                         bool was_activated,
+                                         int64_t last_activated_step,
+                                         const NeuronParameterHandler *parameter,
+                                         int64_t network_step,
+                                         int debug_id){
+        if(Trace::enabled(TRACE_NEURON_BACKFALL))
+            Trace::record(TRACE_NEURON_BACKFALL, TRACE_EVENT_ACTIVATION, TRACE_BEFORE,
+                          network_step, debug_id, -1, activation);
+
+        if(was_activated == false){
+            activation =  GradientEvaluator::static_gradient(parameter->activation_backfall_gradient,
+                                                       activation,
+                                                       parameter->activation_backfall_steepness,
+                                                       network_step - last_activated_step,
+                                                       parameter->activation_backfall_curvature,
+                                                       SUBTRACT,
+                                                       parameter->max_activation,
+                                                       parameter->min_activation);
+        }
+
+        if(Trace::enabled(TRACE_NEURON_BACKFALL))
+            Trace::record(TRACE_NEURON_BACKFALL, TRACE_EVENT_ACTIVATION, TRACE_AFTER,
+                          network_step, debug_id, -1, activation);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void NetworkKernels::clear_neuron_activation(float &activation,
+                                                 const NeuronParameterHandler *parameter,
+                                                 int64_t network_step,
+                                                 int debug_id){
+        if(Trace::enabled(TRACE_NEURON_BACKFALL))
+            Trace::record(TRACE_NEURON_BACKFALL, TRACE_EVENT_ACTIVATION, TRACE_BEFORE,
+                          network_step, debug_id, -1, activation);
+
+        if(activation >= parameter->activation_threshold){
+            activation = parameter->min_activation;
+        }
+
+        if(Trace::enabled(TRACE_NEURON_BACKFALL))
+            Trace::record(TRACE_NEURON_BACKFALL, TRACE_EVENT_ACTIVATION, TRACE_AFTER,
+                          network_step, debug_id, -1, activation);
+    }
+}
@@ -0,0 +1,30 @@
+/**
+ * @file NetworkStatistics.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of NetworkStatistics class
+ *
+ * @date 2021-07-08
+ *
+ */
+
+#include "NetworkStatistics.hpp"
+
+using namespace COGNA;
+
+namespace COGNA{
+    NetworkStatistics::NetworkStatistics(){
+        _dense_frontier_threshold = 0.0f;
+        reset();
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void NetworkStatistics::reset(){
+        _sparse_steps = 0;
+        _dense_steps = 0;
+        _parallel_steps = 0;
+        _frontier_size = 0;
+        _frontier_density = 0.0f;
+    }
+}
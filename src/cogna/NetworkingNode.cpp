@@ -123,13 +123,13 @@ int NetworkingNode::role(){
 
 //----------------------------------------------------------------------------------------------------------------------
 //
-std::string NetworkingNode::channel(){
+const std::string &NetworkingNode::channel(){
     return _channel;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 //
-std::vector<Neuron*> NetworkingNode::targets(){
+const std::vector<Neuron*> &NetworkingNode::targets(){
     return _target_list;
 }
 
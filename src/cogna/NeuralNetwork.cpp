@@ -10,22 +10,23 @@
 
 #include "NeuralNetwork.hpp"
 
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
 #include <iostream>
-#include <mutex>
 #include <unistd.h>
 #include "Constants.hpp"
 #include "MathUtils.hpp"
+#include "NetworkKernels.hpp"
+#include "Trace.hpp"
 #include "LoggerStd.hpp"
 #include "json.hpp"
-#include <ctime>
 
 using namespace COGNA;
 
 namespace COGNA{
 
-int NeuralNetwork::m_cluster_state = STATE_RUNNING;
+std::atomic<int> NeuralNetwork::m_cluster_state(STATE_RUNNING);
 
 int NeuralNetwork::m_max_id = 0;
 
@@ -37,9 +38,17 @@ NeuralNetwork::NeuralNetwork(){
 
     _id = m_max_id;
     m_max_id++;
-    _is_finished = false;
+    _compiled = NULL;
+    _propagator = NULL;
+    _shared_pool = NULL;
+    _own_pool = NULL;
+    _schedule_epoch = 1;    // Neurons received into the current step are marked with the previous epoch
+    _random = CounterRandom(0, _id);
+    _random_activation_ready = false;
 
     _parameter = new NeuralNetworkParameterHandler();
+    _arena = new NetworkArena();
+    _profiles = new ParameterProfilePool(_arena);
     add_neuron(99999.0);
     _network_step_counter = 0;
     _transmitter_weights.push_back(1.0f);
@@ -49,11 +58,18 @@ NeuralNetwork::NeuralNetwork(){
 //----------------------------------------------------------------------------------------------------------------------
 //
 NeuralNetwork::~NeuralNetwork(){
-    _curr_connections.clear();
-    _next_connections.clear();
+    delete _propagator;
+    _propagator = NULL;
+    delete _own_pool;
+    _own_pool = NULL;
+    delete _compiled;
+    _compiled = NULL;
+
+    _curr_neurons.clear();
+    _next_neurons.clear();
 
     for(unsigned int i=0; i<_neurons.size(); i++){
-        delete _neurons[i];
+        _arena->destroy(_neurons[i]);
         _neurons[i] = NULL;
     }
     _neurons.clear();
@@ -64,15 +80,25 @@ NeuralNetwork::~NeuralNetwork(){
     delete _parameter;
     _parameter = NULL;
 
+    delete _profiles;
+    _profiles = NULL;
+
+    delete _arena;
+    _arena = NULL;
+
     Logger::destroy_Global();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 //
 int NeuralNetwork::add_neuron(float threshold){
-    Neuron *temp_neuron = new Neuron(_parameter, _id);
+    release_compiled_network();
 
-    temp_neuron->_parameter->activation_threshold = threshold;
+    Neuron *temp_neuron = _arena->create<Neuron>(_parameter, _profiles, _arena, _id);
+
+    NeuronParameterHandler parameter = *temp_neuron->_parameter;
+    parameter.activation_threshold = threshold;
+    temp_neuron->set_parameter(parameter);
 
     _neurons.push_back(temp_neuron);
     return SUCCESS_CODE;
@@ -109,8 +135,10 @@ int NeuralNetwork::set_neural_transmitter_influence(int neuron_id,
         if(transmitter_id >= 0 && (unsigned int)transmitter_id < _transmitter_weights.size()){
             if(influence_direction == POSITIVE_INFLUENCE ||
                influence_direction == NEGATIVE_INFLUENCE){
-                   _neurons[neuron_id]->_parameter->influenced_transmitter = transmitter_id;
-                   _neurons[neuron_id]->_parameter->transmitter_influence_direction = influence_direction;
+                   NeuronParameterHandler parameter = *_neurons[neuron_id]->_parameter;
+                   parameter.influenced_transmitter = transmitter_id;
+                   parameter.transmitter_influence_direction = influence_direction;
+                   _neurons[neuron_id]->set_parameter(parameter);
                    return SUCCESS_CODE;
             }
         }
@@ -150,6 +178,7 @@ int NeuralNetwork::set_neural_transmitter_influence(int neuron_id,
      if(neuron_id >= MIN_NEURON_ID && (unsigned int)neuron_id < _neurons.size()){
         if(chance >= 0 && chance < MAX_CHANCE){
             _neurons[neuron_id]->set_random_activation(chance, activation_value);
+            _random_activation_ready = false;
             return SUCCESS_CODE;
         }
         else{
@@ -162,6 +191,13 @@ int NeuralNetwork::set_neural_transmitter_influence(int neuron_id,
      return ERROR_CODE;
  }
 
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NeuralNetwork::set_random_seed(uint64_t seed){
+    _random.set_seed(seed);
+    _random_activation_ready = false;
+}
+
  //----------------------------------------------------------------------------------------------------------------------
  //
 Connection* NeuralNetwork::add_neuron_connection(int source_neuron, int target_neuron, float weight,
@@ -169,6 +205,8 @@ Connection* NeuralNetwork::add_neuron_connection(int source_neuron, int target_n
                                                  int function_type,
                                                  int learning_type,
                                                  int transmitter_type){
+    release_compiled_network();
+
     if(connection_type != EXCITATORY && connection_type != INHIBITORY){
         LOG_WARN("Invalid connection type for C-%d~%d.\n", source_neuron, target_neuron);
         LOG_INFO("Connection type changed to <EXCITATORY>.\n");
@@ -211,6 +249,8 @@ Connection* NeuralNetwork::add_neuron_connection(int source_neuron, Neuron *targ
                                                  int function_type,
                                                  int learning_type,
                                                  int transmitter_type){
+   release_compiled_network();
+
    if(connection_type != EXCITATORY && connection_type != INHIBITORY){
        LOG_WARN("Invalid connection type for C-%d~%d.\n", source_neuron, target_neuron->_id);
        LOG_INFO("Connection type changed to <EXCITATORY>.\n");
@@ -257,6 +297,8 @@ Connection* NeuralNetwork::add_synaptic_connection(int source_neuron,
                                                    int function_type,
                                                    int learning_type,
                                                    int transmitter_type){
+    release_compiled_network();
+
     // TODO Too many nested constructs
     if(connection_type != EXCITATORY && connection_type != INHIBITORY && connection_type != NONDIRECTIONAL){
         LOG_WARN("Invalid connection type for C-%d~C-%d.\n", source_neuron, connected_neuron_1);
@@ -313,6 +355,8 @@ Connection* NeuralNetwork::add_synaptic_connection(int source_neuron,
                                                    int function_type,
                                                    int learning_type,
                                                    int transmitter_type){
+    release_compiled_network();
+
     if(connection_type != EXCITATORY && connection_type != INHIBITORY && connection_type != NONDIRECTIONAL){
         LOG_WARN("Invalid connection type for C-%d~C-%d.\n", source_neuron, con->prev_neuron->_id);
         LOG_INFO("Connection type changed to <EXCITATORY>.\n");
@@ -347,11 +391,13 @@ Connection* NeuralNetwork::add_synaptic_connection(int source_neuron,
 //
 int NeuralNetwork::init_activation(int target_neuron, float activation){
     if(target_neuron >= MIN_NEURON_ID && (unsigned int)target_neuron < _neurons.size()){
-        _neurons[target_neuron]->_activation += activation;
+        if(_compiled){
+            _compiled->init_activation(target_neuron, activation);
+            return SUCCESS_CODE;
+        }
 
-        _curr_connections.insert(std::end(_curr_connections),
-                                 std::begin(_neurons[target_neuron]->_connections),
-                                 std::end(_neurons[target_neuron]->_connections));
+        _neurons[target_neuron]->_activation += activation;
+        _curr_neurons.push_back(_neurons[target_neuron]);
     }
     else{
         LOG_ERROR("Initializing activation in N-%d was unsuccessful. Invalid ID.\n", target_neuron);
@@ -363,6 +409,8 @@ int NeuralNetwork::init_activation(int target_neuron, float activation){
 //----------------------------------------------------------------------------------------------------------------------
 //
 int NeuralNetwork::setup_network(){
+    release_compiled_network();
+
     for(unsigned int n=MIN_NEURON_ID; n<_neurons.size(); n++){
         if(_neurons[n]->_connections.size() == 0){
             _neurons[n]->add_neuron_connection(_neurons[0], 0.0);
@@ -372,14 +420,232 @@ int NeuralNetwork::setup_network(){
             _random_neurons.push_back(_neurons[n]);
         }
     }
+    _random_activation_ready = false;
+
+    /* Scheduled neurons are unique, so the frontier only outgrows this through injected activations */
+    _curr_neurons.reserve(_neurons.size());
+    _next_neurons.reserve(_neurons.size());
 
     Neuron::s_max_id = 0;
     Connection::s_max_id = 0;
 
-    srandom(time(0));
     return SUCCESS_CODE;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+//
+int NeuralNetwork::compile_network(std::vector<NeuralNetwork*> network_list){
+    release_compiled_network();
+
+    for(unsigned int n=0; n<_neurons.size(); n++){
+        if(_neurons[n]->_id != (int)n){
+            LOG_ERROR("N-%d is stored at position %d of NN-%d. Cannot compile network.\n",
+                      _neurons[n]->_id, n, _id);
+            return ERROR_CODE;
+        }
+
+        for(unsigned int con=0; con<_neurons[n]->_connections.size(); con++){
+            Connection *connection = _neurons[n]->_connections[con];
+            int next_network_id = _id;
+            if(connection->next_neuron){
+                next_network_id = connection->next_neuron->_network_id;
+            }
+            else if(connection->next_connection){
+                next_network_id = connection->next_connection->prev_neuron->_network_id;
+            }
+            else{
+                LOG_ERROR("Connection of N-%d in NN-%d has no target. Cannot compile network.\n", n, _id);
+                return ERROR_CODE;
+            }
+
+            if(next_network_id != _id && ((unsigned int)next_network_id >= network_list.size() ||
+                                          network_list[next_network_id] == NULL)){
+                LOG_ERROR("N-%d in NN-%d is connected to unknown NN-%d. Cannot compile network.\n",
+                          n, _id, next_network_id);
+                return ERROR_CODE;
+            }
+        }
+    }
+
+    _compiled = new CompiledNetwork(this, network_list);
+    _curr_neurons.clear();
+    _next_neurons.clear();
+    reserve_deliveries(network_list);
+
+    /* Only dense steps are split or gathered */
+    if(_parameter->dense_frontier_threshold > 1.0f){
+        if(_parameter->parallel_threads > 1){
+            LOG_WARN("NN-%d sets parallel_threads, but no dense_frontier_threshold. It steps serially.\n", _id);
+        }
+        if(_parameter->gather_propagation){
+            LOG_WARN("NN-%d sets gather_propagation, but no dense_frontier_threshold. It never gathers.\n", _id);
+        }
+    }
+    return SUCCESS_CODE;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NeuralNetwork::reserve_deliveries(const std::vector<NeuralNetwork*> &network_list){
+    /* Sending into other networks may not allocate while the networks step in parallel */
+    std::vector<size_t> deliveries(network_list.size(), 0);
+    for(unsigned int n=0; n<_neurons.size(); n++){
+        for(unsigned int con=0; con<_neurons[n]->_connections.size(); con++){
+            Connection *connection = _neurons[n]->_connections[con];
+            int next_network_id = _id;
+            if(connection->next_neuron){
+                next_network_id = connection->next_neuron->_network_id;
+            }
+            else if(connection->next_connection){
+                next_network_id = connection->next_connection->prev_neuron->_network_id;
+            }
+
+            if(next_network_id != _id && (unsigned int)next_network_id < network_list.size()){
+                deliveries[next_network_id]++;
+            }
+        }
+    }
+    for(unsigned int i=0; i<deliveries.size(); i++){
+        if(deliveries[i] > 0 && network_list[i]){
+            network_list[i]->_inbox.reserve(_id, deliveries[i]);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NeuralNetwork::store_compiled_state(){
+    if(_compiled){
+        _compiled->store_state(this);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+bool NeuralNetwork::is_compiled(){
+    return _compiled != NULL;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+std::vector<int> NeuralNetwork::get_target_networks(){
+    std::vector<int> target_networks;
+    if(_compiled){
+        for(uint32_t con=0; con<_compiled->_connection_count; con++){
+            if(_compiled->_target_networks[con] != _id){
+                target_networks.push_back(_compiled->_target_networks[con]);
+            }
+        }
+    }
+    else{
+        for(unsigned int n=0; n<_neurons.size(); n++){
+            for(unsigned int con=0; con<_neurons[n]->_connections.size(); con++){
+                Connection *connection = _neurons[n]->_connections[con];
+                int next_network_id = _id;
+                if(connection->next_neuron){
+                    next_network_id = connection->next_neuron->_network_id;
+                }
+                else if(connection->next_connection){
+                    next_network_id = connection->next_connection->prev_neuron->_network_id;
+                }
+                if(next_network_id != _id){
+                    target_networks.push_back(next_network_id);
+                }
+            }
+        }
+    }
+
+    std::sort(target_networks.begin(), target_networks.end());
+    target_networks.erase(std::unique(target_networks.begin(), target_networks.end()), target_networks.end());
+    return target_networks;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NeuralNetwork::set_partition(const std::vector<uint16_t> &neuron_shards){
+    _partition = neuron_shards;
+
+    /* Restarted with the new owners on the next parallel step */
+    delete _propagator;
+    _propagator = NULL;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+const std::vector<uint16_t> &NeuralNetwork::get_partition() const{
+    return _partition;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NeuralNetwork::set_worker_pool(WorkerPool *pool){
+    _shared_pool = pool;
+
+    /* Restarted on the new pool on the next parallel step */
+    delete _propagator;
+    _propagator = NULL;
+    delete _own_pool;
+    _own_pool = NULL;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+bool NeuralNetwork::is_parallel() const{
+    return _compiled && _parameter->parallel_threads > 1 && _parameter->dense_frontier_threshold <= 1.0f;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int NeuralNetwork::bind_to_node(int node){
+    int result = _arena->bind_to_node(node);
+    if(_compiled && _compiled->bind_to_node(node) == ERROR_CODE){
+        result = ERROR_CODE;
+    }
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NeuralNetwork::prefault(){
+    _arena->prefault();
+    if(_compiled){
+        _compiled->prefault();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NeuralNetwork::count_fired_neurons(std::vector<uint32_t> &counts){
+    if(counts.size() < _neurons.size()){
+        counts.resize(_neurons.size(), 0);
+    }
+
+    for(unsigned int n=0; n<_neurons.size(); n++){
+        int64_t last_fired_step = _compiled ? _compiled->_last_fired_step[n] : _neurons[n]->_last_fired_step;
+        if(last_fired_step == _network_step_counter && _network_step_counter > 0){
+            counts[n]++;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NeuralNetwork::release_compiled_network(){
+    delete _propagator;
+    _propagator = NULL;
+
+    if(_compiled){
+        _compiled->store_state(this);
+        delete _compiled;
+        _compiled = NULL;
+
+        _schedule_epoch++;
+        for(unsigned int i=0; i<_next_neurons.size(); i++){
+            _next_neurons[i]->_scheduled_epoch = _schedule_epoch;
+        }
+    }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 //
 int64_t NeuralNetwork::get_step_count(){
@@ -402,6 +668,9 @@ Neuron* NeuralNetwork::get_neuron(int neuron_id){
 //
 bool NeuralNetwork::neuron_is_active(int neuron_id){
     if(neuron_id >= MIN_NEURON_ID && (unsigned int)neuron_id < _neurons.size()){
+        if(_compiled){
+            return _compiled->is_active(neuron_id);
+        }
         return _neurons[neuron_id]->is_active();
     }
     else{
@@ -414,6 +683,9 @@ bool NeuralNetwork::neuron_is_active(int neuron_id){
 //
 float NeuralNetwork::get_neuron_activation(int neuron_id){
     if(neuron_id >= MIN_NEURON_ID && (unsigned int)neuron_id < _neurons.size()){
+        if(_compiled){
+            return _compiled->_activation[neuron_id];
+        }
         return _neurons[neuron_id]->_activation;
     }
     else{
@@ -437,39 +709,41 @@ float NeuralNetwork::get_transmitter_weight(int transmitter_id){
 //----------------------------------------------------------------------------------------------------------------------
 //
 void NeuralNetwork::change_transmitter_weight(int transmitter_id, float new_weight){
-    if(DEBUG_MODE == true && DEB_TRANSMITTER == true)
-        printf("<%ld> T-%d -> Weight before change = %.3f\n",
-               _network_step_counter, transmitter_id, _transmitter_weights[transmitter_id]);
+    if(Trace::enabled(TRACE_TRANSMITTER))
+        Trace::record(TRACE_TRANSMITTER, TRACE_EVENT_TRANSMITTER_WEIGHT, TRACE_BEFORE,
+                      _network_step_counter, -1, transmitter_id, _transmitter_weights[transmitter_id]);
 
     _transmitter_weights[transmitter_id] = new_weight;
 
-    if(DEBUG_MODE == true && DEB_TRANSMITTER == true)
-        printf("<%ld> T-%d -> Weight after change = %.3f\n\n",
-               _network_step_counter, transmitter_id, _transmitter_weights[transmitter_id]);
+    if(Trace::enabled(TRACE_TRANSMITTER))
+        Trace::record(TRACE_TRANSMITTER, TRACE_EVENT_TRANSMITTER_WEIGHT, TRACE_AFTER,
+                      _network_step_counter, -1, transmitter_id, _transmitter_weights[transmitter_id]);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 //
-void NeuralNetwork::influence_transmitter(Neuron *n){
-    if(n->_last_fired_step < _network_step_counter){
-        if(n->_parameter->influenced_transmitter > NO_TRANSMITTER){
-            if(n->_parameter->transmitter_influence_direction == POSITIVE_INFLUENCE){
-                change_transmitter_weight(n->_parameter->influenced_transmitter,
-                                          MathUtils::calculate_dynamic_gradient(_transmitter_weights[n->_parameter->influenced_transmitter],
-                                          n->_parameter->transmitter_change_steepness,
-                                          n->_activation,
-                                          n->_parameter->transmitter_change_curvature,
+void NeuralNetwork::influence_transmitter(int64_t last_fired_step,
+                                          const NeuronParameterHandler *parameter,
+                                          float activation){
+    if(last_fired_step < _network_step_counter){
+        if(parameter->influenced_transmitter > NO_TRANSMITTER){
+            if(parameter->transmitter_influence_direction == POSITIVE_INFLUENCE){
+                change_transmitter_weight(parameter->influenced_transmitter,
+                                          MathUtils::calculate_dynamic_gradient(_transmitter_weights[parameter->influenced_transmitter],
+                                          parameter->transmitter_change_steepness,
+                                          activation,
+                                          parameter->transmitter_change_curvature,
                                           ADD,
                                           _parameter->max_transmitter_weight,
                                           _parameter->min_transmitter_weight));
             }
 
-            else if(n->_parameter->transmitter_influence_direction == NEGATIVE_INFLUENCE){
-                change_transmitter_weight(n->_parameter->influenced_transmitter,
-                                          MathUtils::calculate_dynamic_gradient(_transmitter_weights[n->_parameter->influenced_transmitter],
-                                          n->_parameter->transmitter_change_steepness,
-                                          n->_activation,
-                                          n->_parameter->transmitter_change_curvature,
+            else if(parameter->transmitter_influence_direction == NEGATIVE_INFLUENCE){
+                change_transmitter_weight(parameter->influenced_transmitter,
+                                          MathUtils::calculate_dynamic_gradient(_transmitter_weights[parameter->influenced_transmitter],
+                                          parameter->transmitter_change_steepness,
+                                          activation,
+                                          parameter->transmitter_change_curvature,
                                           SUBTRACT,
                                           _parameter->max_transmitter_weight,
                                           _parameter->min_transmitter_weight));
@@ -506,95 +780,392 @@ void NeuralNetwork::transmitter_backfall(){
 
 //----------------------------------------------------------------------------------------------------------------------
 //
-void NeuralNetwork::activate_next_entities(){
-    for(unsigned int con=0; con<_curr_connections.size(); con++){
-        if(_curr_connections[con]->prev_neuron->_activation >= _curr_connections[con]->prev_neuron->_parameter->activation_threshold){
-            _curr_connections[con]->basic_learning(_network_step_counter);
-            _curr_connections[con]->presynaptic_potential = 2.0f;
-            influence_transmitter(_curr_connections[con]->prev_neuron);
+void NeuralNetwork::activate_next_entities(const std::vector<NeuralNetwork*> &network_list){
+    for(unsigned int i=0; i<_curr_neurons.size(); i++){
+        Neuron *prev_neuron = _curr_neurons[i];
 
-            if(_curr_connections[con]->next_neuron){
-                _curr_connections[con]->activate_next_neuron(_network_step_counter, _transmitter_weights);
+        /* Activation of a neuron only changes in this phase if it fires at itself */
+        if(prev_neuron->_connections.size() == 0 || prev_neuron->is_active() == false){
+            continue;
+        }
+        influence_transmitter(prev_neuron->_last_fired_step, prev_neuron->_parameter, prev_neuron->_activation);
+
+        for(unsigned int con=0; con<prev_neuron->_connections.size(); con++){
+            Connection *connection = prev_neuron->_connections[con];
+            connection->basic_learning(_network_step_counter);
+            connection->presynaptic_potential = 2.0f;
+
+            if(connection->next_neuron && connection->next_neuron->_network_id != _id){
+                NetworkDelivery delivery = {_network_step_counter, NULL, (uint32_t)connection->next_neuron->_id, 0,
+                                            connection->neuron_force(_transmitter_weights), DELIVERY_NEURON};
+                network_list[connection->next_neuron->_network_id]->_inbox.push(_id, delivery);
+                if(Trace::enabled(TRACE_BASE))
+                    Trace::record(TRACE_BASE, TRACE_EVENT_FORCE, TRACE_NOW, _network_step_counter,
+                                  prev_neuron->_id, connection->next_neuron->_id, prev_neuron->_activation);
             }
 
-            else if(_curr_connections[con]->next_connection){
-                _curr_connections[con]->activate_next_connection(_network_step_counter);
+            else if(connection->next_neuron){
+                connection->activate_next_neuron(_network_step_counter, _transmitter_weights);
+                if(connection->next_neuron == prev_neuron && prev_neuron->is_active() == false){
+                    break;
+                }
+            }
+
+            else if(connection->next_connection && connection->next_connection->prev_neuron->_network_id != _id){
+                connection->presynaptic_potential_backfall(_network_step_counter);
+                NetworkDelivery delivery = {_network_step_counter, connection->next_connection, 0,
+                                            connection->_parameter->activation_type, prev_neuron->_activation,
+                                            DELIVERY_CONNECTION};
+                network_list[connection->next_connection->prev_neuron->_network_id]->_inbox.push(_id, delivery);
             }
 
-            _curr_connections[con]->prev_neuron->_last_fired_step = _network_step_counter;
+            else if(connection->next_connection){
+                connection->activate_next_connection(_network_step_counter);
+            }
         }
+        prev_neuron->_last_fired_step = _network_step_counter;
     }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 //
-void NeuralNetwork::save_next_neurons(std::vector<NeuralNetwork*> network_list){
-    if(network_list.size() == 0){
-        network_list.push_back(this);
-    }
-
-    if(DEBUG_MODE && _curr_connections.size() > 0)
-        printf("\n*******************NEXT STEP*******************\n\n");
+void NeuralNetwork::save_next_neurons(const std::vector<NeuralNetwork*> &network_list){
+    if(Trace::enabled(TRACE_STEP) && _curr_neurons.size() > 0)
+        Trace::record(TRACE_STEP, TRACE_EVENT_STEP, TRACE_NOW, _network_step_counter, -1, -1, _curr_neurons.size());
+
+    for(unsigned int i=0; i<_curr_neurons.size(); i++){
+        Neuron *prev_neuron = _curr_neurons[i];
+        bool is_cleared = false;
+
+        for(unsigned int con=0; con<prev_neuron->_connections.size(); con++){
+            Neuron *next_neuron = prev_neuron->_connections[con]->next_neuron;
+            if(next_neuron == NULL){
+                continue;
+            }
 
-    for(unsigned int con=0; con<_curr_connections.size(); con++){
-        if(_curr_connections[con]->next_neuron == NULL){
-            continue;
-        }
-        
-        int next_network_id = _curr_connections[con]->next_neuron->_network_id;
-        std::cout << "Prev Network: " << _curr_connections[con]->prev_neuron->_network_id
-                  << " - Prev Neuron: " << _curr_connections[con]->prev_neuron->_id
-                  << "| Next Network: " << next_network_id
-                  << " - Next Neuron: " << _curr_connections[con]->next_neuron->_id << std::endl;
+            int next_network_id = next_neuron->_network_id;
+            if(Trace::enabled(TRACE_BASE))
+                Trace::record(TRACE_BASE, TRACE_EVENT_TARGET, TRACE_NOW,
+                              _network_step_counter, prev_neuron->_id, next_neuron->_id, next_network_id);
 
-        /* Only do if neuron fired in this round */
-        _curr_connections[con]->prev_neuron->clear_neuron_activation(_network_step_counter);
+            /* Only do if neuron fired in this round. Has to be repeated if the neuron fires at itself */
+            if(is_cleared == false){
+                prev_neuron->clear_neuron_activation(_network_step_counter);
+                is_cleared = true;
+            }
+            if(next_network_id != _id){
+                continue;
+            }
 
-        if(_curr_connections[con]->next_neuron){
-            if(_curr_connections[con]->next_neuron->_was_activated == true){
-                _curr_connections[con]->next_neuron->_activation = _curr_connections[con]->next_neuron->_next_activation;
-                _curr_connections[con]->next_neuron->_next_activation = 0.0f;
+            if(next_neuron->_was_activated == true){
+                next_neuron->_activation = next_neuron->_next_activation;
+                next_neuron->_next_activation = 0.0f;
+            }
+            next_neuron->_was_activated = false;
+            if(next_neuron == prev_neuron){
+                is_cleared = false;
             }
-            _curr_connections[con]->next_neuron->_was_activated = false;
 
             /* Only do if next neuron is really activated */
-            if(_curr_connections[con]->next_neuron->_activation > 0.0f){
-                _curr_connections[con]->next_neuron->set_step(_network_step_counter);
+            if(next_neuron->_activation > 0.0f){
+                next_neuron->set_step(_network_step_counter);
 
-                int is_contained = false;
-                for(unsigned int nex=0; nex < network_list[next_network_id]->_next_connections.size(); nex++){
-                    if(_curr_connections[con]->next_neuron == network_list[next_network_id]->_next_connections[nex]->prev_neuron){
-                        is_contained = true;
-                    }
+                /* Only do if neuron is not already in the next neurons list */
+                if(next_neuron->_scheduled_epoch != _schedule_epoch){
+                    next_neuron->_scheduled_epoch = _schedule_epoch;
+                    _next_neurons.push_back(next_neuron);
                 }
+            }
+        }
+    }
+}
 
-                /* Only do if neuron is not already in the next_connections list */
-                if(is_contained == false){
-                    network_list[next_network_id]->_next_connections.insert(std::end(network_list[next_network_id]->_next_connections),
-                                                                            std::begin(_curr_connections[con]->next_neuron->_connections),
-                                                                            std::end(_curr_connections[con]->next_neuron->_connections));
-                }
+//----------------------------------------------------------------------------------------------------------------------
+//
+bool NeuralNetwork::update_frontier_statistics(){
+    unsigned int frontier_size = _curr_neurons.size();
+    unsigned int neuron_count = _neurons.size();
+    if(_compiled){
+        frontier_size = _compiled->_curr_neurons.size();
+        neuron_count = _compiled->_neuron_count;
+    }
+
+    _statistics._dense_frontier_threshold = _parameter->dense_frontier_threshold;
+    _statistics._frontier_size = frontier_size;
+    _statistics._frontier_density = 0.0f;
+    if(neuron_count > 0){
+        _statistics._frontier_density = (float)frontier_size / neuron_count;
+    }
+
+    /* The object graph is always processed sparse */
+    if(_compiled && frontier_size > 0 && _statistics._frontier_density >= _parameter->dense_frontier_threshold){
+        _statistics._dense_steps++;
+        return true;
+    }
+    _statistics._sparse_steps++;
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NeuralNetwork::activate_compiled_entities(const std::vector<NeuralNetwork*> &network_list, bool dense){
+    CompiledNetwork *cn = _compiled;
+
+    if(dense == false){
+        for(unsigned int i=0; i<cn->_curr_neurons.size(); i++){
+            activate_compiled_neuron(cn->_curr_neurons[i], network_list);
+        }
+        return;
+    }
+
+    cn->load_frontier_bits();
+    ParallelPropagator *propagator = parallel_propagator();
+    if(propagator){
+        propagator->activate(_id, _network_step_counter, _transmitter_weights, _parameter->batch_learning, network_list);
+        _statistics._parallel_steps++;
+        return;
+    }
+
+    for(uint32_t word_id=0; word_id<cn->_frontier_bits.size(); word_id++){
+        uint64_t word = cn->_frontier_bits[word_id];
+        while(word != 0){
+            uint32_t prev = (word_id << 6) + __builtin_ctzll(word);
+            word &= word - 1;
+            activate_compiled_neuron(prev, network_list);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+ParallelPropagator* NeuralNetwork::parallel_propagator(){
+    bool gather = _parameter->gather_propagation;
+    int threads = _parameter->parallel_threads < 1 ? 1 : _parameter->parallel_threads;
+    if((threads < 2 && gather == false) || Trace::enabled(TRACE_ALL)){
+        return NULL;
+    }
+
+    /* Started on the first parallel step, so the thread number and the mode can be changed after compiling */
+    WorkerPool *pool = (threads > 1) ? _shared_pool : NULL;
+    if(pool == NULL){
+        if(_own_pool == NULL || _own_pool->worker_number() != threads){
+            delete _propagator;
+            _propagator = NULL;
+            delete _own_pool;
+            _own_pool = new WorkerPool(threads);
+        }
+        pool = _own_pool;
+    }
+    if(_propagator == NULL || _propagator->pool() != pool || _propagator->is_gather() != gather){
+        delete _propagator;
+        _propagator = new ParallelPropagator(_compiled, pool, gather, _partition.empty() ? NULL : &_partition);
+    }
+    if(_propagator->is_supported() == false){
+        return NULL;
+    }
+    return _propagator;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NeuralNetwork::save_compiled_neurons(const std::vector<NeuralNetwork*> &network_list, bool dense){
+    CompiledNetwork *cn = _compiled;
+
+    if(Trace::enabled(TRACE_STEP) && cn->_curr_neurons.size() > 0)
+        Trace::record(TRACE_STEP, TRACE_EVENT_STEP, TRACE_NOW, _network_step_counter, -1, -1, cn->_curr_neurons.size());
+
+    if(dense == false){
+        for(unsigned int i=0; i<cn->_curr_neurons.size(); i++){
+            save_compiled_neuron(cn->_curr_neurons[i], network_list);
+        }
+        return;
+    }
+
+    for(uint32_t word_id=0; word_id<cn->_frontier_bits.size(); word_id++){
+        uint64_t word = cn->_frontier_bits[word_id];
+        while(word != 0){
+            uint32_t prev = (word_id << 6) + __builtin_ctzll(word);
+            word &= word - 1;
+            save_compiled_neuron(prev, network_list);
+        }
+    }
+    cn->clear_frontier_bits();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NeuralNetwork::activate_compiled_neuron(uint32_t prev, const std::vector<NeuralNetwork*> &network_list){
+    typedef bool (NeuralNetwork::*RunKernel)(uint32_t, uint32_t, uint32_t, bool, const std::vector<NeuralNetwork*>&);
+
+    /* Indexed by CompiledNetwork::kernel_id() */
+    static const RunKernel s_run_kernels[CONNECTION_KERNEL_NUMBER] = {
+        &NeuralNetwork::activate_compiled_run<KERNEL_ANY_TYPE, KERNEL_ANY_TYPE, KERNEL_ANY_TYPE>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_NEURON, FUNCTION_SIGMOID, LEARNING_NONE>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_NEURON, FUNCTION_SIGMOID, LEARNING_HABITUATION>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_NEURON, FUNCTION_SIGMOID, LEARNING_SENSITIZATION>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_NEURON, FUNCTION_SIGMOID, LEARNING_HABISENS>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_NEURON, FUNCTION_LINEAR, LEARNING_NONE>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_NEURON, FUNCTION_LINEAR, LEARNING_HABITUATION>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_NEURON, FUNCTION_LINEAR, LEARNING_SENSITIZATION>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_NEURON, FUNCTION_LINEAR, LEARNING_HABISENS>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_NEURON, FUNCTION_RELU, LEARNING_NONE>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_NEURON, FUNCTION_RELU, LEARNING_HABITUATION>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_NEURON, FUNCTION_RELU, LEARNING_SENSITIZATION>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_NEURON, FUNCTION_RELU, LEARNING_HABISENS>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_CONNECTION, KERNEL_ANY_TYPE, LEARNING_NONE>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_CONNECTION, KERNEL_ANY_TYPE, LEARNING_HABITUATION>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_CONNECTION, KERNEL_ANY_TYPE, LEARNING_SENSITIZATION>,
+        &NeuralNetwork::activate_compiled_run<EDGE_TARGET_CONNECTION, KERNEL_ANY_TYPE, LEARNING_HABISENS>
+    };
+
+    CompiledNetwork *cn = _compiled;
+
+    /* Activation of a neuron only changes in this phase if it fires at itself */
+    if(cn->_offsets[prev] == cn->_offsets[prev+1] || cn->is_active(prev) == false){
+        return;
+    }
+    influence_transmitter(cn->_last_fired_step[prev], cn->_neuron_parameter[prev], cn->_activation[prev]);
+
+    bool batched = _parameter->batch_learning && cn->_batch_learning_rows[prev];
+    if(batched){
+        cn->batch_learning(prev, _network_step_counter);
+    }
+
+    for(uint32_t run=cn->_run_offsets[prev]; run<cn->_run_offsets[prev+1]; run++){
+        RunKernel kernel = s_run_kernels[cn->_run_kernels[run]];
+        if((this->*kernel)(prev, cn->_run_starts[run], cn->_run_starts[run+1], batched == false, network_list) == false){
+            break;
+        }
+    }
+    cn->_last_fired_step[prev] = _network_step_counter;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+template<int TARGET_KIND, int FUNCTION, int LEARNING_TYPE>
+bool NeuralNetwork::activate_compiled_run(uint32_t prev,
+                                          uint32_t first_con,
+                                          uint32_t last_con,
+                                          bool learn,
+                                          const std::vector<NeuralNetwork*> &network_list){
+    CompiledNetwork *cn = _compiled;
+
+    for(uint32_t con=first_con; con<last_con; con++){
+        if(learn){
+            ConnectionStateRef state = cn->connection_state(con);
+            NetworkKernels::typed_learning<LEARNING_TYPE>(state, cn->_connection_parameter[con], cn->_activation[prev],
+                                                          NONDIRECTIONAL, _network_step_counter, prev);
+        }
+        cn->_presynaptic_potential[con] = 2.0f;
+
+        const int target_network = cn->_target_networks[con];
+        const int target_kind = (TARGET_KIND == KERNEL_ANY_TYPE) ? cn->_target_kinds[con] : TARGET_KIND;
+        if(target_kind == EDGE_TARGET_NEURON && target_network != _id){
+            NetworkDelivery delivery = {_network_step_counter, NULL, cn->_targets[con], 0,
+                                        cn->neuron_force<FUNCTION>(con, _transmitter_weights), DELIVERY_NEURON};
+            network_list[target_network]->_inbox.push(_id, delivery);
+            if(Trace::enabled(TRACE_BASE))
+                Trace::record(TRACE_BASE, TRACE_EVENT_FORCE, TRACE_NOW, _network_step_counter,
+                              prev, cn->_targets[con], cn->_activation[prev]);
+        }
+
+        else if(target_kind == EDGE_TARGET_NEURON){
+            cn->activate_next_neuron<FUNCTION>(con, cn, _network_step_counter, _transmitter_weights);
+            if(cn->_targets[con] == prev && cn->is_active(prev) == false){
+                return false;
             }
         }
+
+        else if(target_network != _id){
+            cn->presynaptic_potential_backfall(con, _network_step_counter);
+            NetworkDelivery delivery = {_network_step_counter, NULL, cn->_targets[con], cn->_activation_type[con],
+                                        cn->_activation[prev], DELIVERY_CONNECTION};
+            network_list[target_network]->_inbox.push(_id, delivery);
+        }
+
+        else{
+            cn->activate_next_connection(con, cn, _network_step_counter);
+        }
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NeuralNetwork::save_compiled_neuron(uint32_t prev, const std::vector<NeuralNetwork*> &network_list){
+    CompiledNetwork *cn = _compiled;
+    bool is_cleared = false;
+
+    for(uint32_t con=cn->_offsets[prev]; con<cn->_offsets[prev+1]; con++){
+        if(cn->_target_kinds[con] != EDGE_TARGET_NEURON){
+            continue;
+        }
+
+        uint32_t next = cn->_targets[con];
+        if(Trace::enabled(TRACE_BASE))
+            Trace::record(TRACE_BASE, TRACE_EVENT_TARGET, TRACE_NOW,
+                          _network_step_counter, prev, next, cn->_target_networks[con]);
+
+        /* Only do if neuron fired in this round. Has to be repeated if the neuron fires at itself */
+        if(is_cleared == false){
+            cn->clear_neuron_activation(prev, _network_step_counter);
+            is_cleared = true;
+        }
+        if(cn->_target_networks[con] != _id){
+            continue;
+        }
+
+        if(cn->_was_activated[next] == true){
+            cn->_activation[next] = cn->_next_activation[next];
+            cn->_next_activation[next] = 0.0f;
+        }
+        cn->_was_activated[next] = false;
+        if(next == prev){
+            is_cleared = false;
+        }
+
+        /* Only do if next neuron is really activated */
+        if(cn->_activation[next] > 0.0f){
+            cn->_last_activated_step[next] = _network_step_counter;
+
+            cn->schedule_neuron(next);
+        }
     }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 //
 void NeuralNetwork::activate_random_neurons(){
-    for(unsigned int n = 0; n < _random_neurons.size(); n++){
-        if(random()%MAX_CHANCE <= _random_neurons[n]->_parameter->random_chance){
-            init_activation(_random_neurons[n]->_id, _random_neurons[n]->_parameter->random_activation_value);
-            srandom(time(0));
+    if(_random_neurons.empty()){
+        return;
+    }
+
+    /* Drawn with the first step after the seed or the chances changed */
+    if(_random_activation_ready == false){
+        std::vector<uint32_t> neurons;
+        std::vector<int> chances;
+        for(unsigned int n = 0; n < _random_neurons.size(); n++){
+            neurons.push_back(_random_neurons[n]->_id);
+            chances.push_back(_random_neurons[n]->_parameter->random_chance);
         }
+        _random_activation.reset(neurons, chances, _random, _network_step_counter - 1);
+        _random_activation_ready = true;
+    }
+
+    /* Positions are ascending, so the neurons are activated in the order of _random_neurons */
+    _random_activation.collect(_network_step_counter, _random, _random_positions);
+    for(unsigned int i = 0; i < _random_positions.size(); i++){
+        Neuron *neuron = _random_neurons[_random_positions[i]];
+        init_activation(neuron->_id, neuron->_parameter->random_activation_value);
     }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 //
 void NeuralNetwork::switch_vectors(){
-    _curr_connections = _next_connections;
-    _next_connections.clear();
+    _curr_neurons.swap(_next_neurons);
+    _next_neurons.clear();
+    _schedule_epoch++;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -617,6 +1188,12 @@ void NeuralNetwork::store_sent_data(){
     for(unsigned int i=0; i < _extern_output_nodes.size(); i++){
         float injected_activation = 0.0f;
         for(unsigned int j=0; j < _extern_output_nodes[i]->targets().size(); j++){
+            if(_compiled){
+                int target_id = _extern_output_nodes[i]->targets()[j]->_id;
+                injected_activation += _compiled->_activation[target_id];
+                _compiled->clear_neuron_activation(target_id, _network_step_counter);
+                continue;
+            }
             injected_activation += _extern_output_nodes[i]->targets()[j]->_activation;
             _extern_output_nodes[i]->targets()[j]->clear_neuron_activation(_network_step_counter);
         }
@@ -626,49 +1203,144 @@ void NeuralNetwork::store_sent_data(){
 
 //----------------------------------------------------------------------------------------------------------------------
 //
-void NeuralNetwork::feed_forward(std::vector<NeuralNetwork*> network_list){
-    _network_step_counter += 1;
+void NeuralNetwork::receive_deliveries(){
+    /* The step all networks of the cluster finished last */
+    int64_t network_step = _network_step_counter;
+
+    for(int source=0; source<_inbox.source_count(); source++){
+        const std::vector<NetworkDelivery> &deliveries = _inbox.deliveries(source, network_step);
+        for(unsigned int i=0; i<deliveries.size(); i++){
+            receive_delivery(deliveries[i]);
+        }
+    }
 
-    transmitter_backfall();
-    activate_random_neurons();
-    activate_next_entities();
-    store_sent_data();
-    save_next_neurons(network_list);
-    switch_vectors();
+    for(int source=0; source<_inbox.source_count(); source++){
+        const std::vector<NetworkDelivery> &deliveries = _inbox.deliveries(source, network_step);
+        for(unsigned int i=0; i<deliveries.size(); i++){
+            if(deliveries[i].kind == DELIVERY_NEURON){
+                save_received_neuron(deliveries[i]);
+            }
+        }
+    }
+    _inbox.clear(network_step);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 //
+void NeuralNetwork::receive_delivery(const NetworkDelivery &delivery){
+    if(_compiled){
+        _compiled->receive_delivery(delivery);
+        return;
+    }
 
-void NeuralNetwork::listen_to_cluster(std::vector<NeuralNetwork*> network_list,
-                                      std::condition_variable *thread_halter){
-    std::mutex worker_mutex;
-    std::unique_lock<std::mutex> thread_lock(worker_mutex);
+    if(delivery.kind == DELIVERY_CONNECTION){
+        delivery.connection->receive_presynaptic_activation(delivery.step, delivery.value, delivery.activation_type);
+        return;
+    }
 
-    while(m_cluster_state != STATE_STOPPED){
-        if(m_cluster_state != STATE_PAUSE){
-            thread_halter->wait(thread_lock);
-            feed_forward(network_list);
-            _is_finished = true;
+    /* Activation the neuron already got from its own network in the same step is added to */
+    Neuron *neuron = _neurons[delivery.target];
+    if(neuron->_was_activated == false && neuron->_last_activated_step == delivery.step){
+        neuron->_next_activation = neuron->_activation;
+        neuron->_was_activated = true;
+    }
+    neuron->calculate_neuron_backfall(delivery.step);
+    neuron->_next_activation += delivery.value;
+    neuron->_was_activated = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NeuralNetwork::save_received_neuron(const NetworkDelivery &delivery){
+    if(_compiled){
+        _compiled->save_received_neuron(delivery.target, delivery.step);
+        return;
+    }
+
+    Neuron *neuron = _neurons[delivery.target];
+    if(neuron->_was_activated == true){
+        neuron->_activation = neuron->_next_activation;
+        neuron->_next_activation = 0.0f;
+    }
+    neuron->_was_activated = false;
+
+    /* Neurons of the current step were scheduled in the previous epoch */
+    if(neuron->_activation > 0.0f){
+        neuron->set_step(delivery.step);
+        if(neuron->_scheduled_epoch != _schedule_epoch - 1){
+            neuron->_scheduled_epoch = _schedule_epoch - 1;
+            _curr_neurons.push_back(neuron);
         }
     }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+//
+void NeuralNetwork::feed_forward(const std::vector<NeuralNetwork*> &network_list){
+    receive_deliveries();
+    _network_step_counter += 1;
+    if(COGNA_TRACING){
+        Trace::set_network(_id);
+    }
+
+    transmitter_backfall();
+    activate_random_neurons();
+
+    bool dense = update_frontier_statistics();
+    if(_compiled){
+        activate_compiled_entities(network_list, dense);
+        store_sent_data();
+        save_compiled_neurons(network_list, dense);
+        _compiled->switch_vectors();
+        return;
+    }
+
+    activate_next_entities(network_list);
+    store_sent_data();
+    save_next_neurons(network_list);
+    switch_vectors();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 //
 void NeuralNetwork::print_activation(){
-    if(_curr_connections.size() > 0){
-        printf("\n");
-        for(unsigned int con=0; con<_curr_connections.size(); con++){
-            if(_curr_connections[con]->next_neuron){
-                if(_curr_connections[con]->next_neuron->_id != 0){
-                    printf("*** N-%d fires at N-%d ***\n", _curr_connections[con]->prev_neuron->_id,
-                                                           _curr_connections[con]->next_neuron->_id);
+    if(_compiled){
+        CompiledNetwork *cn = _compiled;
+        if(cn->_curr_neurons.size() > 0){
+            printf("\n");
+            for(unsigned int i=0; i<cn->_curr_neurons.size(); i++){
+                uint32_t prev = cn->_curr_neurons[i];
+                for(uint32_t con=cn->_offsets[prev]; con<cn->_offsets[prev+1]; con++){
+                    if(cn->_target_kinds[con] == EDGE_TARGET_NEURON){
+                        if(cn->_targets[con] != 0){
+                            printf("*** N-%d fires at N-%d ***\n", prev, cn->_targets[con]);
+                        }
+                    }
+                    else{
+                        printf("*** N-%d fires at C-%d ***\n", prev,
+                               _neurons[prev]->_connections[con - cn->_offsets[prev]]->next_connection->prev_neuron->_id);
+                    }
                 }
             }
-            else if(_curr_connections[con]->next_connection){
-                printf("*** N-%d fires at C-%d ***\n", _curr_connections[con]->prev_neuron->_id,
-                                                       _curr_connections[con]->next_connection->prev_neuron->_id);
+            printf("\n");
+        }
+        return;
+    }
+
+    if(_curr_neurons.size() > 0){
+        printf("\n");
+        for(unsigned int i=0; i<_curr_neurons.size(); i++){
+            for(unsigned int con=0; con<_curr_neurons[i]->_connections.size(); con++){
+                Connection *connection = _curr_neurons[i]->_connections[con];
+                if(connection->next_neuron){
+                    if(connection->next_neuron->_id != 0){
+                        printf("*** N-%d fires at N-%d ***\n", _curr_neurons[i]->_id, connection->next_neuron->_id);
+                    }
+                }
+                else if(connection->next_connection){
+                    printf("*** N-%d fires at C-%d ***\n", _curr_neurons[i]->_id,
+                                                           connection->next_connection->prev_neuron->_id);
+                }
             }
         }
         printf("\n");
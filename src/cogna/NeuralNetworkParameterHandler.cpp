@@ -23,5 +23,10 @@ namespace COGNA{
 
         max_transmitter_weight = 3.0f;
         min_transmitter_weight = 0.0f;
+
+        dense_frontier_threshold = 2.0f;
+        batch_learning = false;
+        parallel_threads = 1;
+        gather_propagation = false;
     }
 }
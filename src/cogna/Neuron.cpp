@@ -14,7 +14,8 @@
 #include <cstdlib>
 #include <iostream>
 #include <ctime>
-#include "MathUtils.hpp"
+#include "NetworkKernels.hpp"
+#include "ParameterProfilePool.hpp"
 #include "LoggerStd.hpp"
 
 using namespace COGNA;
@@ -24,61 +25,68 @@ namespace COGNA{
 
     //----------------------------------------------------------------------------------------------------------------------
     //
-    Neuron::Neuron(NeuralNetworkParameterHandler *default_parameter, int network_id=0){
+    Neuron::Neuron(NeuralNetworkParameterHandler *default_parameter,
+                   ParameterProfilePool *profiles,
+                   NetworkArena *arena,
+                   int network_id=0){
         _network_id = network_id;
+        _profiles = profiles;
+        _arena = arena;
 
-        _parameter = new NeuronParameterHandler();
+        NeuronParameterHandler parameter;
 
-        _parameter->activation_type = default_parameter->activation_type;
-        _parameter->activation_function = default_parameter->activation_function;
-        _parameter->max_activation = default_parameter->max_activation;
-        _parameter->min_activation = default_parameter->min_activation;
-        _parameter->activation_backfall_curvature = default_parameter->activation_backfall_curvature;
-        _parameter->activation_backfall_steepness = default_parameter->activation_backfall_steepness;
-        _parameter->influenced_transmitter = default_parameter->influenced_transmitter;
-        _parameter->transmitter_influence_direction = default_parameter->transmitter_influence_direction;
+        parameter.activation_type = default_parameter->activation_type;
+        parameter.activation_function = default_parameter->activation_function;
+        parameter.max_activation = default_parameter->max_activation;
+        parameter.min_activation = default_parameter->min_activation;
+        parameter.activation_backfall_curvature = default_parameter->activation_backfall_curvature;
+        parameter.activation_backfall_steepness = default_parameter->activation_backfall_steepness;
+        parameter.influenced_transmitter = default_parameter->influenced_transmitter;
+        parameter.transmitter_influence_direction = default_parameter->transmitter_influence_direction;
 
-        _parameter->max_weight = default_parameter->max_weight;
-        _parameter->min_weight = default_parameter->min_weight;
+        parameter.max_weight = default_parameter->max_weight;
+        parameter.min_weight = default_parameter->min_weight;
 
-        _parameter->learning_type = default_parameter->learning_type;
-        _parameter->transmitter_type = default_parameter->transmitter_type;
+        parameter.learning_type = default_parameter->learning_type;
+        parameter.transmitter_type = default_parameter->transmitter_type;
 
-        _parameter->activation_backfall_curvature = default_parameter->activation_backfall_curvature;
-        _parameter->activation_backfall_steepness = default_parameter->activation_backfall_steepness;
+        parameter.activation_backfall_curvature = default_parameter->activation_backfall_curvature;
+        parameter.activation_backfall_steepness = default_parameter->activation_backfall_steepness;
 
-        _parameter->short_habituation_curvature = default_parameter->short_habituation_curvature;
-        _parameter->short_habituation_steepness = default_parameter->short_habituation_steepness;
-        _parameter->short_sensitization_curvature = default_parameter->short_sensitization_curvature;
-        _parameter->short_sensitization_steepness = default_parameter->short_sensitization_steepness;
+        parameter.short_habituation_curvature = default_parameter->short_habituation_curvature;
+        parameter.short_habituation_steepness = default_parameter->short_habituation_steepness;
+        parameter.short_sensitization_curvature = default_parameter->short_sensitization_curvature;
+        parameter.short_sensitization_steepness = default_parameter->short_sensitization_steepness;
 
-        _parameter->short_dehabituation_curvature = default_parameter->short_dehabituation_curvature;
-        _parameter->short_dehabituation_steepness = default_parameter->short_dehabituation_steepness;
-        _parameter->short_desensitization_curvature = default_parameter->short_desensitization_curvature;
-        _parameter->short_desensitization_steepness = default_parameter->short_desensitization_steepness;
+        parameter.short_dehabituation_curvature = default_parameter->short_dehabituation_curvature;
+        parameter.short_dehabituation_steepness = default_parameter->short_dehabituation_steepness;
+        parameter.short_desensitization_curvature = default_parameter->short_desensitization_curvature;
+        parameter.short_desensitization_steepness = default_parameter->short_desensitization_steepness;
 
-        _parameter->long_habituation_steepness = default_parameter->long_habituation_steepness;
-        _parameter->long_habituation_curvature = default_parameter->long_habituation_curvature;
-        _parameter->long_sensitization_steepness = default_parameter->long_sensitization_steepness;
-        _parameter->long_sensitization_curvature = default_parameter->long_sensitization_curvature;
+        parameter.long_habituation_steepness = default_parameter->long_habituation_steepness;
+        parameter.long_habituation_curvature = default_parameter->long_habituation_curvature;
+        parameter.long_sensitization_steepness = default_parameter->long_sensitization_steepness;
+        parameter.long_sensitization_curvature = default_parameter->long_sensitization_curvature;
 
-        _parameter->long_dehabituation_steepness = default_parameter->long_dehabituation_steepness;
-        _parameter->long_dehabituation_curvature = default_parameter->long_dehabituation_curvature;
-        _parameter->long_desensitization_steepness = default_parameter->long_desensitization_steepness;
-        _parameter->long_desensitization_curvature = default_parameter->long_desensitization_curvature;
+        parameter.long_dehabituation_steepness = default_parameter->long_dehabituation_steepness;
+        parameter.long_dehabituation_curvature = default_parameter->long_dehabituation_curvature;
+        parameter.long_desensitization_steepness = default_parameter->long_desensitization_steepness;
+        parameter.long_desensitization_curvature = default_parameter->long_desensitization_curvature;
 
-        _parameter->presynaptic_potential_curvature = default_parameter->presynaptic_potential_curvature;
-        _parameter->presynaptic_potential_steepness = default_parameter->presynaptic_potential_steepness;
-        _parameter->presynaptic_backfall_curvature = default_parameter->presynaptic_backfall_curvature;
-        _parameter->presynaptic_backfall_steepness = default_parameter->presynaptic_backfall_steepness;
+        parameter.presynaptic_potential_curvature = default_parameter->presynaptic_potential_curvature;
+        parameter.presynaptic_potential_steepness = default_parameter->presynaptic_potential_steepness;
+        parameter.presynaptic_backfall_curvature = default_parameter->presynaptic_backfall_curvature;
+        parameter.presynaptic_backfall_steepness = default_parameter->presynaptic_backfall_steepness;
 
-        _parameter->habituation_threshold = default_parameter->habituation_threshold;
-        _parameter->sensitization_threshold = default_parameter->sensitization_threshold;
+        parameter.habituation_threshold = default_parameter->habituation_threshold;
+        parameter.sensitization_threshold = default_parameter->sensitization_threshold;
 
-        _parameter->long_learning_weight_reduction_curvature = default_parameter->long_learning_weight_reduction_curvature;
-        _parameter->long_learning_weight_reduction_steepness = default_parameter->long_learning_weight_reduction_steepness;
-        _parameter->long_learning_weight_backfall_curvature = default_parameter->long_learning_weight_backfall_curvature;
-        _parameter->long_learning_weight_backfall_steepness = default_parameter->long_learning_weight_backfall_steepness;
+        parameter.long_learning_weight_reduction_curvature = default_parameter->long_learning_weight_reduction_curvature;
+        parameter.long_learning_weight_reduction_steepness = default_parameter->long_learning_weight_reduction_steepness;
+        parameter.long_learning_weight_backfall_curvature = default_parameter->long_learning_weight_backfall_curvature;
+        parameter.long_learning_weight_backfall_steepness = default_parameter->long_learning_weight_backfall_steepness;
+
+        _parameter = _profiles->intern(parameter);
 
         _id = s_max_id;
         s_max_id++;
@@ -88,6 +96,7 @@ namespace COGNA{
         _was_activated = true;
         _last_activated_step = 0;
         _last_fired_step = 0;
+        _scheduled_epoch = -1;
     }
 
     //----------------------------------------------------------------------------------------------------------------------
@@ -95,13 +104,72 @@ namespace COGNA{
     Neuron::~Neuron(){
         _previous.clear();
         for(unsigned int i=0; i<_connections.size(); i++){
-            delete _connections[i];
+            _arena->destroy(_connections[i]);
             _connections[i] = NULL;
         }
         _connections.clear();
 
-        delete _parameter;
         _parameter = NULL;
+        _profiles = NULL;
+        _arena = NULL;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void Neuron::set_parameter(const NeuronParameterHandler &parameter){
+        _parameter = _profiles->intern(parameter);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    const ConnectionParameterHandler* Neuron::connection_parameter(int con_type,
+                                                                   int fun_type,
+                                                                   int learn_type,
+                                                                   int transmitter_type){
+        ConnectionParameterHandler connection_parameter;
+
+        connection_parameter.activation_type = con_type;
+        connection_parameter.activation_function = fun_type;
+        connection_parameter.learning_type = learn_type;
+        connection_parameter.transmitter_type = transmitter_type;
+
+        connection_parameter.max_weight = _parameter->max_weight;
+        connection_parameter.min_weight = _parameter->min_weight;
+
+        connection_parameter.short_habituation_curvature = _parameter->short_habituation_curvature;
+        connection_parameter.short_habituation_steepness = _parameter->short_habituation_steepness;
+        connection_parameter.short_sensitization_curvature = _parameter->short_sensitization_curvature;
+        connection_parameter.short_sensitization_steepness = _parameter->short_sensitization_steepness;
+
+        connection_parameter.short_dehabituation_curvature = _parameter->short_dehabituation_curvature;
+        connection_parameter.short_dehabituation_steepness = _parameter->short_dehabituation_steepness;
+        connection_parameter.short_desensitization_curvature = _parameter->short_desensitization_curvature;
+        connection_parameter.short_desensitization_steepness = _parameter->short_desensitization_steepness;
+
+        connection_parameter.long_habituation_steepness = _parameter->long_habituation_steepness;
+        connection_parameter.long_habituation_curvature = _parameter->long_habituation_curvature;
+        connection_parameter.long_sensitization_steepness = _parameter->long_sensitization_steepness;
+        connection_parameter.long_sensitization_curvature = _parameter->long_sensitization_curvature;
+
+        connection_parameter.long_dehabituation_steepness = _parameter->long_dehabituation_steepness;
+        connection_parameter.long_dehabituation_curvature = _parameter->long_dehabituation_curvature;
+        connection_parameter.long_desensitization_steepness = _parameter->long_desensitization_steepness;
+        connection_parameter.long_desensitization_curvature = _parameter->long_desensitization_curvature;
+
+        connection_parameter.presynaptic_potential_curvature = _parameter->presynaptic_potential_curvature;
+        connection_parameter.presynaptic_potential_steepness = _parameter->presynaptic_potential_steepness;
+        connection_parameter.presynaptic_backfall_curvature = _parameter->presynaptic_backfall_curvature;
+        connection_parameter.presynaptic_backfall_steepness = _parameter->presynaptic_backfall_steepness;
+
+        connection_parameter.habituation_threshold = _parameter->habituation_threshold;
+        connection_parameter.sensitization_threshold = _parameter->sensitization_threshold;
+
+        connection_parameter.long_learning_weight_reduction_curvature = _parameter->long_learning_weight_reduction_curvature;
+        connection_parameter.long_learning_weight_reduction_steepness = _parameter->long_learning_weight_reduction_steepness;
+        connection_parameter.long_learning_weight_backfall_curvature = _parameter->long_learning_weight_backfall_curvature;
+        connection_parameter.long_learning_weight_backfall_steepness = _parameter->long_learning_weight_backfall_steepness;
+
+        return _profiles->intern(connection_parameter);
     }
 
 
@@ -148,7 +216,7 @@ namespace COGNA{
                    this->_id, _network_id, n->_id, n->_network_id);
         }
         else{
-            Connection *temp_con = new Connection(_parameter);
+            Connection *temp_con = _arena->create<Connection>(connection_parameter(con_type, fun_type, learn_type, transmitter_type));
             temp_con->next_neuron = n;
             temp_con->next_connection = NULL;
             temp_con->prev_neuron = this;
@@ -157,10 +225,6 @@ namespace COGNA{
             temp_con->long_weight = weight;
             temp_con->long_learning_weight = 1.0f;
             temp_con->presynaptic_potential = 1.0f;
-            temp_con->_parameter->activation_type = con_type;
-            temp_con->_parameter->activation_function = fun_type;
-            temp_con->_parameter->learning_type = learn_type;
-            temp_con->_parameter->transmitter_type = transmitter_type;
             temp_con->last_presynaptic_activated_step = 0;
             temp_con->last_activated_step = 0;
             _connections.push_back(temp_con);
@@ -189,17 +253,13 @@ namespace COGNA{
             }
         }
         else{
-            Connection *temp_con = new Connection(_parameter);
+            Connection *temp_con = _arena->create<Connection>(connection_parameter(con_type, fun_type, learn_type, transmitter_type));
             temp_con->next_connection = con;
             temp_con->next_neuron = NULL;
             temp_con->prev_neuron = this;
             temp_con->base_weight = weight;
             temp_con->short_weight = weight;
             temp_con->long_weight = weight;
-            temp_con->_parameter->activation_type = con_type;
-            temp_con->_parameter->activation_function = fun_type;
-            temp_con->_parameter->learning_type = learn_type;
-            temp_con->_parameter->transmitter_type = transmitter_type;
             _connections.push_back(temp_con);
             return temp_con;
         }
@@ -215,14 +275,14 @@ namespace COGNA{
         }
         else{
             for(unsigned int i=0; i<n->_previous.size(); i++){
-                if(n->_previous[i]->_id == this->_id){
+                if(n->_previous[i] == this){
                     n->_previous.erase(n->_previous.begin()+i);
                     break;
                 }
             }
             for(unsigned int i=0; i<_connections.size(); i++){
                 if(_connections[i]->next_neuron->_id == n->_id){
-                    delete _connections[i];
+                    _arena->destroy(_connections[i]);
                     _connections[i] = NULL;
                     _connections.erase(_connections.begin()+i);
                     break;
@@ -245,44 +305,23 @@ namespace COGNA{
     //----------------------------------------------------------------------------------------------------------------------
     //
     void Neuron::set_random_activation(int chance, float activation_value){
-        _parameter->random_activation = true;
-        _parameter->random_chance = chance;
-        _parameter->random_activation_value = activation_value;
+        NeuronParameterHandler parameter = *_parameter;
+        parameter.random_activation = true;
+        parameter.random_chance = chance;
+        parameter.random_activation_value = activation_value;
+        set_parameter(parameter);
     }
 
+    //----------------------------------------------------------------------------------------------------------------------
+    //
     void Neuron::calculate_neuron_backfall(int64_t network_step){
-        if(DEBUG_MODE && DEB_NEURON_BACKFALL)
-            printf("<%ld> N-%d -> Activation before backfall = %.3f\n",
-                   network_step, _id, _activation);
-
-        if(_was_activated == false){
-            _activation =  MathUtils::calculate_static_gradient(_activation,
-                                                       _parameter->activation_backfall_steepness,
-                                                       network_step - _last_activated_step,
-                                                       _parameter->activation_backfall_curvature,
-                                                       SUBTRACT,
-                                                       _parameter->max_activation,
-                                                       _parameter->min_activation);
-        }
-
-        if(DEBUG_MODE && DEB_NEURON_BACKFALL)
-            printf("<%ld> N-%d -> Activation after backfall = %.3f\n\n",
-                   network_step, _id, _activation);
+        NetworkKernels::neuron_backfall(_activation, _was_activated, _last_activated_step,
+                                        _parameter, network_step, _id);
     }
 
     //----------------------------------------------------------------------------------------------------------------------
     //
     void Neuron::clear_neuron_activation(int64_t network_step){
-        if(DEBUG_MODE && DEB_NEURON_BACKFALL)
-            printf("<%ld> N-%d -> Activation before clearing = %.3f\n",
-                   network_step, _id, _activation);
-
-        if(_activation >= _parameter->activation_threshold){
-            _activation = _parameter->min_activation;
-        }
-
-        if(DEBUG_MODE && DEB_NEURON_BACKFALL)
-            printf("<%ld> N-%d -> Activation after clearing = %.3f\n\n",
-                   network_step, _id, _activation);
+        NetworkKernels::clear_neuron_activation(_activation, _parameter, network_step, _id);
     }
 }
@@ -10,6 +10,9 @@
 
 #include "NeuronParameterHandler.hpp"
 
+#include "HelperFunctions.hpp"
+#include "GradientEvaluator.hpp"
+
 using namespace COGNA;
 
 namespace COGNA{
@@ -31,5 +34,52 @@ namespace COGNA{
         random_activation = false;
         random_chance = 0;
         random_activation_value = 0.0f;
+
+        activation_backfall_gradient = NULL;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    bool NeuronParameterHandler::equals(const NeuronParameterHandler &other) const{
+        if(ConnectionParameterHandler::equals(other) == false) return false;
+        if(activation_threshold != other.activation_threshold) return false;
+        if(max_activation != other.max_activation) return false;
+        if(min_activation != other.min_activation) return false;
+        if(activation_backfall_curvature != other.activation_backfall_curvature) return false;
+        if(activation_backfall_steepness != other.activation_backfall_steepness) return false;
+        if(transmitter_change_curvature != other.transmitter_change_curvature) return false;
+        if(transmitter_change_steepness != other.transmitter_change_steepness) return false;
+        if(influenced_transmitter != other.influenced_transmitter) return false;
+        if(transmitter_influence_direction != other.transmitter_influence_direction) return false;
+        if(random_activation != other.random_activation) return false;
+        if(random_chance != other.random_chance) return false;
+        if(random_activation_value != other.random_activation_value) return false;
+        return true;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    size_t NeuronParameterHandler::hash() const{
+        size_t seed = ConnectionParameterHandler::hash();
+        utils::hash_combine(seed, activation_threshold);
+        utils::hash_combine(seed, max_activation);
+        utils::hash_combine(seed, min_activation);
+        utils::hash_combine(seed, activation_backfall_curvature);
+        utils::hash_combine(seed, activation_backfall_steepness);
+        utils::hash_combine(seed, transmitter_change_curvature);
+        utils::hash_combine(seed, transmitter_change_steepness);
+        utils::hash_combine(seed, influenced_transmitter);
+        utils::hash_combine(seed, transmitter_influence_direction);
+        utils::hash_combine(seed, random_activation);
+        utils::hash_combine(seed, random_chance);
+        utils::hash_combine(seed, random_activation_value);
+        return seed;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void NeuronParameterHandler::bind_gradients(){
+        ConnectionParameterHandler::bind_gradients();
+        activation_backfall_gradient = GradientEvaluator::get(activation_backfall_curvature);
     }
 }
@@ -0,0 +1,465 @@
+/**
+ * @file ParallelPropagator.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the ParallelPropagator class.
+ *
+ * @date 2021-07-17
+ *
+ */
+
+#include "ParallelPropagator.hpp"
+
+#include "NeuralNetwork.hpp"
+#include "Constants.hpp"
+#include "NetworkKernels.hpp"
+#include "NeuronParameterHandler.hpp"
+
+using namespace COGNA;
+
+namespace COGNA{
+
+const uint32_t NO_CONNECTION = 0xFFFFFFFF;
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+ParallelPropagator::ParallelPropagator(CompiledNetwork *compiled,
+                                       WorkerPool *pool,
+                                       bool gather,
+                                       const std::vector<uint16_t> *owners){
+    _compiled = compiled;
+    _pool = pool;
+    _gather = gather;
+    _worker_number = pool->worker_number();
+    _plan_epoch = 0;
+    _network_id = compiled->_network_id;
+    _network_step = 0;
+    _transmitter_weights = NULL;
+    _batch_learning = false;
+
+    _supported = true;
+    for(uint32_t con=0; con<compiled->_connection_count; con++){
+        if(compiled->_target_kinds[con] == EDGE_TARGET_CONNECTION && compiled->_target_networks[con] == compiled->_network_id){
+            _supported = false;
+        }
+    }
+    for(uint32_t n=0; n<compiled->_neuron_count; n++){
+        if(compiled->_neuron_parameter[n]->influenced_transmitter > NO_TRANSMITTER){
+            _supported = false;
+        }
+    }
+    if(_supported == false || _worker_number < 1 || (_worker_number < 2 && _gather == false)){
+        _supported = false;
+        return;
+    }
+
+    uint32_t word_number = compiled->_frontier_bits.size();
+    uint32_t chunk_number = PROPAGATION_CHUNKS_PER_WORKER * _worker_number;
+    if(chunk_number > word_number){
+        chunk_number = word_number;
+    }
+
+    /* Without a partition, owners reduce ranges of IDs. Gathering owners keep no lists per chunk,
+       so they can be as many as the chunks. */
+    uint32_t owner_number = 0;
+    _owners.resize(compiled->_neuron_count);
+    if(owners && owners->size() >= compiled->_neuron_count){
+        for(uint32_t n=0; n<compiled->_neuron_count; n++){
+            _owners[n] = (*owners)[n];
+            if((uint32_t)_owners[n] + 1 > owner_number){
+                owner_number = _owners[n] + 1;
+            }
+        }
+    }
+    else{
+        uint32_t owner_spans = _gather ? chunk_number : _worker_number;
+        uint32_t owner_span = (compiled->_neuron_count + owner_spans - 1) / owner_spans;
+        for(uint32_t n=0; n<compiled->_neuron_count; n++){
+            _owners[n] = n / owner_span;
+        }
+        owner_number = (compiled->_neuron_count + owner_span - 1) / owner_span;
+    }
+    _chunks = std::vector<Chunk>(chunk_number);
+    for(uint32_t c=0; c<chunk_number; c++){
+        _chunks[c]._first_word = (uint64_t)word_number * c / chunk_number;
+        _chunks[c]._last_word = (uint64_t)word_number * (c + 1) / chunk_number;
+        _chunks[c]._forces.resize(_gather ? 0 : owner_number);
+        compiled->reserve_learning_buffers(_chunks[c]._learning_buffers);
+
+        _scan_tasks.push_back([this, c](){ scan(c); });
+        _activate_tasks.push_back([this, c](){ activate_chunk(c); });
+    }
+    for(uint32_t owner=0; owner<owner_number; owner++){
+        if(_gather){
+            _reduce_tasks.push_back([this, owner](){ this->gather(owner); });
+        }
+        else{
+            _reduce_tasks.push_back([this, owner](){ reduce(owner); });
+        }
+    }
+
+    if(_gather){
+        compiled->build_incoming_connections();
+        _connection_forces.resize(compiled->_connection_count);
+        _force_epoch.assign(compiled->_connection_count, -1);
+
+        _touched_epoch = std::vector<std::atomic<int64_t>>(compiled->_neuron_count);
+        _touched_neurons.resize(owner_number);
+        _touched_number = std::vector<std::atomic<uint32_t>>(owner_number);
+        for(uint32_t n=0; n<compiled->_neuron_count; n++){
+            _touched_epoch[n] = -1;
+            _touched_neurons[_owners[n]].push_back(n);
+        }
+        for(uint32_t owner=0; owner<owner_number; owner++){
+            _touched_number[owner] = 0;
+        }
+    }
+
+    _planned_epoch.assign(compiled->_neuron_count, -1);
+    _fire_activation.resize(compiled->_neuron_count);
+    _self_activation.resize(compiled->_neuron_count);
+    _self_con.resize(compiled->_neuron_count);
+    _end_con.resize(compiled->_neuron_count);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+ParallelPropagator::~ParallelPropagator(){
+    _pool = NULL;
+    _compiled = NULL;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+bool ParallelPropagator::is_supported() const{
+    return _supported;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int ParallelPropagator::worker_number() const{
+    return _worker_number;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+WorkerPool *ParallelPropagator::pool() const{
+    return _pool;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+bool ParallelPropagator::is_gather() const{
+    return _gather;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void ParallelPropagator::activate(int network_id,
+                                  int64_t network_step,
+                                  const std::vector<float> &transmitter_weights,
+                                  bool batch_learning,
+                                  const std::vector<NeuralNetwork*> &network_list){
+    _network_id = network_id;
+    _network_step = network_step;
+    _transmitter_weights = &transmitter_weights;
+    _batch_learning = batch_learning;
+
+    _pool->run(_scan_tasks);
+    plan();
+    _pool->run(_activate_tasks);
+    _pool->run(_reduce_tasks);
+
+    for(unsigned int c=0; c<_chunks.size(); c++){
+        std::vector<RemoteDelivery> &deliveries = _chunks[c]._deliveries;
+        for(unsigned int i=0; i<deliveries.size(); i++){
+            network_list[deliveries[i]._network_id]->_inbox.push(_network_id, deliveries[i]._delivery);
+        }
+    }
+
+    _transmitter_weights = NULL;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void ParallelPropagator::scan(int chunk_id){
+    CompiledNetwork *cn = _compiled;
+    Chunk &chunk = _chunks[chunk_id];
+
+    chunk._frontier_edges.clear();
+    chunk._entries.clear();
+    chunk._deliveries.clear();
+    for(unsigned int owner=0; owner<chunk._forces.size(); owner++){
+        chunk._forces[owner].clear();
+    }
+
+    for(uint32_t word_id=chunk._first_word; word_id<chunk._last_word; word_id++){
+        uint64_t word = cn->_frontier_bits[word_id];
+        while(word != 0){
+            uint32_t prev = (word_id << 6) + __builtin_ctzll(word);
+            word &= word - 1;
+
+            ScanEntry entry = {prev, (uint32_t)chunk._frontier_edges.size(), 0};
+            for(uint32_t con=cn->_offsets[prev]; con<cn->_offsets[prev+1]; con++){
+                uint32_t next = cn->_targets[con];
+                if(cn->_target_kinds[con] != EDGE_TARGET_NEURON || cn->_target_networks[con] != _network_id){
+                    continue;
+                }
+
+                /* Only neurons which may fire themselves depend on the order of the forces they receive */
+                if((cn->_frontier_bits[next >> 6] & ((uint64_t)1 << (next & 63))) != 0 &&
+                   cn->_offsets[next] != cn->_offsets[next+1]){
+                    chunk._frontier_edges.push_back(con);
+                }
+            }
+            entry._last = chunk._frontier_edges.size();
+            if(entry._last > entry._first){
+                chunk._entries.push_back(entry);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void ParallelPropagator::plan_neuron(uint32_t neuron){
+    _planned_epoch[neuron] = _plan_epoch;
+    _fire_activation[neuron] = _compiled->_activation[neuron];
+    _self_con[neuron] = NO_CONNECTION;
+    _end_con[neuron] = _compiled->_offsets[neuron+1];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void ParallelPropagator::plan(){
+    CompiledNetwork *cn = _compiled;
+    _plan_epoch++;
+
+    /* Chunks and their entries are in ID order, which is the order of the serial dense step */
+    for(unsigned int c=0; c<_chunks.size(); c++){
+        Chunk &chunk = _chunks[c];
+        for(unsigned int e=0; e<chunk._entries.size(); e++){
+            uint32_t prev = chunk._entries[e]._neuron;
+            plan_neuron(prev);
+            if(cn->is_active(prev) == false){
+                _end_con[prev] = cn->_offsets[prev];
+                continue;
+            }
+
+            for(uint32_t i=chunk._entries[e]._first; i<chunk._entries[e]._last; i++){
+                uint32_t con = chunk._frontier_edges[i];
+                uint32_t next = cn->_targets[con];
+
+                if(next == prev){
+                    if(cn->_was_activated[prev] == false){
+                        NetworkKernels::neuron_backfall(cn->_activation[prev], false, cn->_last_activated_step[prev],
+                                                        cn->_neuron_parameter[prev], _network_step, prev);
+                        _self_con[prev] = con;
+                        _self_activation[prev] = cn->_activation[prev];
+                    }
+                    cn->_was_activated[prev] = true;
+                    if(cn->is_active(prev) == false){
+                        _end_con[prev] = con + 1;
+                        break;
+                    }
+                    continue;
+                }
+
+                /* A neuron which already fired keeps the activation it fired with */
+                if(cn->_was_activated[next] == false && next < prev && _planned_epoch[next] != _plan_epoch){
+                    plan_neuron(next);
+                }
+                NetworkKernels::neuron_backfall(cn->_activation[next], cn->_was_activated[next],
+                                                cn->_last_activated_step[next], cn->_neuron_parameter[next],
+                                                _network_step, next);
+                cn->_was_activated[next] = true;
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void ParallelPropagator::activate_chunk(int chunk_id){
+    CompiledNetwork *cn = _compiled;
+    Chunk &chunk = _chunks[chunk_id];
+
+    for(uint32_t word_id=chunk._first_word; word_id<chunk._last_word; word_id++){
+        uint64_t word = cn->_frontier_bits[word_id];
+        while(word != 0){
+            uint32_t prev = (word_id << 6) + __builtin_ctzll(word);
+            word &= word - 1;
+            activate_neuron(chunk, prev);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void ParallelPropagator::activate_neuron(Chunk &chunk, uint32_t prev){
+    typedef void (ParallelPropagator::*RunKernel)(Chunk&, uint32_t, uint32_t, uint32_t, bool);
+
+    /* Indexed by CompiledNetwork::kernel_id(). Local connection targets are not supported. */
+    static const RunKernel s_run_kernels[CONNECTION_KERNEL_NUMBER] = {
+        &ParallelPropagator::activate_run<KERNEL_ANY_TYPE, KERNEL_ANY_TYPE, KERNEL_ANY_TYPE>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_NEURON, FUNCTION_SIGMOID, LEARNING_NONE>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_NEURON, FUNCTION_SIGMOID, LEARNING_HABITUATION>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_NEURON, FUNCTION_SIGMOID, LEARNING_SENSITIZATION>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_NEURON, FUNCTION_SIGMOID, LEARNING_HABISENS>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_NEURON, FUNCTION_LINEAR, LEARNING_NONE>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_NEURON, FUNCTION_LINEAR, LEARNING_HABITUATION>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_NEURON, FUNCTION_LINEAR, LEARNING_SENSITIZATION>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_NEURON, FUNCTION_LINEAR, LEARNING_HABISENS>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_NEURON, FUNCTION_RELU, LEARNING_NONE>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_NEURON, FUNCTION_RELU, LEARNING_HABITUATION>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_NEURON, FUNCTION_RELU, LEARNING_SENSITIZATION>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_NEURON, FUNCTION_RELU, LEARNING_HABISENS>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_CONNECTION, KERNEL_ANY_TYPE, LEARNING_NONE>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_CONNECTION, KERNEL_ANY_TYPE, LEARNING_HABITUATION>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_CONNECTION, KERNEL_ANY_TYPE, LEARNING_SENSITIZATION>,
+        &ParallelPropagator::activate_run<EDGE_TARGET_CONNECTION, KERNEL_ANY_TYPE, LEARNING_HABISENS>
+    };
+
+    CompiledNetwork *cn = _compiled;
+    if(cn->_offsets[prev] == cn->_offsets[prev+1]){
+        return;
+    }
+
+    /* The plan knows the activation the neuron fired with, the activation of the whole step is restored afterwards */
+    float step_activation = cn->_activation[prev];
+    uint32_t end_con = cn->_offsets[prev+1];
+    if(_planned_epoch[prev] == _plan_epoch){
+        cn->_activation[prev] = _fire_activation[prev];
+        end_con = _end_con[prev];
+    }
+
+    if(cn->is_active(prev)){
+        bool batched = _batch_learning && cn->_batch_learning_rows[prev];
+        if(batched){
+            cn->batch_learning(prev, _network_step, chunk._learning_buffers);
+        }
+
+        for(uint32_t run=cn->_run_offsets[prev]; run<cn->_run_offsets[prev+1]; run++){
+            uint32_t first_con = cn->_run_starts[run];
+            uint32_t last_con = cn->_run_starts[run+1];
+            if(first_con >= end_con){
+                break;
+            }
+            if(last_con > end_con){
+                last_con = end_con;
+            }
+            RunKernel kernel = s_run_kernels[cn->_run_kernels[run]];
+            (this->*kernel)(chunk, prev, first_con, last_con, batched == false);
+        }
+        cn->_last_fired_step[prev] = _network_step;
+    }
+
+    cn->_activation[prev] = step_activation;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+template<int TARGET_KIND, int FUNCTION, int LEARNING_TYPE>
+void ParallelPropagator::activate_run(Chunk &chunk, uint32_t prev, uint32_t first_con, uint32_t last_con, bool learn){
+    CompiledNetwork *cn = _compiled;
+    uint32_t self_con = (_planned_epoch[prev] == _plan_epoch) ? _self_con[prev] : NO_CONNECTION;
+
+    for(uint32_t con=first_con; con<last_con; con++){
+        if(learn){
+            ConnectionStateRef state = cn->connection_state(con);
+            NetworkKernels::typed_learning<LEARNING_TYPE>(state, cn->_connection_parameter[con], cn->_activation[prev],
+                                                          NONDIRECTIONAL, _network_step, prev);
+        }
+        cn->_presynaptic_potential[con] = 2.0f;
+
+        const int target_network = cn->_target_networks[con];
+        const int target_kind = (TARGET_KIND == KERNEL_ANY_TYPE) ? cn->_target_kinds[con] : TARGET_KIND;
+        if(target_kind == EDGE_TARGET_NEURON && target_network != _network_id){
+            RemoteDelivery remote = {target_network, {_network_step, NULL, cn->_targets[con], 0,
+                                     cn->neuron_force<FUNCTION>(con, *_transmitter_weights), DELIVERY_NEURON}};
+            chunk._deliveries.push_back(remote);
+        }
+
+        else if(target_kind == EDGE_TARGET_NEURON){
+            uint32_t next = cn->_targets[con];
+
+            /* The backfall of the neuron firing at itself is part of the plan */
+            if(con == self_con){
+                cn->_activation[prev] = _self_activation[prev];
+            }
+            if(_gather){
+                _connection_forces[con] = cn->neuron_force<FUNCTION>(con, *_transmitter_weights);
+                _force_epoch[con] = _plan_epoch;
+
+                /* Only the first chunk touching the target lists it */
+                if(_touched_epoch[next].load(std::memory_order_relaxed) != _plan_epoch &&
+                   _touched_epoch[next].exchange(_plan_epoch, std::memory_order_relaxed) != _plan_epoch){
+                    uint16_t owner = _owners[next];
+                    _touched_neurons[owner][_touched_number[owner].fetch_add(1, std::memory_order_relaxed)] = next;
+                }
+            }
+            else{
+                TargetForce target_force = {next, cn->neuron_force<FUNCTION>(con, *_transmitter_weights)};
+                chunk._forces[_owners[next]].push_back(target_force);
+            }
+        }
+
+        else{
+            cn->presynaptic_potential_backfall(con, _network_step);
+            RemoteDelivery remote = {target_network, {_network_step, NULL, cn->_targets[con], cn->_activation_type[con],
+                                     cn->_activation[prev], DELIVERY_CONNECTION}};
+            chunk._deliveries.push_back(remote);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void ParallelPropagator::reduce(int owner){
+    CompiledNetwork *cn = _compiled;
+
+    for(unsigned int c=0; c<_chunks.size(); c++){
+        const std::vector<TargetForce> &forces = _chunks[c]._forces[owner];
+        for(unsigned int i=0; i<forces.size(); i++){
+            uint32_t next = forces[i]._target;
+            NetworkKernels::neuron_backfall(cn->_activation[next],
+                                            cn->_was_activated[next],
+                                            cn->_last_activated_step[next],
+                                            cn->_neuron_parameter[next],
+                                            _network_step,
+                                            next);
+            cn->_next_activation[next] += forces[i]._force;
+            cn->_was_activated[next] = true;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void ParallelPropagator::gather(int owner){
+    CompiledNetwork *cn = _compiled;
+    const std::vector<uint32_t> &neurons = _touched_neurons[owner];
+    uint32_t touched_number = _touched_number[owner].load(std::memory_order_relaxed);
+
+    /* The touched neurons are listed in any order, but every neuron only depends on its own incoming forces */
+    for(uint32_t n=0; n<touched_number; n++){
+        uint32_t next = neurons[n];
+        for(uint32_t i=cn->_incoming_offsets[next]; i<cn->_incoming_offsets[next+1]; i++){
+            uint32_t con = cn->_incoming[i];
+            if(_force_epoch[con] != _plan_epoch){
+                continue;
+            }
+            NetworkKernels::neuron_backfall(cn->_activation[next],
+                                            cn->_was_activated[next],
+                                            cn->_last_activated_step[next],
+                                            cn->_neuron_parameter[next],
+                                            _network_step,
+                                            next);
+            cn->_next_activation[next] += _connection_forces[con];
+            cn->_was_activated[next] = true;
+        }
+    }
+    _touched_number[owner].store(0, std::memory_order_relaxed);
+}
+
+} //namespace COGNA
@@ -0,0 +1,77 @@
+/**
+ * @file ParameterProfilePool.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the ParameterProfilePool class.
+ *
+ * @date 2021-07-06
+ *
+ */
+
+#include "ParameterProfilePool.hpp"
+
+using namespace COGNA;
+
+namespace COGNA{
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+ParameterProfilePool::ParameterProfilePool(NetworkArena *arena){
+    _arena = arena;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+ParameterProfilePool::~ParameterProfilePool(){
+    for(auto profile : _connection_profiles){
+        _arena->destroy(profile);
+    }
+    _connection_profiles.clear();
+
+    for(auto profile : _neuron_profiles){
+        _arena->destroy(profile);
+    }
+    _neuron_profiles.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+const ConnectionParameterHandler* ParameterProfilePool::intern(const ConnectionParameterHandler &parameter){
+    auto profile = _connection_profiles.find(&parameter);
+    if(profile != _connection_profiles.end()){
+        return *profile;
+    }
+
+    ConnectionParameterHandler *new_profile = _arena->create<ConnectionParameterHandler>(parameter);
+    new_profile->bind_gradients();
+    _connection_profiles.insert(new_profile);
+    return new_profile;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+const NeuronParameterHandler* ParameterProfilePool::intern(const NeuronParameterHandler &parameter){
+    auto profile = _neuron_profiles.find(&parameter);
+    if(profile != _neuron_profiles.end()){
+        return *profile;
+    }
+
+    NeuronParameterHandler *new_profile = _arena->create<NeuronParameterHandler>(parameter);
+    new_profile->bind_gradients();
+    _neuron_profiles.insert(new_profile);
+    return new_profile;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+size_t ParameterProfilePool::connection_profile_count() const{
+    return _connection_profiles.size();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+size_t ParameterProfilePool::neuron_profile_count() const{
+    return _neuron_profiles.size();
+}
+
+} //namespace COGNA
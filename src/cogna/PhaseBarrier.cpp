@@ -0,0 +1,116 @@
+/**
+ * @file PhaseBarrier.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the PhaseBarrier class.
+ *
+ * @date 2021-07-15
+ *
+ */
+
+#include "PhaseBarrier.hpp"
+
+#include <climits>
+#include <thread>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace COGNA;
+
+namespace COGNA{
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+static inline void cpu_relax(){
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+static void futex_wait(std::atomic<uint32_t> *word, uint32_t value){
+#ifdef __linux__
+    /* Returns immediately if the word does not contain the value anymore */
+    syscall(SYS_futex, (uint32_t*)word, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+#else
+    (void)word;
+    (void)value;
+    std::this_thread::yield();
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+static void futex_wake_all(std::atomic<uint32_t> *word){
+#ifdef __linux__
+    syscall(SYS_futex, (uint32_t*)word, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+#else
+    (void)word;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+PhaseBarrier::PhaseBarrier(int participants, int spin_count)
+    : _participants(participants), _spin_count(spin_count){
+    _arrived = 0;
+    _sleepers = 0;
+    _phase = 0;
+    _closed = false;
+    _sleep_count = 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+bool PhaseBarrier::arrive_and_wait(){
+    uint32_t phase = _phase.load(std::memory_order_acquire);
+
+    if(_arrived.fetch_add(1, std::memory_order_acq_rel) == _participants - 1){
+        _arrived.store(0, std::memory_order_relaxed);
+        _phase.store(phase + 1, std::memory_order_seq_cst);
+        if(_sleepers.load(std::memory_order_seq_cst) > 0){
+            futex_wake_all(&_phase);
+        }
+        return _closed.load(std::memory_order_acquire) == false;
+    }
+
+    for(int i=0; i<_spin_count; i++){
+        if(_phase.load(std::memory_order_acquire) != phase){
+            return _closed.load(std::memory_order_acquire) == false;
+        }
+        cpu_relax();
+    }
+
+    /* Either the last participant sees the sleeper or this thread sees the new phase */
+    _sleepers.fetch_add(1, std::memory_order_seq_cst);
+    _sleep_count.fetch_add(1, std::memory_order_relaxed);
+    while(_phase.load(std::memory_order_seq_cst) == phase){
+        futex_wait(&_phase, phase);
+    }
+    _sleepers.fetch_sub(1, std::memory_order_relaxed);
+    return _closed.load(std::memory_order_acquire) == false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void PhaseBarrier::close(){
+    _closed.store(true, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+uint32_t PhaseBarrier::phase() const{
+    return _phase.load(std::memory_order_acquire);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+uint64_t PhaseBarrier::sleep_count() const{
+    return _sleep_count.load(std::memory_order_relaxed);
+}
+
+} //namespace COGNA
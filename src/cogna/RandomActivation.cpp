@@ -0,0 +1,89 @@
+/**
+ * @file RandomActivation.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the RandomActivation class.
+ *
+ * @date 2021-07-22
+ *
+ */
+
+#include "RandomActivation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include "Constants.hpp"
+
+using namespace COGNA;
+
+namespace COGNA{
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+RandomActivation::RandomActivation(){
+
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+bool RandomActivation::later(const Activation &a, const Activation &b){
+    return a._step > b._step || (a._step == b._step && a._position > b._position);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int64_t RandomActivation::next_step(const CounterRandom &random, int64_t step, uint32_t neuron, int chance){
+    double probability = (chance + 1.0) / MAX_CHANCE;
+    if(probability >= 1.0){
+        return step + 1;
+    }
+
+    /* Inverse of the geometric distribution, P(wait == 1) = P(u > 1 - p) = p */
+    double u = random.uniform(step, neuron);
+    double wait = std::floor(std::log(u) / std::log1p(-probability));
+    return step + 1 + (int64_t)wait;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void RandomActivation::reset(const std::vector<uint32_t> &neurons, const std::vector<int> &chances,
+                             const CounterRandom &random, int64_t last_step){
+    _neurons = neurons;
+    _chances = chances;
+    _heap.clear();
+    for(unsigned int i=0; i<_neurons.size(); i++){
+        Activation activation;
+        activation._step = next_step(random, last_step, _neurons[i], _chances[i]);
+        activation._position = i;
+        _heap.push_back(activation);
+    }
+    std::make_heap(_heap.begin(), _heap.end(), later);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void RandomActivation::collect(int64_t step, const CounterRandom &random, std::vector<uint32_t> &positions){
+    positions.clear();
+    while(_heap.empty() == false && _heap.front()._step <= step){
+        positions.push_back(_heap.front()._position);
+        std::pop_heap(_heap.begin(), _heap.end(), later);
+        _heap.pop_back();
+    }
+
+    /* Pushed after all pops, so a neuron never fires twice in a step */
+    for(unsigned int i=0; i<positions.size(); i++){
+        Activation activation;
+        activation._step = next_step(random, step, _neurons[positions[i]], _chances[positions[i]]);
+        activation._position = positions[i];
+        _heap.push_back(activation);
+        std::push_heap(_heap.begin(), _heap.end(), later);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+size_t RandomActivation::size() const{
+    return _neurons.size();
+}
+
+} //namespace COGNA
@@ -0,0 +1,130 @@
+/**
+ * @file RealtimeProfile.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the RealtimeProfile class.
+ *
+ * @date 2021-07-24
+ *
+ */
+
+#include "RealtimeProfile.hpp"
+
+#include <cerrno>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#endif
+
+#include "Constants.hpp"
+
+using namespace COGNA;
+
+namespace COGNA{
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int RealtimeProfile::set_fifo_priority(std::thread::native_handle_type thread, int priority){
+#ifdef __linux__
+    struct sched_param parameter;
+    parameter.sched_priority = priority;
+    int result = pthread_setschedparam(thread, SCHED_FIFO, &parameter);
+    if(result != 0){
+        errno = result;
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+#else
+    (void)thread;
+    (void)priority;
+    errno = ENOSYS;
+    return ERROR_CODE;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int RealtimeProfile::set_current_fifo_priority(int priority){
+#ifdef __linux__
+    return set_fifo_priority(pthread_self(), priority);
+#else
+    (void)priority;
+    errno = ENOSYS;
+    return ERROR_CODE;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int RealtimeProfile::lock_memory(){
+#ifdef __linux__
+    if(mlockall(MCL_CURRENT | MCL_FUTURE) != 0){
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+#else
+    errno = ENOSYS;
+    return ERROR_CODE;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void RealtimeProfile::prefault_memory(void *memory, size_t size){
+    if(memory == NULL || size == 0){
+        return;
+    }
+
+    /* Writing the same byte back faults in the page for writing without changing it */
+    volatile unsigned char *bytes = (volatile unsigned char*)memory;
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    for(size_t i=0; i<size; i+=page_size){
+        bytes[i] = bytes[i];
+    }
+    bytes[size - 1] = bytes[size - 1];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void RealtimeProfile::prefault_stack(){
+    volatile unsigned char stack[REALTIME_STACK_PREFAULT];
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    for(size_t i=0; i<REALTIME_STACK_PREFAULT; i+=page_size){
+        stack[i] = 0;
+    }
+    (void)stack[0];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+uint64_t RealtimeProfile::priority_limit(){
+#ifdef __linux__
+    struct rlimit limit;
+    if(getrlimit(RLIMIT_RTPRIO, &limit) != 0){
+        return 0;
+    }
+    return (limit.rlim_cur == RLIM_INFINITY) ? UINT64_MAX : limit.rlim_cur;
+#else
+    return 0;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+uint64_t RealtimeProfile::lock_limit(){
+#ifdef __linux__
+    struct rlimit limit;
+    if(getrlimit(RLIMIT_MEMLOCK, &limit) != 0){
+        return 0;
+    }
+    return (limit.rlim_cur == RLIM_INFINITY) ? UINT64_MAX : limit.rlim_cur;
+#else
+    return 0;
+#endif
+}
+
+} //namespace COGNA
@@ -0,0 +1,210 @@
+/**
+ * @file TickClock.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the TickClock class.
+ *
+ * @date 2021-07-23
+ *
+ */
+
+#include "TickClock.hpp"
+
+#include <cerrno>
+#include <iostream>
+#include <time.h>
+#include "Constants.hpp"
+
+using namespace COGNA;
+
+namespace COGNA{
+    namespace{
+        const int64_t NANOSECOND_FACTOR = 1000000000;
+        const int64_t NANOSECONDS_PER_MICROSECOND = 1000;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    TickClock::TickClock(int frequency, int overrun_policy){
+        set_frequency(frequency);
+        _overrun_policy = overrun_policy;
+        _deadline = 0;
+        _ticks = 0;
+        _overruns = 0;
+        _skipped_ticks = 0;
+        _max_lateness = 0;
+        for(int b=0; b<LATENESS_BUCKETS; b++){
+            _lateness[b] = 0;
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void TickClock::set_frequency(int frequency){
+        _period = NANOSECOND_FACTOR / ((frequency > 0) ? frequency : 1);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void TickClock::set_overrun_policy(int overrun_policy){
+        _overrun_policy = overrun_policy;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    int TickClock::overrun_policy() const{
+        return _overrun_policy;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    int64_t TickClock::now(){
+        struct timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return (int64_t)time.tv_sec * NANOSECOND_FACTOR + time.tv_nsec;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void TickClock::start(){
+        _ticks = 0;
+        _overruns = 0;
+        _skipped_ticks = 0;
+        _max_lateness = 0;
+        for(int b=0; b<LATENESS_BUCKETS; b++){
+            _lateness[b] = 0;
+        }
+        _deadline = now() + _period;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void TickClock::wait(){
+        struct timespec deadline;
+        deadline.tv_sec = _deadline / NANOSECOND_FACTOR;
+        deadline.tv_nsec = _deadline % NANOSECOND_FACTOR;
+        while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR){
+        }
+
+        int64_t lateness = now() - _deadline;
+        if(lateness < 0){
+            lateness = 0;
+        }
+        int64_t lateness_us = lateness / NANOSECONDS_PER_MICROSECOND;
+        int bucket = 0;
+        while(bucket < LATENESS_BUCKETS - 1 && bucket_limit(bucket) <= lateness_us){
+            bucket++;
+        }
+        _lateness[bucket].fetch_add(1, std::memory_order_relaxed);
+        if(lateness_us > _max_lateness.load(std::memory_order_relaxed)){
+            _max_lateness.store(lateness_us, std::memory_order_relaxed);
+        }
+        _ticks.fetch_add(1, std::memory_order_relaxed);
+
+        /* Deadlines passed while this tick was late */
+        int64_t missed = lateness / _period;
+        if(missed > 0){
+            _overruns.fetch_add(1, std::memory_order_relaxed);
+        }
+        if(missed > 0 && _overrun_policy == OVERRUN_SKIP){
+            _skipped_ticks.fetch_add(missed, std::memory_order_relaxed);
+            _deadline += (missed + 1) * _period;
+        }
+        else if(missed > 0 && _overrun_policy == OVERRUN_STRETCH){
+            _deadline += lateness + _period;
+        }
+        else{
+            _deadline += _period;
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    uint64_t TickClock::ticks() const{
+        return _ticks.load(std::memory_order_relaxed);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    uint64_t TickClock::overruns() const{
+        return _overruns.load(std::memory_order_relaxed);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    uint64_t TickClock::skipped_ticks() const{
+        return _skipped_ticks.load(std::memory_order_relaxed);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    uint64_t TickClock::lateness_count(int bucket) const{
+        if(bucket < 0 || bucket >= LATENESS_BUCKETS){
+            return 0;
+        }
+        return _lateness[bucket].load(std::memory_order_relaxed);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    int64_t TickClock::bucket_limit(int bucket){
+        return (int64_t)1 << bucket;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    int64_t TickClock::lateness_percentile(double fraction) const{
+        uint64_t counts[LATENESS_BUCKETS];
+        uint64_t total = 0;
+        for(int b=0; b<LATENESS_BUCKETS; b++){
+            counts[b] = lateness_count(b);
+            total += counts[b];
+        }
+
+        uint64_t seen = 0;
+        for(int b=0; b<LATENESS_BUCKETS; b++){
+            seen += counts[b];
+            if(seen > 0 && seen >= fraction * total){
+                return bucket_limit(b);
+            }
+        }
+        return 0;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    int64_t TickClock::max_lateness() const{
+        return _max_lateness.load(std::memory_order_relaxed);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void TickClock::print_statistics() const{
+        std::cout << "[INFO] " << ticks() << " ticks, " << overruns() << " overruns, " << skipped_ticks()
+                  << " skipped ticks. Lateness below " << lateness_percentile(0.5) << " us in 50%, "
+                  << lateness_percentile(0.99) << " us in 99% of the ticks, at most " << max_lateness()
+                  << " us." << std::endl;
+        for(int b=0; b<LATENESS_BUCKETS; b++){
+            if(lateness_count(b) > 0){
+                std::cout << "[INFO]     Lateness " << ((b > 0) ? bucket_limit(b - 1) : 0) << " - "
+                          << bucket_limit(b) << " us: " << lateness_count(b) << " ticks" << std::endl;
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    int TickClock::parse_overrun_policy(const std::string &name){
+        if(name == "skip"){
+            return OVERRUN_SKIP;
+        }
+        if(name == "catch_up"){
+            return OVERRUN_CATCH_UP;
+        }
+        if(name == "stretch"){
+            return OVERRUN_STRETCH;
+        }
+        return ERROR_CODE;
+    }
+
+} //namespace COGNA
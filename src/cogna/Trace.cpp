@@ -0,0 +1,180 @@
+/**
+ * @file Trace.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the Trace class.
+ *
+ * @date 2021-07-12
+ *
+ */
+
+#include "Trace.hpp"
+
+#include <sstream>
+
+#include "Constants.hpp"
+
+using namespace COGNA;
+
+namespace COGNA{
+    uint32_t Trace::s_categories = TRACE_NONE;
+    thread_local int Trace::s_network_id = 0;
+    std::string Trace::s_output_file;
+    std::atomic<uint64_t> Trace::s_head(0);
+    TraceEvent Trace::s_events[TRACE_BUFFER_SIZE];
+
+    namespace{
+        const char *const CATEGORY_NAMES[] = {"step", "base", "habituation", "sensitization", "transmitter",
+                                              "neuron_backfall", "long_learning_weight", "presynaptic"};
+        const int CATEGORY_NUMBER = sizeof(CATEGORY_NAMES) / sizeof(CATEGORY_NAMES[0]);
+
+        const char *const EVENT_NAMES[] = {"", "Step", "Force", "Target", "Short weight", "Long weight",
+                                           "Long learning weight", "Presynaptic potential", "Activation",
+                                           "Transmitter weight"};
+        const char *const PHASE_NAMES[] = {"", "before", "after"};
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void Trace::record(uint32_t category,
+                       uint8_t event,
+                       uint8_t phase,
+                       int64_t step,
+                       int id,
+                       int other_id,
+                       float value){
+        uint64_t slot = s_head.fetch_add(1, std::memory_order_relaxed) & (TRACE_BUFFER_SIZE - 1);
+        TraceEvent &trace_event = s_events[slot];
+        trace_event.step = step;
+        trace_event.category = category;
+        trace_event.event = event;
+        trace_event.phase = phase;
+        trace_event.network_id = (uint16_t)s_network_id;
+        trace_event.id = id;
+        trace_event.other_id = other_id;
+        trace_event.value = value;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void Trace::set_network(int network_id){
+        s_network_id = network_id;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void Trace::set_categories(uint32_t categories){
+        s_categories = categories;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    int Trace::parse_categories(const std::string &names, uint32_t &categories){
+        std::stringstream name_stream(names);
+        std::string name;
+        categories = TRACE_NONE;
+
+        while(std::getline(name_stream, name, ',')){
+            name.erase(0, name.find_first_not_of(" \t"));
+            name.erase(name.find_last_not_of(" \t") + 1);
+            if(name == "" || name == "none"){
+                continue;
+            }
+            if(name == "all"){
+                categories |= TRACE_ALL;
+                continue;
+            }
+
+            int category = 0;
+            while(category < CATEGORY_NUMBER && name != CATEGORY_NAMES[category]){
+                category++;
+            }
+            if(category == CATEGORY_NUMBER){
+                return ERROR_CODE;
+            }
+            categories |= 1 << category;
+        }
+        return SUCCESS_CODE;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    uint64_t Trace::recorded(){
+        return s_head.load(std::memory_order_relaxed);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    int Trace::snapshot(TraceEvent *events){
+        uint64_t head = recorded();
+        uint64_t first = (head > (uint64_t)TRACE_BUFFER_SIZE) ? head - TRACE_BUFFER_SIZE : 0;
+
+        for(uint64_t i=first; i<head; i++){
+            events[i - first] = s_events[i & (TRACE_BUFFER_SIZE - 1)];
+        }
+        return (int)(head - first);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void Trace::clear(){
+        s_head.store(0, std::memory_order_relaxed);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    int Trace::write_file(const std::string &path){
+        FILE *file = fopen(path.c_str(), "wb");
+        if(file == NULL){
+            return ERROR_CODE;
+        }
+
+        TraceEvent *events = new TraceEvent[TRACE_BUFFER_SIZE];
+        int event_number = snapshot(events);
+        size_t written = fwrite(events, sizeof(TraceEvent), event_number, file);
+        delete[] events;
+        fclose(file);
+
+        if(written != (size_t)event_number){
+            return ERROR_CODE;
+        }
+        return SUCCESS_CODE;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void Trace::print(FILE *file){
+        TraceEvent *events = new TraceEvent[TRACE_BUFFER_SIZE];
+        int event_number = snapshot(events);
+
+        for(int i=0; i<event_number; i++){
+            const TraceEvent &event = events[i];
+            const char *event_name = (event.event < sizeof(EVENT_NAMES) / sizeof(EVENT_NAMES[0])) ?
+                                     EVENT_NAMES[event.event] : "Unknown";
+            const char *phase_name = (event.phase < sizeof(PHASE_NAMES) / sizeof(PHASE_NAMES[0])) ?
+                                     PHASE_NAMES[event.phase] : "";
+
+            fprintf(file, "<%ld> NN-%d N-%d", (long)event.step, event.network_id, event.id);
+            if(event.other_id >= 0){
+                fprintf(file, "~%d", event.other_id);
+            }
+            fprintf(file, " -> %s %s = %.5f\n", event_name, phase_name, event.value);
+        }
+        delete[] events;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void Trace::set_output_file(const std::string &path){
+        s_output_file = path;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    int Trace::flush(){
+        if(s_output_file == "" || recorded() == 0){
+            return SUCCESS_CODE;
+        }
+        return write_file(s_output_file);
+    }
+}
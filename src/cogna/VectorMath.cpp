@@ -0,0 +1,268 @@
+/**
+ * @file VectorMath.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the VectorMath class.
+ *
+ * pow(x, y) is evaluated as exp(y * log(x)):
+ *  - log(x): x is split into m * 2^e with m in [sqrt(0.5), sqrt(2)[, then
+ *            log(m) = 2 * atanh((m-1)/(m+1)) is evaluated with its power series.
+ *  - exp(t): t is split into k * ln(2) + r with |r| <= ln(2)/2, then
+ *            exp(r) is evaluated with its Taylor series and scaled by 2^k.
+ * Both series are cut off after their terms fall below the double precision.
+ *
+ * @date 2021-07-10
+ *
+ */
+
+#include "VectorMath.hpp"
+
+#include <cmath>
+#include <cfloat>
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define VECTOR_MATH_X86
+#endif
+
+using namespace COGNA;
+
+namespace{
+    const int LANES_AVX2 = 4;
+    const int LANES_SSE2 = 2;
+
+    const double LN2_HI = 6.93147180369123816490e-01;     // ln(2) with 32 trailing zero bits, k*LN2_HI is exact
+    const double LN2_LO = 1.90821492927058770002e-10;     // ln(2) - LN2_HI
+    const double INV_LN2 = 1.44269504088896338700e+00;
+    const double SQRT2 = 1.41421356237309504880e+00;
+    const double MAX_EXP_ARGUMENT = 708.0;                 // exp() stays a normal double inside of +-708
+    const double ROUND_MAGIC = 6755399441055744.0;         // 1.5 * 2^52, adding it rounds to an integer
+    const double EXPONENT_MAGIC = 4503599627370496.0;      // 2^52
+
+    const uint64_t MANTISSA_MASK = 0x000FFFFFFFFFFFFFULL;
+    const uint64_t ONE_BITS = 0x3FF0000000000000ULL;
+    const uint64_t EXPONENT_MAGIC_BITS = 0x4330000000000000ULL;
+    const int64_t EXPONENT_BIAS = 1023;
+
+    /* 2 / (2k + 1), series of log(m) = f * sum(LOG_SERIES[k] * f^2k) with f = (m-1)/(m+1) */
+    const int LOG_TERMS = 12;
+    const double LOG_SERIES[LOG_TERMS] = {
+        2.0, 2.0/3.0, 2.0/5.0, 2.0/7.0, 2.0/9.0, 2.0/11.0,
+        2.0/13.0, 2.0/15.0, 2.0/17.0, 2.0/19.0, 2.0/21.0, 2.0/23.0
+    };
+
+    /* 1 / k!, Taylor series of exp(r) */
+    const int EXP_TERMS = 14;
+    const double EXP_SERIES[EXP_TERMS] = {
+        1.0, 1.0, 1.0/2.0, 1.0/6.0, 1.0/24.0, 1.0/120.0, 1.0/720.0, 1.0/5040.0,
+        1.0/40320.0, 1.0/362880.0, 1.0/3628800.0, 1.0/39916800.0,
+        1.0/479001600.0, 1.0/6227020800.0
+    };
+
+#ifdef VECTOR_MATH_X86
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    /* Writes pow(x, y) of all lanes to result and returns a bit mask of the lanes that are not special cases */
+    __attribute__((target("avx2")))
+    inline int pow_block_avx2(__m256d x, __m256d y, double *result){
+        const __m256d one = _mm256_set1_pd(1.0);
+
+        /* log(x) */
+        __m256i bits = _mm256_castpd_si256(x);
+        __m256i biased_exponent = _mm256_srli_epi64(bits, 52);
+        __m256d e = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(biased_exponent,
+                                                                     _mm256_set1_epi64x(EXPONENT_MAGIC_BITS))),
+                                  _mm256_set1_pd(EXPONENT_MAGIC + EXPONENT_BIAS));
+        __m256d m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(MANTISSA_MASK)),
+                                                        _mm256_set1_epi64x(ONE_BITS)));
+        __m256d is_big = _mm256_cmp_pd(m, _mm256_set1_pd(SQRT2), _CMP_GT_OQ);
+        m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), is_big);
+        e = _mm256_add_pd(e, _mm256_and_pd(is_big, one));
+
+        __m256d f = _mm256_div_pd(_mm256_sub_pd(m, one), _mm256_add_pd(m, one));
+        __m256d s = _mm256_mul_pd(f, f);
+        __m256d series = _mm256_set1_pd(LOG_SERIES[LOG_TERMS-1]);
+        for(int k=LOG_TERMS-2; k>=0; k--){
+            series = _mm256_add_pd(_mm256_mul_pd(series, s), _mm256_set1_pd(LOG_SERIES[k]));
+        }
+        __m256d log_x = _mm256_add_pd(_mm256_mul_pd(e, _mm256_set1_pd(LN2_HI)),
+                                      _mm256_add_pd(_mm256_mul_pd(e, _mm256_set1_pd(LN2_LO)),
+                                                    _mm256_mul_pd(f, series)));
+
+        /* exp(y * log(x)) */
+        __m256d t = _mm256_mul_pd(y, log_x);
+        __m256d k_magic = _mm256_add_pd(_mm256_mul_pd(t, _mm256_set1_pd(INV_LN2)), _mm256_set1_pd(ROUND_MAGIC));
+        __m256d k = _mm256_sub_pd(k_magic, _mm256_set1_pd(ROUND_MAGIC));
+        __m256d r = _mm256_sub_pd(_mm256_sub_pd(t, _mm256_mul_pd(k, _mm256_set1_pd(LN2_HI))),
+                                  _mm256_mul_pd(k, _mm256_set1_pd(LN2_LO)));
+        series = _mm256_set1_pd(EXP_SERIES[EXP_TERMS-1]);
+        for(int n=EXP_TERMS-2; n>=0; n--){
+            series = _mm256_add_pd(_mm256_mul_pd(series, r), _mm256_set1_pd(EXP_SERIES[n]));
+        }
+        __m256i k_bits = _mm256_sub_epi64(_mm256_castpd_si256(k_magic),
+                                          _mm256_castpd_si256(_mm256_set1_pd(ROUND_MAGIC)));
+        __m256d scale = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(k_bits, _mm256_set1_epi64x(EXPONENT_BIAS)),
+                                                             52));
+        _mm256_storeu_pd(result, _mm256_mul_pd(series, scale));
+
+        /* Ordered comparisons are false for NaN, so these lanes count as special as well */
+        __m256d is_regular = _mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(x, _mm256_set1_pd(DBL_MIN), _CMP_GE_OQ),
+                                                         _mm256_cmp_pd(x, _mm256_set1_pd(DBL_MAX), _CMP_LE_OQ)),
+                                           _mm256_and_pd(_mm256_cmp_pd(t, _mm256_set1_pd(MAX_EXP_ARGUMENT), _CMP_LE_OQ),
+                                                         _mm256_cmp_pd(t, _mm256_set1_pd(-MAX_EXP_ARGUMENT), _CMP_GE_OQ)));
+        return _mm256_movemask_pd(is_regular);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    __attribute__((target("avx2")))
+    void pow_avx2(const double *base, const double *exponent, double *result, int count){
+        const int all_lanes = (1 << LANES_AVX2) - 1;
+        int i = 0;
+
+        for(; i+LANES_AVX2<=count; i+=LANES_AVX2){
+            int regular_lanes = pow_block_avx2(_mm256_loadu_pd(base+i), _mm256_loadu_pd(exponent+i), result+i);
+            if(regular_lanes != all_lanes){
+                for(int lane=0; lane<LANES_AVX2; lane++){
+                    if((regular_lanes & (1 << lane)) == 0){
+                        result[i+lane] = std::pow(base[i+lane], exponent[i+lane]);
+                    }
+                }
+            }
+        }
+
+        /* The remaining elements are padded with pow(1, 0) */
+        if(i < count){
+            double x_in[LANES_AVX2] = {1.0, 1.0, 1.0, 1.0};
+            double y_in[LANES_AVX2] = {0.0, 0.0, 0.0, 0.0};
+            double out[LANES_AVX2];
+            for(int lane=0; i+lane<count; lane++){
+                x_in[lane] = base[i+lane];
+                y_in[lane] = exponent[i+lane];
+            }
+            int regular_lanes = pow_block_avx2(_mm256_loadu_pd(x_in), _mm256_loadu_pd(y_in), out);
+            for(int lane=0; i+lane<count; lane++){
+                result[i+lane] = (regular_lanes & (1 << lane)) ? out[lane] : std::pow(x_in[lane], y_in[lane]);
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    inline __m128d select_sse2(__m128d mask, __m128d if_true, __m128d if_false){
+        return _mm_or_pd(_mm_and_pd(mask, if_true), _mm_andnot_pd(mask, if_false));
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    /* Writes pow(x, y) of both lanes to result and returns a bit mask of the lanes that are not special cases */
+    inline int pow_block_sse2(__m128d x, __m128d y, double *result){
+        const __m128d one = _mm_set1_pd(1.0);
+
+        /* log(x) */
+        __m128i bits = _mm_castpd_si128(x);
+        __m128i biased_exponent = _mm_srli_epi64(bits, 52);
+        __m128d e = _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(biased_exponent, _mm_set1_epi64x(EXPONENT_MAGIC_BITS))),
+                               _mm_set1_pd(EXPONENT_MAGIC + EXPONENT_BIAS));
+        __m128d m = _mm_castsi128_pd(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi64x(MANTISSA_MASK)),
+                                                  _mm_set1_epi64x(ONE_BITS)));
+        __m128d is_big = _mm_cmpgt_pd(m, _mm_set1_pd(SQRT2));
+        m = select_sse2(is_big, _mm_mul_pd(m, _mm_set1_pd(0.5)), m);
+        e = _mm_add_pd(e, _mm_and_pd(is_big, one));
+
+        __m128d f = _mm_div_pd(_mm_sub_pd(m, one), _mm_add_pd(m, one));
+        __m128d s = _mm_mul_pd(f, f);
+        __m128d series = _mm_set1_pd(LOG_SERIES[LOG_TERMS-1]);
+        for(int k=LOG_TERMS-2; k>=0; k--){
+            series = _mm_add_pd(_mm_mul_pd(series, s), _mm_set1_pd(LOG_SERIES[k]));
+        }
+        __m128d log_x = _mm_add_pd(_mm_mul_pd(e, _mm_set1_pd(LN2_HI)),
+                                   _mm_add_pd(_mm_mul_pd(e, _mm_set1_pd(LN2_LO)), _mm_mul_pd(f, series)));
+
+        /* exp(y * log(x)) */
+        __m128d t = _mm_mul_pd(y, log_x);
+        __m128d k_magic = _mm_add_pd(_mm_mul_pd(t, _mm_set1_pd(INV_LN2)), _mm_set1_pd(ROUND_MAGIC));
+        __m128d k = _mm_sub_pd(k_magic, _mm_set1_pd(ROUND_MAGIC));
+        __m128d r = _mm_sub_pd(_mm_sub_pd(t, _mm_mul_pd(k, _mm_set1_pd(LN2_HI))),
+                               _mm_mul_pd(k, _mm_set1_pd(LN2_LO)));
+        series = _mm_set1_pd(EXP_SERIES[EXP_TERMS-1]);
+        for(int n=EXP_TERMS-2; n>=0; n--){
+            series = _mm_add_pd(_mm_mul_pd(series, r), _mm_set1_pd(EXP_SERIES[n]));
+        }
+        __m128i k_bits = _mm_sub_epi64(_mm_castpd_si128(k_magic), _mm_castpd_si128(_mm_set1_pd(ROUND_MAGIC)));
+        __m128d scale = _mm_castsi128_pd(_mm_slli_epi64(_mm_add_epi64(k_bits, _mm_set1_epi64x(EXPONENT_BIAS)), 52));
+        _mm_storeu_pd(result, _mm_mul_pd(series, scale));
+
+        /* Ordered comparisons are false for NaN, so these lanes count as special as well */
+        __m128d is_regular = _mm_and_pd(_mm_and_pd(_mm_cmpge_pd(x, _mm_set1_pd(DBL_MIN)),
+                                                   _mm_cmple_pd(x, _mm_set1_pd(DBL_MAX))),
+                                        _mm_and_pd(_mm_cmple_pd(t, _mm_set1_pd(MAX_EXP_ARGUMENT)),
+                                                   _mm_cmpge_pd(t, _mm_set1_pd(-MAX_EXP_ARGUMENT))));
+        return _mm_movemask_pd(is_regular);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void pow_sse2(const double *base, const double *exponent, double *result, int count){
+        const int all_lanes = (1 << LANES_SSE2) - 1;
+        int i = 0;
+
+        for(; i+LANES_SSE2<=count; i+=LANES_SSE2){
+            int regular_lanes = pow_block_sse2(_mm_loadu_pd(base+i), _mm_loadu_pd(exponent+i), result+i);
+            if(regular_lanes != all_lanes){
+                for(int lane=0; lane<LANES_SSE2; lane++){
+                    if((regular_lanes & (1 << lane)) == 0){
+                        result[i+lane] = std::pow(base[i+lane], exponent[i+lane]);
+                    }
+                }
+            }
+        }
+
+        /* The remaining element is padded with pow(1, 0) */
+        if(i < count){
+            double x_in[LANES_SSE2] = {base[i], 1.0};
+            double y_in[LANES_SSE2] = {exponent[i], 0.0};
+            double out[LANES_SSE2];
+            int regular_lanes = pow_block_sse2(_mm_loadu_pd(x_in), _mm_loadu_pd(y_in), out);
+            result[i] = (regular_lanes & 1) ? out[0] : std::pow(x_in[0], y_in[0]);
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    bool has_avx2(){
+        static const bool s_has_avx2 = __builtin_cpu_supports("avx2");
+        return s_has_avx2;
+    }
+#endif
+}
+
+namespace COGNA{
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    void VectorMath::pow(const double *base, const double *exponent, double *result, int count){
+#ifdef VECTOR_MATH_X86
+        if(has_avx2()){
+            pow_avx2(base, exponent, result, count);
+        }
+        else{
+            pow_sse2(base, exponent, result, count);
+        }
+#else
+        for(int i=0; i<count; i++){
+            result[i] = std::pow(base[i], exponent[i]);
+        }
+#endif
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------
+    //
+    const char *VectorMath::instruction_set(){
+#ifdef VECTOR_MATH_X86
+        return has_avx2() ? "AVX2" : "SSE2";
+#else
+        return "scalar";
+#endif
+    }
+}
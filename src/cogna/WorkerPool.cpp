@@ -0,0 +1,291 @@
+/**
+ * @file WorkerPool.cpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Implementation of the WorkerPool class.
+ *
+ * @date 2021-07-16
+ *
+ */
+
+#include "WorkerPool.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "Constants.hpp"
+#include "CpuPlacement.hpp"
+#include "RealtimeProfile.hpp"
+
+using namespace COGNA;
+
+namespace COGNA{
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+static inline uint64_t pack_range(uint32_t begin, uint32_t end){
+    return ((uint64_t)end << 32) | begin;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+static inline uint64_t now_nanosec(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+WorkerPool::WorkerPool(int worker_number){
+    _worker_number = worker_number;
+    if(_worker_number <= 0){
+        _worker_number = std::thread::hardware_concurrency();
+    }
+    if(_worker_number <= 0){
+        _worker_number = 1;
+    }
+
+    _queues = std::vector<WorkerQueue>(_worker_number);
+    for(int i=0; i<_worker_number; i++){
+        _queues[i]._range = pack_range(0, 0);
+        _queues[i]._busy_time = 0;
+        _queues[i]._tasks = 0;
+        _queues[i]._stolen_tasks = 0;
+    }
+    _worker_cpus.assign(_worker_number, -1);
+    _tasks = NULL;
+    _worker_task = NULL;
+    _run_time = 0;
+
+    _barrier = new PhaseBarrier(_worker_number);
+    for(int i=1; i<_worker_number; i++){
+        _threads.push_back(std::thread(&WorkerPool::work, this, i));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+WorkerPool::~WorkerPool(){
+    _barrier->close();
+    _barrier->arrive_and_wait();
+    for(unsigned int i=0; i<_threads.size(); i++){
+        _threads[i].join();
+    }
+    _threads.clear();
+
+    delete _barrier;
+    _barrier = NULL;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void WorkerPool::run(const std::vector<std::function<void()>> &tasks){
+    uint64_t start_time = now_nanosec();
+
+    uint32_t task_number = tasks.size();
+    for(int i=0; i<_worker_number; i++){
+        uint32_t begin = (uint64_t)task_number * i / _worker_number;
+        uint32_t end = (uint64_t)task_number * (i + 1) / _worker_number;
+        _queues[i]._range.store(pack_range(begin, end), std::memory_order_relaxed);
+    }
+    run_queues(tasks, start_time);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void WorkerPool::run(const std::vector<std::function<void()>> &tasks, const std::vector<uint32_t> &first_tasks){
+    uint64_t start_time = now_nanosec();
+
+    uint32_t task_number = tasks.size();
+    for(int i=0; i<_worker_number; i++){
+        uint32_t begin = (i < (int)first_tasks.size()) ? first_tasks[i] : task_number;
+        uint32_t end = (i + 1 < (int)first_tasks.size()) ? first_tasks[i+1] : task_number;
+        _queues[i]._range.store(pack_range(begin, end), std::memory_order_relaxed);
+    }
+    run_queues(tasks, start_time);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void WorkerPool::run_queues(const std::vector<std::function<void()>> &tasks, uint64_t start_time){
+    _tasks = &tasks;
+
+    /* Both phases of the barrier publish the queues and the results of the tasks */
+    _barrier->arrive_and_wait();
+    process(0);
+    _barrier->arrive_and_wait();
+
+    _tasks = NULL;
+    _run_time += now_nanosec() - start_time;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void WorkerPool::run_on_every_worker(const std::function<void(int)> &task){
+    _worker_task = &task;
+    _barrier->arrive_and_wait();
+    task(0);
+    _barrier->arrive_and_wait();
+    _worker_task = NULL;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void WorkerPool::work(int worker){
+    while(_barrier->arrive_and_wait() == true){
+        if(_worker_task){
+            (*_worker_task)(worker);
+        }
+        else{
+            process(worker);
+        }
+        _barrier->arrive_and_wait();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void WorkerPool::process(int worker){
+    WorkerQueue &queue = _queues[worker];
+    int victim = worker;
+
+    while(true){
+        int64_t task = take(worker);
+        bool stolen = false;
+
+        /* Steal from the other workers in a fixed order, starting with the next one */
+        while(task < 0){
+            victim = (victim + 1) % _worker_number;
+            if(victim == worker){
+                return;
+            }
+            task = steal(victim);
+            stolen = true;
+        }
+
+        uint64_t start_time = now_nanosec();
+        (*_tasks)[task]();
+        queue._busy_time += now_nanosec() - start_time;
+        queue._tasks++;
+        queue._stolen_tasks += stolen;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int64_t WorkerPool::take(int worker){
+    std::atomic<uint64_t> &range = _queues[worker]._range;
+    uint64_t current = range.load(std::memory_order_relaxed);
+
+    while(true){
+        uint32_t begin = current & 0xFFFFFFFF;
+        uint32_t end = current >> 32;
+        if(begin >= end){
+            return -1;
+        }
+        if(range.compare_exchange_weak(current, pack_range(begin + 1, end), std::memory_order_relaxed)){
+            return begin;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int64_t WorkerPool::steal(int victim){
+    std::atomic<uint64_t> &range = _queues[victim]._range;
+    uint64_t current = range.load(std::memory_order_relaxed);
+
+    while(true){
+        uint32_t begin = current & 0xFFFFFFFF;
+        uint32_t end = current >> 32;
+        if(begin >= end){
+            return -1;
+        }
+        if(range.compare_exchange_weak(current, pack_range(begin, end - 1), std::memory_order_relaxed)){
+            return end - 1;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int WorkerPool::pin_workers(const std::vector<int> &cpus){
+    if(cpus.empty()){
+        return ERROR_CODE;
+    }
+
+    int result = SUCCESS_CODE;
+    for(int i=0; i<_worker_number; i++){
+        std::vector<int> cpu(1, cpus[i % cpus.size()]);
+        int pinned = (i == 0) ? CpuPlacement::pin_current_thread(cpu)
+                              : CpuPlacement::pin_thread(_threads[i-1].native_handle(), cpu);
+        if(pinned == ERROR_CODE){
+            result = ERROR_CODE;
+            continue;
+        }
+        _worker_cpus[i] = cpu[0];
+    }
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int WorkerPool::set_fifo_priority(int priority){
+    int result = SUCCESS_CODE;
+    int error = 0;
+    for(int i=0; i<_worker_number; i++){
+        int applied = (i == 0) ? RealtimeProfile::set_current_fifo_priority(priority)
+                               : RealtimeProfile::set_fifo_priority(_threads[i-1].native_handle(), priority);
+        if(applied == ERROR_CODE){
+            result = ERROR_CODE;
+            error = errno;
+        }
+    }
+    errno = error;
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int WorkerPool::worker_cpu(int worker) const{
+    return _worker_cpus[worker];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+int WorkerPool::worker_number() const{
+    return _worker_number;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+WorkerStatistics WorkerPool::statistics(int worker) const{
+    WorkerStatistics statistics;
+    statistics._busy_time = _queues[worker]._busy_time;
+    statistics._tasks = _queues[worker]._tasks;
+    statistics._stolen_tasks = _queues[worker]._stolen_tasks;
+    return statistics;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+float WorkerPool::utilization(int worker) const{
+    if(_run_time == 0){
+        return 0.0f;
+    }
+    return (float)_queues[worker]._busy_time / _run_time;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void WorkerPool::print_statistics() const{
+    for(int i=0; i<_worker_number; i++){
+        std::cout << "[INFO] Worker " << i << " was busy " << std::fixed << std::setprecision(1)
+                  << 100.0f * utilization(i) << "% of the step time and ran " << _queues[i]._tasks
+                  << " tasks, " << _queues[i]._stolen_tasks << " of them stolen." << std::endl;
+    }
+}
+
+} //namespace COGNA
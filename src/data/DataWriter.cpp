@@ -118,7 +118,9 @@ namespace COGNA{
         int connection_param_gap_size = 32;
         int network_param_gap_size = connection_param_gap_size + 11;
 
-        if(nn->_curr_connections.size() > 0){
+        nn->store_compiled_state();
+
+        if(nn->_curr_neurons.size() > 0){
             for(unsigned int n=1; n<nn->_neurons.size(); n++){
                 /* SAVING NEURONS */
                 _output << nn->get_step_count() << ",";
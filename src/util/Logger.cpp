@@ -24,6 +24,7 @@ Logger *Logger::global_instance = nullptr;
 //
 Logger *Logger::init_Global(Logger *new_logger) {
     Logger::global_instance = new_logger;
+    return Logger::global_instance;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -15,11 +15,16 @@
 #define BUFFER_SIZE 1024
 #endif //BUFFER_SIZE
 
+#ifndef RECEIVE_TIMEOUT_MS
+#define RECEIVE_TIMEOUT_MS 100
+#endif //RECEIVE_TIMEOUT_MS
+
 namespace utils{
 
 networking_client::networking_client(std::string ip, int port, bool is_json){
 	_receiver = new udp_client_server::udp_server(ip, port);
 	_is_json = is_json;
+	_receiving = true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -43,28 +48,44 @@ int networking_client::get_port(){
 //----------------------------------------------------------------------------------------------------------------------
 //
 void networking_client::receive_message(){
-	while(true){
-		char *temp_msg = (char*)malloc(BUFFER_SIZE);
-		_receiver->recv(temp_msg, BUFFER_SIZE);
+	char temp_msg[BUFFER_SIZE];
+	while(_receiving){
+		int length = _receiver->timed_recv(temp_msg, BUFFER_SIZE - 1, RECEIVE_TIMEOUT_MS);
+		if(length < 0){
+			continue;
+		}
+		temp_msg[length] = '\0';
+		std::lock_guard<std::mutex> lock(_msg_lock);
 		_msg = temp_msg;
-		free(temp_msg);
-		temp_msg = NULL;
 	}
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+//
+void networking_client::stop_receiving(){
+	_receiving = false;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 //
 void networking_client::store_message(){
+	std::unique_lock<std::mutex> lock(_msg_lock, std::try_to_lock);
+	if(lock.owns_lock() == false || _msg.empty()){
+		return;
+	}
+	/* Taking the message clears it, both strings keep their memory for the next messages */
+	_stored_message.swap(_msg);
+	_msg.clear();
+	lock.unlock();
+
 	if(_is_json){
 		try{
-			_hashtable = nlohmann::json::parse(_msg);
+			_hashtable = nlohmann::json::parse(_stored_message);
 		}
 		catch(...){
 			// std::cout << "[ERROR] Could not parse message to json hashtable." << std::endl;
 		}
 	}
-
-	_stored_message = _msg;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -84,13 +105,14 @@ std::string networking_client::get_message(int indent){
 
 //----------------------------------------------------------------------------------------------------------------------
 //
-nlohmann::json networking_client::get_json_value(std::string key){
+nlohmann::json networking_client::get_json_value(const std::string &key){
 	if(_is_json){
-		auto return_value = _hashtable[key];
-		if(return_value.is_null()){
-			return_value = 0;
+		/* find() does not insert missing keys like operator[] does */
+		auto return_value = _hashtable.find(key);
+		if(return_value == _hashtable.end() || return_value->is_null()){
+			return 0;
 		}
-		return return_value;
+		return *return_value;
 	}
 
 	return 0;
@@ -110,8 +132,7 @@ nlohmann::json networking_client::get_hashtable(){
 //
 void networking_client::clear_message(){
 	_hashtable.clear();
-	_stored_message = "";
-	_msg = "";
+	_stored_message.clear();
 }
 
 } //namespace utils
@@ -22,11 +22,15 @@ namespace utils{
 //
 networking_sender::networking_sender(std::string ip, int port){
 	_sender = new udp_client_server::udp_client(ip, port);
+	_serialized.reserve(BUFFER_SIZE);
+	_serializer = new nlohmann::detail::serializer<nlohmann::json>(
+		std::make_shared<nlohmann::detail::output_string_adapter<char, std::string>>(_serialized), ' ');
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 //
 networking_sender::~networking_sender(){
+	delete _serializer;
 	delete _sender;
 }
 
@@ -44,25 +48,33 @@ int networking_sender::get_port(){
 
 //----------------------------------------------------------------------------------------------------------------------
 //
-void networking_sender::add_data(std::string key, float value){
+void networking_sender::add_data(const std::string &key, float value){
 	std::lock_guard<std::mutex> guard(_payload_mutex);
-	if(_payload.find(key) == _payload.end()){
+	auto entry = _payload.find(key);
+	if(entry == _payload.end()){
 		_payload[key] = value;
 	}
+	else if(entry->is_null()){
+		*entry = value;
+	}
 	else{
-		_payload[key] = (float)_payload[key] + value;
+		*entry = (float)*entry + value;
 	}
 }
-void networking_sender::add_data(std::string key, int value){
+void networking_sender::add_data(const std::string &key, int value){
 	std::lock_guard<std::mutex> guard(_payload_mutex);
-	if(_payload.find(key) == _payload.end()){
+	auto entry = _payload.find(key);
+	if(entry == _payload.end()){
 		_payload[key] = value;
 	}
+	else if(entry->is_null()){
+		*entry = value;
+	}
 	else{
-		_payload[key] = (int)_payload[key] + value;
+		*entry = (int)*entry + value;
 	}
 }
-void networking_sender::add_data(std::string key, std::string value){
+void networking_sender::add_data(const std::string &key, std::string value){
 	std::lock_guard<std::mutex> guard(_payload_mutex);
 	_payload[key] = value;
 }
@@ -82,7 +94,9 @@ void networking_sender::clear_payload(){
 //----------------------------------------------------------------------------------------------------------------------
 //
 std::string networking_sender::stringify_payload(int indent){
-	return _payload.dump(indent);
+	nlohmann::json payload = _payload;
+	remove_sent_data(payload);
+	return payload.dump(indent);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -90,9 +104,29 @@ std::string networking_sender::stringify_payload(int indent){
 void networking_sender::send_payload(){
 	auto time_in_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 	_payload["time"] = (long long)time_in_ms;
-	std::string stringified_payload = _payload.dump();
-	_sender->send(stringified_payload.c_str(), stringified_payload.size());
-	clear_payload();
+	remove_sent_data(_payload);
+
+	_serialized.clear();
+	_serializer->dump(_payload, false, false, 0);
+	_sender->send(_serialized.c_str(), _serialized.size());
+
+	/* The keys stay in the payload, so adding them again with the next payload does not allocate */
+	for(auto entry = _payload.begin(); entry != _payload.end(); entry++){
+		*entry = nullptr;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//
+void networking_sender::remove_sent_data(nlohmann::json &payload){
+	for(auto entry = payload.begin(); entry != payload.end();){
+		if(entry->is_null()){
+			entry = payload.erase(entry);
+		}
+		else{
+			entry++;
+		}
+	}
 }
 
 } //namespace utils
@@ -0,0 +1,512 @@
+#include "DataflowScheduler.hpp"
+#include "NeuralNetwork.hpp"
+#include "WorkerPool.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace COGNA;
+
+const int FAN_OUT_FIXED = 0;
+const int FAN_OUT_UNIFORM = 1;
+const int FAN_OUT_POWER = 2;            // Pareto tail with exponent 2, a few neurons reach many targets
+
+/**
+ * @brief Parameters of the synthetic cluster and of the sweep.
+ *
+ */
+struct BenchConfig{
+    std::vector<int> _neuron_numbers;   /**< Neurons of the whole cluster, one run per entry */
+    std::vector<int> _thread_numbers;   /**< Workers, one run per entry */
+    int _networks;                      /**< Networks the neurons are split into */
+    double _fan_out;                    /**< Mean number of targets of a neuron */
+    int _fan_out_distribution;
+    double _presynaptic_fraction;       /**< Connections targeting a connection instead of a neuron */
+    double _cross_fraction;             /**< Connections targeting a neuron of another network */
+    double _learning_mix[4];            /**< Fractions of LEARNING_NONE, HABITUATION, SENSITIZATION, HABISENS */
+    int _transmitters;
+    double _random_fraction;            /**< Neurons firing at random */
+    int _random_chance;                 /**< Such a neuron fires with (chance + 1) / MAX_CHANCE per step */
+    int _steps;
+    int _warmup_steps;
+    bool _dataflow;
+    bool _csv;
+    unsigned int _seed;
+};
+
+/**
+ * @brief Results of a single run.
+ *
+ */
+struct BenchResult{
+    double _build_time;                 /**< Seconds */
+    double _step_time;                  /**< Seconds, without the warmup steps */
+    uint64_t _connections;
+    uint64_t _fired_neurons;
+    uint64_t _fired_connections;
+    long _peak_rss;                     /**< Kilobytes */
+};
+
+/***********************************************************
+ * parse_int_list()
+ *
+ * Description: Parses a list like "1000,10000".
+ *
+ * Return:  int     Error code
+ */
+int parse_int_list(const std::string &text, std::vector<int> &values){
+    std::stringstream text_stream(text);
+    std::string value;
+    values.clear();
+    while(std::getline(text_stream, value, ',')){
+        if(value == "" || value.find_first_not_of("0123456789") != std::string::npos || value.size() > 9){
+            return ERROR_CODE;
+        }
+        values.push_back(std::stoi(value));
+        if(values.back() <= 0){
+            return ERROR_CODE;
+        }
+    }
+    return values.empty() ? ERROR_CODE : SUCCESS_CODE;
+}
+
+/***********************************************************
+ * parse_arguments()
+ *
+ * Description: Reads arguments like --neurons=1000,10000 into the configuration.
+ *
+ * Return:  int     Error code
+ */
+int parse_arguments(int argc, char **argv, BenchConfig &config){
+    for(int i=1; i<argc; i++){
+        std::string argument = argv[i];
+        size_t equal = argument.find('=');
+        if(argument.compare(0, 2, "--") != 0 || equal == std::string::npos){
+            fprintf(stderr, "[ERROR] Invalid argument %s.\n", argv[i]);
+            return ERROR_CODE;
+        }
+        std::string key = argument.substr(2, equal - 2);
+        std::string value = argument.substr(equal + 1);
+
+        int result = SUCCESS_CODE;
+        try{
+            if(key == "neurons"){
+                result = parse_int_list(value, config._neuron_numbers);
+            }
+            else if(key == "threads"){
+                result = parse_int_list(value, config._thread_numbers);
+            }
+            else if(key == "networks"){
+                config._networks = std::stoi(value);
+            }
+            else if(key == "fan_out"){
+                config._fan_out = std::stod(value);
+            }
+            else if(key == "fan_out_distribution"){
+                if(value == "fixed") config._fan_out_distribution = FAN_OUT_FIXED;
+                else if(value == "uniform") config._fan_out_distribution = FAN_OUT_UNIFORM;
+                else if(value == "power") config._fan_out_distribution = FAN_OUT_POWER;
+                else result = ERROR_CODE;
+            }
+            else if(key == "presynaptic_fraction"){
+                config._presynaptic_fraction = std::stod(value);
+            }
+            else if(key == "cross_fraction"){
+                config._cross_fraction = std::stod(value);
+            }
+            else if(key == "learning_mix"){
+                std::stringstream text_stream(value);
+                std::string fraction;
+                int l = 0;
+                while(std::getline(text_stream, fraction, ',') && l < 4){
+                    config._learning_mix[l++] = std::stod(fraction);
+                }
+                result = (l == 4) ? SUCCESS_CODE : ERROR_CODE;
+            }
+            else if(key == "transmitters"){
+                config._transmitters = std::stoi(value);
+            }
+            else if(key == "random_fraction"){
+                config._random_fraction = std::stod(value);
+            }
+            else if(key == "random_chance"){
+                config._random_chance = std::stoi(value);
+            }
+            else if(key == "steps"){
+                config._steps = std::stoi(value);
+            }
+            else if(key == "warmup_steps"){
+                config._warmup_steps = std::stoi(value);
+            }
+            else if(key == "dataflow"){
+                config._dataflow = std::stoi(value) != 0;
+            }
+            else if(key == "csv"){
+                config._csv = std::stoi(value) != 0;
+            }
+            else if(key == "seed"){
+                config._seed = std::stoul(value);
+            }
+            else{
+                result = ERROR_CODE;
+            }
+        }
+        catch(...){
+            result = ERROR_CODE;
+        }
+
+        if(result == ERROR_CODE){
+            fprintf(stderr, "[ERROR] Invalid argument %s.\n", argv[i]);
+            return ERROR_CODE;
+        }
+    }
+
+    double learning_total = 0.0;
+    for(int l=0; l<4; l++){
+        if(config._learning_mix[l] < 0.0){
+            learning_total = -1.0;
+            break;
+        }
+        learning_total += config._learning_mix[l];
+    }
+    if(learning_total <= 0.0 || config._networks <= 0 || config._fan_out < 1.0 || config._transmitters <= 0 || config._steps <= 0 ||
+       config._warmup_steps < 0 || config._random_chance < 0 || config._random_chance >= MAX_CHANCE ||
+       config._presynaptic_fraction < 0.0 || config._cross_fraction < 0.0 || config._random_fraction < 0.0){
+        fprintf(stderr, "[ERROR] Invalid configuration.\n");
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
+
+/***********************************************************
+ * draw_fan_out()
+ *
+ * Description: Draws the number of targets of a neuron with the configured distribution and mean.
+ *
+ * Return:  int     Number of targets, at least 1
+ */
+int draw_fan_out(const BenchConfig &config, std::mt19937 &rng, int max_fan_out){
+    int fan_out = 1;
+    if(config._fan_out_distribution == FAN_OUT_FIXED){
+        fan_out = (int)std::lround(config._fan_out);
+    }
+    else if(config._fan_out_distribution == FAN_OUT_UNIFORM){
+        std::uniform_int_distribution<int> uniform(1, (int)std::lround(2.0 * config._fan_out) - 1);
+        fan_out = uniform(rng);
+    }
+    else{
+        /* Pareto with exponent 2 and minimum m has the mean 2m */
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        fan_out = (int)(config._fan_out / 2.0 / std::sqrt(1.0 - uniform(rng)));
+    }
+    if(fan_out < 1){
+        fan_out = 1;
+    }
+    return (fan_out > max_fan_out) ? max_fan_out : fan_out;
+}
+
+/***********************************************************
+ * draw_learning_type()
+ *
+ * Description: Draws a learning type with the configured mix.
+ *
+ * Return:  int     The learning type
+ */
+int draw_learning_type(const BenchConfig &config, std::mt19937 &rng){
+    double total = 0.0;
+    for(int l=0; l<4; l++){
+        total += config._learning_mix[l];
+    }
+    double value = std::uniform_real_distribution<double>(0.0, total)(rng);
+    for(int l=0; l<3; l++){
+        if(value < config._learning_mix[l]){
+            return LEARNING_NONE + l;
+        }
+        value -= config._learning_mix[l];
+    }
+    return LEARNING_HABISENS;
+}
+
+/***********************************************************
+ * build_cluster()
+ *
+ * Description: Builds a cluster of networks with random connections through the NeuralNetwork API.
+ *              Every network has neurons / networks neurons. Neurons fire at random, at neurons of
+ *              their own network, at connections and at neurons of other networks.
+ *
+ * Return:  std::vector<NeuralNetwork*>     The cluster indexed by network ID
+ */
+std::vector<NeuralNetwork*> build_cluster(const BenchConfig &config, int neuron_number, uint64_t &connection_number,
+                                          std::vector<std::vector<uint32_t>> &fan_outs){
+    std::mt19937 rng(config._seed);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::uniform_real_distribution<float> weight(0.4f, 1.2f);
+    std::uniform_real_distribution<float> threshold(0.8f, 1.2f);
+    int network_neurons = neuron_number / config._networks;
+    if(network_neurons < 2){
+        network_neurons = 2;
+    }
+
+    std::vector<NeuralNetwork*> networks;
+    for(int i=0; i<config._networks; i++){
+        Neuron::s_max_id = 0;
+        NeuralNetwork *nn = new NeuralNetwork();
+        nn->define_transmitters(config._transmitters);
+        for(int n=1; n<=network_neurons; n++){
+            nn->add_neuron(threshold(rng));
+            if(chance(rng) < config._random_fraction){
+                nn->set_random_neuron_activation(n, config._random_chance, 2.0f);
+            }
+            if(config._transmitters > 1 && n % 100 == 0){
+                nn->set_neural_transmitter_influence(n, rng() % config._transmitters);
+            }
+        }
+        networks.push_back(nn);
+    }
+
+    connection_number = 0;
+    fan_outs.assign(config._networks, std::vector<uint32_t>(network_neurons + 1, 0));
+    std::vector<int> targets;
+    for(int i=0; i<config._networks; i++){
+        NeuralNetwork *nn = networks[i];
+        std::vector<Connection*> connections;
+        for(int n=1; n<=network_neurons; n++){
+            int fan_out = draw_fan_out(config, rng, network_neurons - 1);
+            targets.clear();
+            while((int)targets.size() < fan_out){
+                int target = 1 + rng() % network_neurons;
+                bool duplicate = (target == n);
+                for(unsigned int t=0; t<targets.size() && duplicate == false; t++){
+                    duplicate = (targets[t] == target);
+                }
+                if(duplicate == false){
+                    targets.push_back(target);
+                }
+            }
+
+            for(unsigned int t=0; t<targets.size(); t++){
+                int connection_type = (rng() % 5 == 0) ? INHIBITORY : EXCITATORY;
+                int learning_type = draw_learning_type(config, rng);
+                int transmitter = rng() % config._transmitters;
+                Connection *connection = NULL;
+                if(config._networks > 1 && chance(rng) < config._cross_fraction){
+                    NeuralNetwork *other = networks[(i + 1 + rng() % (config._networks - 1)) % config._networks];
+                    connection = nn->add_neuron_connection(n, other->_neurons[targets[t]], weight(rng),
+                                                           connection_type, FUNCTION_RELU, learning_type, transmitter);
+                }
+                else if(connections.empty() == false && chance(rng) < config._presynaptic_fraction){
+                    connection = nn->add_synaptic_connection(n, connections[rng() % connections.size()], weight(rng),
+                                                             connection_type, FUNCTION_RELU, learning_type, transmitter);
+                }
+                else{
+                    connection = nn->add_neuron_connection(n, targets[t], weight(rng), connection_type, FUNCTION_RELU,
+                                                           learning_type, transmitter);
+                    connections.push_back(connection);
+                }
+                if(connection){
+                    fan_outs[i][n]++;
+                    connection_number++;
+                }
+            }
+        }
+    }
+
+    std::vector<NeuralNetwork*> network_list(networks.back()->_id + 1, NULL);
+    for(unsigned int i=0; i<networks.size(); i++){
+        network_list[networks[i]->_id] = networks[i];
+    }
+    for(unsigned int i=0; i<networks.size(); i++){
+        networks[i]->setup_network();
+        networks[i]->set_random_seed(config._seed);
+    }
+    for(unsigned int i=0; i<networks.size(); i++){
+        if(networks[i]->compile_network(network_list) == ERROR_CODE){
+            /* The object graph is slower by far, its numbers must not pass as compiled ones */
+            fprintf(stderr, "[ERROR] Compiling NN-%d failed.\n", networks[i]->_id);
+            _exit(ERROR_CODE);
+        }
+    }
+    return network_list;
+}
+
+/***********************************************************
+ * run_cluster()
+ *
+ * Description: Builds a cluster and steps it like the CognaLauncher does. Only the steps are timed,
+ *              the fired neurons are counted between them.
+ *
+ * Return:  BenchResult     The measurements
+ */
+BenchResult run_cluster(const BenchConfig &config, int neuron_number, int thread_number){
+    BenchResult result;
+    std::vector<std::vector<uint32_t>> fan_outs;
+    auto build_start = std::chrono::steady_clock::now();
+    std::vector<NeuralNetwork*> network_list = build_cluster(config, neuron_number, result._connections, fan_outs);
+    result._build_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - build_start).count();
+
+    std::vector<NeuralNetwork*> networks;
+    for(unsigned int i=0; i<network_list.size(); i++){
+        if(network_list[i]){
+            networks.push_back(network_list[i]);
+        }
+    }
+
+    WorkerPool pool(thread_number);
+    DataflowScheduler *scheduler = config._dataflow ? new DataflowScheduler(network_list, &pool) : NULL;
+    std::vector<std::function<void()>> tasks;
+    for(unsigned int i=0; i<networks.size(); i++){
+        NeuralNetwork *network = networks[i];
+        tasks.push_back([network, &network_list](){ network->feed_forward(network_list); });
+    }
+
+    std::vector<std::vector<uint32_t>> fired(networks.size());
+    result._step_time = 0.0;
+    for(int step=0; step<config._warmup_steps + config._steps; step++){
+        auto step_start = std::chrono::steady_clock::now();
+        if(scheduler){
+            scheduler->run(1);
+        }
+        else{
+            pool.run(tasks);
+        }
+        if(step < config._warmup_steps){
+            continue;
+        }
+        result._step_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - step_start).count();
+        for(unsigned int i=0; i<networks.size(); i++){
+            networks[i]->count_fired_neurons(fired[i]);
+        }
+    }
+
+    result._fired_neurons = 0;
+    result._fired_connections = 0;
+    for(unsigned int i=0; i<networks.size(); i++){
+        for(unsigned int n=0; n<fired[i].size() && n<fan_outs[i].size(); n++){
+            result._fired_neurons += fired[i][n];
+            result._fired_connections += (uint64_t)fired[i][n] * fan_outs[i][n];
+        }
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    result._peak_rss = usage.ru_maxrss;
+
+    delete scheduler;
+    return result;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Sweeps the sizes and thread numbers of a synthetic cluster and reports the
+ *              throughput of the steps. Every run builds its cluster in its own process, so the
+ *              peak RSS belongs to that run only. The results go to stderr.
+ *              The defaults are a short run, make benchmark_sweep runs the larger sizes.
+ *
+ * Return:  int     Error code of program
+ */
+int main(int argc, char **argv){
+    BenchConfig config;
+    config._neuron_numbers = {10000};
+    config._thread_numbers = {1, 2};
+    config._networks = 8;
+    config._fan_out = 8.0;
+    config._fan_out_distribution = FAN_OUT_POWER;
+    config._presynaptic_fraction = 0.05;
+    config._cross_fraction = 0.01;
+    config._learning_mix[0] = 0.7;
+    config._learning_mix[1] = 0.1;
+    config._learning_mix[2] = 0.1;
+    config._learning_mix[3] = 0.1;
+    config._transmitters = 2;
+    config._random_fraction = 0.05;
+    config._random_chance = 9;
+    config._steps = 100;
+    config._warmup_steps = 10;
+    config._dataflow = false;
+    config._csv = false;
+    config._seed = 42;
+    if(parse_arguments(argc, argv, config) == ERROR_CODE){
+        fprintf(stderr, "Arguments: --neurons=a,b --threads=a,b --networks=n --fan_out=mean "
+                        "--fan_out_distribution=fixed|uniform|power --presynaptic_fraction=f --cross_fraction=f "
+                        "--learning_mix=none,habituation,sensitization,habisens --transmitters=n --random_fraction=f "
+                        "--random_chance=c --steps=n --warmup_steps=n --dataflow=0|1 --csv=0|1 --seed=s\n");
+        return ERROR_CODE;
+    }
+
+    if(config._csv){
+        fprintf(stderr, "neurons,threads,connections,build_s,steps_per_s,fired_neurons_per_step,"
+                        "fired_connections_per_step,ns_per_fired_connection,peak_rss_kb\n");
+    }
+    else{
+        fprintf(stderr, "%10s %8s %12s %10s %12s %14s %16s %14s %14s\n", "neurons", "threads", "connections",
+                "build [s]", "steps [1/s]", "fired neurons", "fired conn.", "[ns/fired con]", "peak RSS [MB]");
+    }
+
+    for(unsigned int s=0; s<config._neuron_numbers.size(); s++){
+        for(unsigned int t=0; t<config._thread_numbers.size(); t++){
+            int neuron_number = config._neuron_numbers[s];
+            int thread_number = config._thread_numbers[t];
+            int result_pipe[2];
+            if(pipe(result_pipe) != 0){
+                fprintf(stderr, "[ERROR] Could not create pipe.\n");
+                return ERROR_CODE;
+            }
+
+            fflush(stdout);
+            fflush(stderr);
+            pid_t child = fork();
+            if(child < 0){
+                fprintf(stderr, "[ERROR] Could not start run.\n");
+                return ERROR_CODE;
+            }
+            if(child == 0){
+                close(result_pipe[0]);
+                BenchResult result = run_cluster(config, neuron_number, thread_number);
+                ssize_t written = write(result_pipe[1], &result, sizeof(result));
+                fflush(stdout);
+                /* The networks are freed with the process, deleting them would only take time */
+                _exit(written == (ssize_t)sizeof(result) ? SUCCESS_CODE : 1);
+            }
+
+            close(result_pipe[1]);
+            BenchResult result;
+            ssize_t received = read(result_pipe[0], &result, sizeof(result));
+            close(result_pipe[0]);
+            int status = 0;
+            waitpid(child, &status, 0);
+            if(received != (ssize_t)sizeof(result) || WIFEXITED(status) == false || WEXITSTATUS(status) != 0){
+                fprintf(stderr, "[ERROR] Run with %d neurons and %d threads failed.\n", neuron_number, thread_number);
+                return ERROR_CODE;
+            }
+
+            double steps_per_second = config._steps / result._step_time;
+            double fired_neurons = (double)result._fired_neurons / config._steps;
+            double fired_connections = (double)result._fired_connections / config._steps;
+            double ns_per_connection = (result._fired_connections > 0)
+                                       ? result._step_time * 1e9 / result._fired_connections : 0.0;
+            if(config._csv){
+                fprintf(stderr, "%d,%d,%lu,%.3f,%.1f,%.1f,%.1f,%.2f,%ld\n", neuron_number, thread_number,
+                        (unsigned long)result._connections, result._build_time, steps_per_second, fired_neurons,
+                        fired_connections, ns_per_connection, result._peak_rss);
+            }
+            else{
+                fprintf(stderr, "%10d %8d %12lu %10.2f %12.1f %14.1f %16.1f %14.2f %14.1f\n", neuron_number,
+                        thread_number, (unsigned long)result._connections, result._build_time, steps_per_second,
+                        fired_neurons, fired_connections, ns_per_connection, result._peak_rss / 1024.0);
+            }
+        }
+    }
+    return SUCCESS_CODE;
+}
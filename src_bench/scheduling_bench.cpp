@@ -0,0 +1,91 @@
+#include "NeuralNetwork.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace COGNA;
+
+const int TARGETS_PER_SOURCE = 4;
+const int MIN_FRONTIER = 256;
+const int MAX_FRONTIER = 32768;
+const int BENCH_ITERATIONS = 5;
+
+/***********************************************************
+ * build_burst_network()
+ *
+ * Description: Builds a network of source neurons each firing at random target neurons.
+ *              Activating all sources at once schedules about frontier target neurons in a
+ *              single step, which is the load a burst of inputs creates.
+ */
+NeuralNetwork* build_burst_network(int frontier){
+    std::mt19937 rng(frontier);
+    Neuron::s_max_id = 0;
+    NeuralNetwork *nn = new NeuralNetwork();
+
+    for(int n=0; n<2*frontier; n++){
+        nn->add_neuron(0.5f);
+    }
+    for(int source=1; source<=frontier; source++){
+        for(int c=0; c<TARGETS_PER_SOURCE; c++){
+            int target = frontier + 1 + rng()%frontier;
+            nn->add_neuron_connection(source, target, 1.0f);
+        }
+    }
+    nn->setup_network();
+    return nn;
+}
+
+/***********************************************************
+ * run_burst()
+ *
+ * Description: Activates all source neurons and runs the network until the burst faded.
+ *
+ * Return:  double     Mean time of a burst in microseconds
+ */
+double run_burst(NeuralNetwork *nn, int frontier){
+    std::vector<NeuralNetwork*> network_list;
+    auto start = std::chrono::steady_clock::now();
+
+    for(int i=0; i<BENCH_ITERATIONS; i++){
+        for(int source=1; source<=frontier; source++){
+            nn->init_activation(source, 1.0f);
+        }
+        nn->feed_forward(network_list);
+        nn->feed_forward(network_list);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / BENCH_ITERATIONS;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Measures how the scheduling of next neurons scales with the size of the frontier.
+ *              The debug output of the network goes to stdout, the results go to stderr.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    fprintf(stderr, "%10s %18s %18s %22s\n", "frontier", "object [us/burst]", "compiled [us/burst]", "compiled [ns/neuron]");
+
+    for(int frontier=MIN_FRONTIER; frontier<=MAX_FRONTIER; frontier*=2){
+        NeuralNetwork *object_nn = build_burst_network(frontier);
+        NeuralNetwork *compiled_nn = build_burst_network(frontier);
+        if(compiled_nn->compile_network(std::vector<NeuralNetwork*>()) == ERROR_CODE){
+            fprintf(stderr, "[ERROR] Compiling benchmark network failed.\n");
+            return ERROR_CODE;
+        }
+
+        double object_time = run_burst(object_nn, frontier);
+        double compiled_time = run_burst(compiled_nn, frontier);
+        fprintf(stderr, "%10d %18.1f %18.1f %22.1f\n", frontier, object_time, compiled_time,
+                compiled_time * 1000.0 / (frontier * TARGETS_PER_SOURCE));
+
+        delete object_nn;
+        delete compiled_nn;
+    }
+    return SUCCESS_CODE;
+}
@@ -1,5 +1,6 @@
 #include "NeuralNetwork.hpp"
 #include "HelperFunctions.hpp"
+#include "Trace.hpp"
 
 #include <cstdio>
 #include <ctime>
@@ -121,7 +122,7 @@ int main(){
 
         if(d_time >= TIME_BETWEEN_STEPS){
             start_time = utils::get_time_microsec(time);
-            if(COGNA::DEBUG_MODE && COGNA::DEB_BASE)
+            if(COGNA::Trace::enabled(COGNA::TRACE_BASE))
                 nn->print_activation();
 
             nn->feed_forward();
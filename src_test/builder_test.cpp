@@ -26,7 +26,17 @@ int main(int argc, char** argv){
     COGNA::CognaLauncher *cluster_launcher = new COGNA::CognaLauncher(cluster_builder->get_network_list(),
                                                                       cluster_builder->get_client_list(),
                                                                       cluster_builder->get_sender_list(),
-                                                                      cluster_builder->get_frequency());
+                                                                      cluster_builder->get_frequency(),
+                                                                      cluster_builder->get_worker_threads());
+    cluster_launcher->set_partition_profile_steps(cluster_builder->get_partition_profile_steps());
+    cluster_launcher->set_dataflow_scheduling(cluster_builder->get_dataflow_scheduling());
+    cluster_launcher->set_worker_cpus(cluster_builder->get_worker_cpus());
+    cluster_launcher->set_io_cpus(cluster_builder->get_io_cpus());
+    cluster_launcher->set_free_running(cluster_builder->get_free_running());
+    cluster_launcher->set_max_steps(cluster_builder->get_max_steps());
+    cluster_launcher->set_overrun_policy(cluster_builder->get_overrun_policy());
+    cluster_launcher->set_realtime(cluster_builder->get_realtime());
+    cluster_launcher->set_realtime_priority(cluster_builder->get_realtime_priority());
 
     delete cluster_builder;
     cluster_builder = nullptr;
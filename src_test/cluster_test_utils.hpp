@@ -0,0 +1,312 @@
+/**
+ * @file cluster_test_utils.hpp
+ * @author Cyril Marx (https://github.com/cycrus)
+ *
+ * @brief Builds random clusters and compares networks stepped in different ways.
+ *
+ * Shared by the tests checking that compiled, parallel and scheduled steps give the same
+ * results as the plain object graph.
+ *
+ */
+
+#ifndef INCLUDE_CLUSTER_TEST_UTILS_HPP
+#define INCLUDE_CLUSTER_TEST_UTILS_HPP
+
+#include "NeuralNetwork.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace COGNA{
+
+const int TEST_TRANSMITTER_NUMBER = 3;
+
+/**
+ * The form of a random cluster built by build_cluster().
+ */
+struct ClusterShape{
+    int network_number;
+    int neuron_number;                          // Neurons of every network
+    int connections_per_neuron;                 // Random connections inside the network of the neuron
+    int synaptic_connections;                   // Random synaptic connections inside every network
+    int link_synaptic_connections;              // Random synaptic connections along every link
+    bool self_connections;                      // Lets some neurons fire at themselves
+    bool transmitter_influences;                // Lets some neurons influence a transmitter
+    bool ring;                                  // Connects every neuron to the next one, so activity keeps circling
+    std::vector<std::pair<int, int>> links;     // Networks activating other networks, by their position in the cluster
+};
+
+/***********************************************************
+ * set_parameter()
+ *
+ * Description: Sets the learning parameters used by the aplysia test.
+ */
+inline void set_parameter(NeuralNetwork *nn){
+    nn->_parameter->activation_backfall_curvature = 1.00f;
+    nn->_parameter->activation_backfall_steepness = 0.047f;
+
+    nn->_parameter->short_habituation_curvature = 1.02f;
+    nn->_parameter->short_habituation_steepness = 0.09f;
+    nn->_parameter->short_sensitization_curvature = 1.02f;
+    nn->_parameter->short_sensitization_steepness = 0.09f;
+
+    nn->_parameter->long_habituation_curvature = 0.35f;
+    nn->_parameter->long_habituation_steepness = 0.00005f;
+    nn->_parameter->long_sensitization_curvature = 1.02f;
+    nn->_parameter->long_sensitization_steepness = 0.0001f;
+
+    nn->_parameter->short_dehabituation_steepness = 0.00005f;
+    nn->_parameter->short_desensitization_steepness = 0.00005f;
+
+    nn->_parameter->presynaptic_potential_curvature = 0.60f;
+    nn->_parameter->presynaptic_potential_steepness = 0.3f;
+    nn->_parameter->presynaptic_backfall_curvature = 1.00f;
+    nn->_parameter->presynaptic_backfall_steepness = 0.02f;
+
+    nn->_parameter->habituation_threshold = 2.0f;
+    nn->_parameter->sensitization_threshold = 4.0f;
+
+    nn->_parameter->transmitter_change_curvature = 1.02f;
+    nn->_parameter->transmitter_change_steepness = 0.02f;
+    nn->_parameter->transmitter_backfall_curvature = 1.00f;
+    nn->_parameter->transmitter_backfall_steepness = 0.001f;
+}
+
+/***********************************************************
+ * build_neurons()
+ *
+ * Description: Adds neurons with random thresholds and, if the shape allows it, transmitter influences.
+ */
+inline void build_neurons(NeuralNetwork *nn, const ClusterShape &shape, std::mt19937 &rng){
+    std::uniform_real_distribution<float> threshold(0.1f, 3.0f);
+    set_parameter(nn);
+    nn->define_transmitters(TEST_TRANSMITTER_NUMBER);
+
+    for(int n=1; n<=shape.neuron_number; n++){
+        nn->add_neuron(threshold(rng));
+        if(shape.transmitter_influences && rng()%8 == 0){
+            nn->set_neural_transmitter_influence(n, rng()%TEST_TRANSMITTER_NUMBER,
+                                                 rng()%2 ? POSITIVE_INFLUENCE : NEGATIVE_INFLUENCE);
+        }
+    }
+}
+
+/***********************************************************
+ * build_connections()
+ *
+ * Description: Randomly connects the neurons of a network with neurons of the target network.
+ *              Inside a network, a neuron only fires at itself if the shape allows it.
+ */
+inline void build_connections(NeuralNetwork *nn, NeuralNetwork *target, const ClusterShape &shape,
+                              std::mt19937 &rng, int number){
+    std::uniform_real_distribution<float> weight(0.2f, 2.0f);
+    const int functions[3] = {FUNCTION_SIGMOID, FUNCTION_LINEAR, FUNCTION_RELU};
+
+    for(int n=1; n<=shape.neuron_number; n++){
+        if(shape.ring && nn == target){
+            nn->add_neuron_connection(n, 1 + n%shape.neuron_number, 3.0f);
+        }
+        for(int c=0; c<number; c++){
+            int next = (shape.self_connections && nn == target && c == 0 && rng()%8 == 0) ?
+                       n : 1 + rng()%shape.neuron_number;
+            bool connected = (shape.self_connections == false && nn == target && next == n);
+            for(unsigned int i=0; i<nn->_neurons[n]->_connections.size(); i++){
+                if(nn->_neurons[n]->_connections[i]->next_neuron == target->_neurons[next]){
+                    connected = true;
+                }
+            }
+            if(connected){
+                continue;
+            }
+            nn->add_neuron_connection(n, target->_neurons[next], weight(rng),
+                                      rng()%4 ? EXCITATORY : INHIBITORY,
+                                      functions[rng()%3],
+                                      LEARNING_NONE + rng()%4,
+                                      rng()%TEST_TRANSMITTER_NUMBER);
+        }
+    }
+}
+
+/***********************************************************
+ * build_synaptic_connections()
+ *
+ * Description: Randomly connects neurons with neuron connections of the target network.
+ */
+inline void build_synaptic_connections(NeuralNetwork *nn, NeuralNetwork *target, const ClusterShape &shape,
+                                       std::mt19937 &rng, int number){
+    const int types[3] = {EXCITATORY, INHIBITORY, NONDIRECTIONAL};
+
+    for(int s=0; s<number; s++){
+        int source = 1 + rng()%shape.neuron_number;
+        Neuron *connected_neuron = target->_neurons[1 + rng()%shape.neuron_number];
+        if(connected_neuron->_connections.size() == 0 || connected_neuron == nn->_neurons[source]){
+            continue;
+        }
+        Connection *con = connected_neuron->_connections[rng()%connected_neuron->_connections.size()];
+        if(con->next_neuron == NULL){
+            continue;
+        }
+        bool connected = false;
+        for(unsigned int i=0; i<nn->_neurons[source]->_connections.size(); i++){
+            if(nn->_neurons[source]->_connections[i]->next_connection == con){
+                connected = true;
+            }
+        }
+        if(connected == false){
+            nn->add_synaptic_connection(source, con, 0.5f, types[rng()%3], FUNCTION_RELU, LEARNING_NONE);
+        }
+    }
+}
+
+/***********************************************************
+ * build_cluster()
+ *
+ * Description: Builds a cluster of random networks. Every link connects each neuron of its first
+ *              network with a neuron of its second one and adds synaptic connections between them.
+ *              The networks are set up and stored at the position of their ID, they are not compiled.
+ *
+ * Return:  std::vector<NeuralNetwork*>     The network list of the cluster
+ */
+inline std::vector<NeuralNetwork*> build_cluster(unsigned int seed, const ClusterShape &shape){
+    std::mt19937 rng(seed);
+    std::vector<NeuralNetwork*> networks;
+    for(int i=0; i<shape.network_number; i++){
+        Neuron::s_max_id = 0;
+        networks.push_back(new NeuralNetwork());
+        build_neurons(networks.back(), shape, rng);
+    }
+
+    for(unsigned int i=0; i<networks.size(); i++){
+        build_connections(networks[i], networks[i], shape, rng, shape.connections_per_neuron);
+    }
+    for(unsigned int l=0; l<shape.links.size(); l++){
+        build_connections(networks[shape.links[l].first], networks[shape.links[l].second], shape, rng, 1);
+    }
+    for(unsigned int i=0; i<networks.size(); i++){
+        build_synaptic_connections(networks[i], networks[i], shape, rng, shape.synaptic_connections);
+    }
+    for(unsigned int l=0; l<shape.links.size(); l++){
+        build_synaptic_connections(networks[shape.links[l].first], networks[shape.links[l].second], shape, rng,
+                                   shape.link_synaptic_connections);
+    }
+
+    std::vector<NeuralNetwork*> network_list(networks.back()->_id + 1, NULL);
+    for(unsigned int i=0; i<networks.size(); i++){
+        network_list[networks[i]->_id] = networks[i];
+    }
+    for(unsigned int i=0; i<networks.size(); i++){
+        networks[i]->setup_network();
+        networks[i]->reserve_deliveries(network_list);
+    }
+    return network_list;
+}
+
+/***********************************************************
+ * cluster_networks()
+ *
+ * Description: Collects the networks of a network list. Network IDs keep counting up, so the
+ *              networks of two clusters built alike are paired by their position in the result.
+ *
+ * Return:  std::vector<NeuralNetwork*>     The networks in ID order
+ */
+inline std::vector<NeuralNetwork*> cluster_networks(const std::vector<NeuralNetwork*> &network_list){
+    std::vector<NeuralNetwork*> networks;
+    for(unsigned int i=0; i<network_list.size(); i++){
+        if(network_list[i]){
+            networks.push_back(network_list[i]);
+        }
+    }
+    return networks;
+}
+
+/***********************************************************
+ * differs()
+ *
+ * Description: Compares two values bitwise or, with a tolerance, relative to the expected value.
+ */
+inline bool differs(float expected, float actual, float tolerance){
+    if(tolerance == 0.0f){
+        return memcmp(&expected, &actual, sizeof(float)) != 0;
+    }
+    return expected != actual && std::fabs(expected - actual) > tolerance * std::fabs(expected);
+}
+
+/***********************************************************
+ * compare_networks()
+ *
+ * Description: Compares the complete state of two networks, compiled networks store their state
+ *              first. Floats are compared bitwise if the tolerance is 0, all other values always.
+ *              Stops after a few differing neurons.
+ *
+ * Return:  int     Number of differences found
+ */
+inline int compare_networks(NeuralNetwork *expected, NeuralNetwork *actual, int step, float tolerance=0.0f){
+    expected->store_compiled_state();
+    actual->store_compiled_state();
+    int differences = 0;
+
+    if(expected->get_step_count() != actual->get_step_count()){
+        fprintf(stderr, "[ERROR] Step %d: NN-%d took %ld instead of %ld steps.\n", step, expected->_id,
+                (long)actual->get_step_count(), (long)expected->get_step_count());
+        differences++;
+    }
+
+    for(unsigned int n=0; n<expected->_neurons.size() && differences < 10; n++){
+        Neuron *a = expected->_neurons[n];
+        Neuron *b = actual->_neurons[n];
+        if(differs(a->_activation, b->_activation, tolerance) ||
+           differs(a->_next_activation, b->_next_activation, tolerance) ||
+           a->_was_activated != b->_was_activated || a->_last_activated_step != b->_last_activated_step ||
+           a->_last_fired_step != b->_last_fired_step){
+            fprintf(stderr, "[ERROR] Step %d: N-%d of NN-%d differs (activation %.9g vs %.9g)\n",
+                    step, n, expected->_id, a->_activation, b->_activation);
+            differences++;
+        }
+
+        for(unsigned int c=0; c<a->_connections.size(); c++){
+            Connection *x = a->_connections[c];
+            Connection *y = b->_connections[c];
+            if(differs(x->short_weight, y->short_weight, tolerance) ||
+               differs(x->long_weight, y->long_weight, tolerance) ||
+               differs(x->long_learning_weight, y->long_learning_weight, tolerance) ||
+               differs(x->presynaptic_potential, y->presynaptic_potential, tolerance) ||
+               x->last_activated_step != y->last_activated_step ||
+               x->last_presynaptic_activated_step != y->last_presynaptic_activated_step){
+                fprintf(stderr, "[ERROR] Step %d: Connection %d of N-%d in NN-%d differs (weight %.9g vs %.9g)\n",
+                        step, c, n, expected->_id, x->short_weight, y->short_weight);
+                differences++;
+            }
+        }
+    }
+
+    for(int t=0; t<TEST_TRANSMITTER_NUMBER; t++){
+        if(differs(expected->get_transmitter_weight(t), actual->get_transmitter_weight(t), tolerance)){
+            fprintf(stderr, "[ERROR] Step %d: T-%d of NN-%d differs\n", step, t, expected->_id);
+            differences++;
+        }
+    }
+
+    if(expected->_curr_neurons.size() != actual->_curr_neurons.size()){
+        fprintf(stderr, "[ERROR] Step %d: NN-%d schedules %lu instead of %lu neurons\n", step, expected->_id,
+                actual->_curr_neurons.size(), expected->_curr_neurons.size());
+        differences++;
+    }
+    else{
+        for(unsigned int n=0; n<expected->_curr_neurons.size(); n++){
+            if(expected->_curr_neurons[n]->_id != actual->_curr_neurons[n]->_id){
+                fprintf(stderr, "[ERROR] Step %d: Scheduled neuron %d of NN-%d differs\n", step, n, expected->_id);
+                differences++;
+                break;
+            }
+        }
+    }
+    return differences;
+}
+
+} //namespace COGNA
+
+#endif //INCLUDE_CLUSTER_TEST_UTILS_HPP
@@ -0,0 +1,232 @@
+#include "cluster_test_utils.hpp"
+#include "NeuralNetwork.hpp"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace COGNA;
+
+const int NEURON_NUMBER = 60;
+const int TEST_STEPS = 400;
+const float BATCH_LEARNING_TOLERANCE = 1e-5f;
+
+/* Two networks activating each other and firing at connections of each other */
+const ClusterShape CLUSTER_SHAPE = {2, NEURON_NUMBER, 4, 10, 10, false, true, false, {{0, 1}, {1, 0}}};
+
+/***********************************************************
+ * run_dense_cluster()
+ *
+ * Description: Runs a compiled cluster with dense steps only and checks that the
+ *              statistics report them and the activation still spreads.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_dense_cluster(){
+    int errors = 0;
+    std::vector<NeuralNetwork*> cluster = build_cluster(42, CLUSTER_SHAPE);
+    std::vector<NeuralNetwork*> networks;
+
+    for(unsigned int i=0; i<cluster.size(); i++){
+        if(cluster[i]){
+            networks.push_back(cluster[i]);
+            cluster[i]->_parameter->dense_frontier_threshold = 0.0f;
+            if(cluster[i]->compile_network(cluster) == ERROR_CODE){
+                fprintf(stderr, "[ERROR] Compiling NN-%d failed.\n", cluster[i]->_id);
+                return 1;
+            }
+        }
+    }
+
+    std::mt19937 input_rng(7);
+    for(int step=1; step<=TEST_STEPS; step++){
+        for(unsigned int i=0; i<networks.size(); i++){
+            networks[i]->init_activation(1 + input_rng()%NEURON_NUMBER, 5.0f);
+            networks[i]->feed_forward(cluster);
+        }
+    }
+
+    for(unsigned int i=0; i<networks.size(); i++){
+        NetworkStatistics &statistics = networks[i]->_statistics;
+        networks[i]->store_compiled_state();
+
+        int activated_neurons = 0;
+        for(unsigned int n=MIN_NEURON_ID; n<networks[i]->_neurons.size(); n++){
+            if(networks[i]->_neurons[n]->_last_activated_step > 0){
+                activated_neurons++;
+            }
+        }
+        if(statistics._dense_steps != TEST_STEPS || statistics._sparse_steps != 0 || activated_neurons < NEURON_NUMBER / 2){
+            fprintf(stderr, "[ERROR] NN-%d took %ld dense and %ld sparse steps and activated %d neurons.\n",
+                    networks[i]->_id, (long)statistics._dense_steps, (long)statistics._sparse_steps, activated_neurons);
+            errors++;
+        }
+        delete networks[i];
+    }
+    return errors;
+}
+
+/***********************************************************
+ * run_compared_clusters()
+ *
+ * Description: Runs the same cluster on the object graph and on the compiled network
+ *              and compares both in every step. With default parameters, the compiled
+ *              network keeps all parameters of a freshly built network.
+ *
+ * Return:  int     Number of differences found
+ */
+int run_compared_clusters(bool default_parameters, bool batch_learning, float tolerance){
+    int differences = 0;
+    std::vector<NeuralNetwork*> object_cluster = build_cluster(42, CLUSTER_SHAPE);
+    std::vector<NeuralNetwork*> compiled_cluster = build_cluster(42, CLUSTER_SHAPE);
+    std::vector<NeuralNetwork*> object_networks;
+    std::vector<NeuralNetwork*> compiled_networks;
+
+    /* Network IDs are global, so both clusters are stored at different positions of their lists. */
+    for(unsigned int i=0; i<object_cluster.size(); i++){
+        if(object_cluster[i]){
+            object_networks.push_back(object_cluster[i]);
+        }
+    }
+    for(unsigned int i=0; i<compiled_cluster.size(); i++){
+        if(compiled_cluster[i]){
+            compiled_networks.push_back(compiled_cluster[i]);
+            /* Dense steps visit the neurons in a different order, so they are tested separately */
+            if(default_parameters == false){
+                compiled_cluster[i]->_parameter->dense_frontier_threshold = 2.0f;
+                compiled_cluster[i]->_parameter->batch_learning = batch_learning;
+            }
+            if(compiled_cluster[i]->compile_network(compiled_cluster) == ERROR_CODE){
+                fprintf(stderr, "[ERROR] Compiling NN-%d failed.\n", compiled_cluster[i]->_id);
+                return 1;
+            }
+        }
+    }
+
+    std::mt19937 input_rng(7);
+    std::uniform_real_distribution<float> input_activation(0.5f, 5.0f);
+
+    for(int step=1; step<=TEST_STEPS && differences == 0; step++){
+        for(unsigned int i=0; i<object_networks.size(); i++){
+            int inputs = input_rng()%4;
+            for(int input=0; input<inputs; input++){
+                int target = 1 + input_rng()%NEURON_NUMBER;
+                float activation = input_activation(input_rng);
+                object_networks[i]->init_activation(target, activation);
+                compiled_networks[i]->init_activation(target, activation);
+            }
+        }
+
+        for(unsigned int i=0; i<object_networks.size(); i++){
+            object_networks[i]->feed_forward(object_cluster);
+            compiled_networks[i]->feed_forward(compiled_cluster);
+        }
+
+        for(unsigned int i=0; i<object_networks.size(); i++){
+            differences += compare_networks(object_networks[i], compiled_networks[i], step, tolerance);
+        }
+    }
+
+    /* Make sure the activation actually spread through the networks */
+    for(unsigned int i=0; i<object_networks.size(); i++){
+        int activated_neurons = 0;
+        for(unsigned int n=MIN_NEURON_ID; n<object_networks[i]->_neurons.size(); n++){
+            if(object_networks[i]->_neurons[n]->_last_activated_step > 0){
+                activated_neurons++;
+            }
+        }
+        if(activated_neurons < NEURON_NUMBER / 2){
+            fprintf(stderr, "[ERROR] Only %d neurons of NN-%d were activated.\n", activated_neurons,
+                    object_networks[i]->_id);
+            differences++;
+        }
+    }
+
+    for(unsigned int i=0; i<object_networks.size(); i++){
+        delete object_networks[i];
+        delete compiled_networks[i];
+    }
+
+    return differences;
+}
+
+/***********************************************************
+ * run_reversed_clusters()
+ *
+ * Description: Steps the networks of one compiled cluster in ascending and of another
+ *              in descending order. Networks only activate each other through their inbox,
+ *              so both clusters have to stay identical.
+ *
+ * Return:  int     Number of differences found
+ */
+int run_reversed_clusters(){
+    int differences = 0;
+    std::vector<NeuralNetwork*> forward_cluster = build_cluster(42, CLUSTER_SHAPE);
+    std::vector<NeuralNetwork*> reversed_cluster = build_cluster(42, CLUSTER_SHAPE);
+    std::vector<NeuralNetwork*> forward_networks;
+    std::vector<NeuralNetwork*> reversed_networks;
+
+    /* Network IDs are global, so both clusters are stored at different positions of their lists. */
+    for(unsigned int i=0; i<forward_cluster.size(); i++){
+        if(forward_cluster[i]){
+            forward_networks.push_back(forward_cluster[i]);
+            forward_cluster[i]->compile_network(forward_cluster);
+        }
+    }
+    for(unsigned int i=0; i<reversed_cluster.size(); i++){
+        if(reversed_cluster[i]){
+            reversed_networks.push_back(reversed_cluster[i]);
+            reversed_cluster[i]->compile_network(reversed_cluster);
+        }
+    }
+
+    std::mt19937 input_rng(11);
+    int network_number = forward_networks.size();
+    for(int step=1; step<=TEST_STEPS && differences == 0; step++){
+        for(int i=0; i<network_number; i++){
+            int target = 1 + input_rng()%NEURON_NUMBER;
+            forward_networks[i]->init_activation(target, 5.0f);
+            reversed_networks[i]->init_activation(target, 5.0f);
+        }
+
+        for(int i=0; i<network_number; i++){
+            forward_networks[i]->feed_forward(forward_cluster);
+            reversed_networks[network_number - 1 - i]->feed_forward(reversed_cluster);
+        }
+
+        for(int i=0; i<network_number; i++){
+            differences += compare_networks(forward_networks[i], reversed_networks[i], step);
+        }
+    }
+
+    for(int i=0; i<network_number; i++){
+        delete forward_networks[i];
+        delete reversed_networks[i];
+    }
+    return differences;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Runs the same cluster on the object graph and on the compiled network
+ *              and checks that both produce identical results in every step, also with the
+ *              default parameters. With batched learning the weights may differ by the
+ *              rounding of VectorMath::pow().
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    int differences = run_compared_clusters(true, false, 0.0f);
+    differences += run_compared_clusters(false, false, 0.0f);
+    differences += run_compared_clusters(false, true, BATCH_LEARNING_TOLERANCE);
+    differences += run_dense_cluster();
+    differences += run_reversed_clusters();
+
+    if(differences > 0){
+        fprintf(stderr, "[ERROR] Compiled network differs from the object graph.\n");
+        return ERROR_CODE;
+    }
+    fprintf(stderr, "Compiled network matches the object graph for %d steps.\n", TEST_STEPS);
+    return SUCCESS_CODE;
+}
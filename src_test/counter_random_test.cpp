@@ -0,0 +1,236 @@
+#include "CounterRandom.hpp"
+#include "NeuralNetwork.hpp"
+#include "RandomActivation.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace COGNA;
+
+const int RANDOM_NEURONS = 200;
+const int RANDOM_CHANCE = 49;           // (49 + 1) / 1000 per step
+const int TEST_STEPS = 500;
+
+/***********************************************************
+ * run_known_answers()
+ *
+ * Description: Compares blocks with the known answers of the Philox4x32-10 reference implementation.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_known_answers(){
+    struct KnownAnswer{
+        uint64_t seed;
+        uint32_t stream;
+        uint64_t counter;
+        uint32_t index;
+        uint32_t words[4];
+    };
+    const KnownAnswer answers[] = {
+        {0, 0, 0, 0, {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}},
+        {0xFFFFFFFFFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFF, {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+        {0x299f31d0a4093822, 0x03707344, 0x85a308d3243f6a88, 0x13198a2e, {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}
+    };
+
+    int errors = 0;
+    for(unsigned int i=0; i<sizeof(answers)/sizeof(answers[0]); i++){
+        CounterRandom random(answers[i].seed, answers[i].stream);
+        uint32_t words[4];
+        random.block(answers[i].counter, answers[i].index, words);
+        for(int w=0; w<4; w++){
+            if(words[w] != answers[i].words[w]){
+                fprintf(stderr, "[ERROR] Word %d of known answer %d is %08x instead of %08x.\n",
+                        w, i, words[w], answers[i].words[w]);
+                errors++;
+            }
+        }
+    }
+    return errors;
+}
+
+/***********************************************************
+ * run_distribution()
+ *
+ * Description: Checks that below() and uniform() are equally distributed over consecutive counters.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_distribution(){
+    const int bucket_number = 1000;
+    const int draws = 1000000;
+    CounterRandom random(12345, 7);
+    std::vector<int> buckets(bucket_number, 0);
+    double sum = 0.0;
+    int errors = 0;
+
+    for(int i=0; i<draws; i++){
+        uint32_t value = random.below(bucket_number, i / 100, i % 100);
+        if(value >= (uint32_t)bucket_number){
+            fprintf(stderr, "[ERROR] below() returned %u.\n", value);
+            return 1;
+        }
+        buckets[value]++;
+
+        double uniform = random.uniform(i / 100, i % 100);
+        if(uniform <= 0.0 || uniform > 1.0){
+            fprintf(stderr, "[ERROR] uniform() returned %.17g.\n", uniform);
+            return 1;
+        }
+        sum += uniform;
+    }
+
+    /* 1000 buckets have 999 degrees of freedom, their 99.99% quantile is about 1170 */
+    double expected = (double)draws / bucket_number;
+    double chi_square = 0.0;
+    for(int b=0; b<bucket_number; b++){
+        chi_square += (buckets[b] - expected) * (buckets[b] - expected) / expected;
+    }
+    printf("[INFO] Chi square of 1000 buckets is %.1f, mean of uniform() is %.5f.\n", chi_square, sum / draws);
+    if(chi_square > 1180.0){
+        fprintf(stderr, "[ERROR] below() is not equally distributed.\n");
+        errors++;
+    }
+    if(std::fabs(sum / draws - 0.5) > 0.002){
+        fprintf(stderr, "[ERROR] uniform() is not equally distributed.\n");
+        errors++;
+    }
+    return errors;
+}
+
+/***********************************************************
+ * run_waiting_times()
+ *
+ * Description: Checks that the waiting times between two random activations follow the
+ *              geometric distribution of a neuron firing with its chance in every step.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_waiting_times(){
+    const int bucket_number = 40;
+    const int draws = 1000000;
+    const double probability = (RANDOM_CHANCE + 1.0) / MAX_CHANCE;
+    CounterRandom random(99, 3);
+    std::vector<int> buckets(bucket_number + 1, 0);
+
+    int errors = 0;
+    for(int i=0; i<draws; i++){
+        int64_t wait = RandomActivation::next_step(random, i / 100, i % 100, RANDOM_CHANCE) - i / 100;
+        if(wait < 1){
+            fprintf(stderr, "[ERROR] Waiting time of %ld steps.\n", (long)wait);
+            return 1;
+        }
+        buckets[wait <= bucket_number ? wait - 1 : bucket_number]++;
+    }
+
+    /* The last bucket collects all longer waits, 40 degrees of freedom have a 99.99% quantile of about 80 */
+    double chi_square = 0.0;
+    for(int b=0; b<=bucket_number; b++){
+        double expected = draws * ((b < bucket_number) ? probability * std::pow(1.0 - probability, b)
+                                                       : std::pow(1.0 - probability, bucket_number));
+        chi_square += (buckets[b] - expected) * (buckets[b] - expected) / expected;
+    }
+    printf("[INFO] Chi square of the waiting times is %.1f.\n", chi_square);
+    if(chi_square > 80.0){
+        fprintf(stderr, "[ERROR] Waiting times are not geometrically distributed.\n");
+        errors++;
+    }
+
+    /* The highest chance fires in every step */
+    if(RandomActivation::next_step(random, 10, 1, MAX_CHANCE - 1) != 11){
+        fprintf(stderr, "[ERROR] Neuron with the highest chance does not fire in every step.\n");
+        errors++;
+    }
+    return errors;
+}
+
+/***********************************************************
+ * run_random_activation()
+ *
+ * Description: Steps a network of neurons which fire at random and checks that exactly the
+ *              neurons fire whose waiting times drawn from the stream of the network end.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_random_activation(uint64_t seed, std::vector<int64_t> &fired_steps){
+    Neuron::s_max_id = 0;
+    NeuralNetwork *nn = new NeuralNetwork();
+    for(int n=1; n<=RANDOM_NEURONS; n++){
+        nn->add_neuron(1.0f);
+        nn->set_random_neuron_activation(n, RANDOM_CHANCE, 2.0f);
+    }
+    std::vector<NeuralNetwork*> network_list(nn->_id + 1, NULL);
+    network_list[nn->_id] = nn;
+    nn->setup_network();
+    nn->set_random_seed(seed);
+    nn->compile_network(network_list);
+
+    /* Every neuron waits from the step it fired in last, the first time from step 0 */
+    CounterRandom expected_random(seed, nn->_id);
+    std::vector<int64_t> expected_steps(RANDOM_NEURONS + 1);
+    for(int n=1; n<=RANDOM_NEURONS; n++){
+        expected_steps[n] = RandomActivation::next_step(expected_random, 0, n, RANDOM_CHANCE);
+    }
+
+    int errors = 0;
+    for(int step=0; step<TEST_STEPS; step++){
+        nn->feed_forward(network_list);
+        nn->store_compiled_state();
+        for(int n=1; n<=RANDOM_NEURONS; n++){
+            bool fired = nn->_neurons[n]->_last_fired_step == nn->get_step_count();
+            bool expected = expected_steps[n] == nn->get_step_count();
+            if(expected){
+                expected_steps[n] = RandomActivation::next_step(expected_random, nn->get_step_count(), n, RANDOM_CHANCE);
+            }
+            if(fired != expected && errors < 10){
+                fprintf(stderr, "[ERROR] N-%d %s in step %ld.\n", n, fired ? "fired" : "did not fire",
+                        (long)nn->get_step_count());
+                errors++;
+            }
+            if(fired){
+                fired_steps.push_back(nn->get_step_count());
+                fired_steps.push_back(n);
+            }
+        }
+    }
+
+    delete nn;
+    return errors;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Checks the generator and that random activation only depends on the seed,
+ *              the network, the step and the neuron.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    int errors = run_known_answers();
+    errors += run_distribution();
+    errors += run_waiting_times();
+
+    std::vector<int64_t> first_run;
+    std::vector<int64_t> other_seed;
+    errors += run_random_activation(42, first_run);
+    errors += run_random_activation(43, other_seed);
+    if(first_run == other_seed){
+        fprintf(stderr, "[ERROR] Random activation is the same with another seed.\n");
+        errors++;
+    }
+
+    double rate = (double)(first_run.size() / 2) / (RANDOM_NEURONS * TEST_STEPS);
+    double expected_rate = (RANDOM_CHANCE + 1.0) / MAX_CHANCE;
+    printf("[INFO] Neurons were activated in %.4f of the steps, expected %.4f.\n", rate, expected_rate);
+    if(std::fabs(rate - expected_rate) > 0.005){
+        fprintf(stderr, "[ERROR] Random activation does not follow its chance.\n");
+        errors++;
+    }
+
+    if(errors > 0){
+        fprintf(stderr, "[ERROR] %d errors found.\n", errors);
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
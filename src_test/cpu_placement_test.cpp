@@ -0,0 +1,245 @@
+#include "CpuPlacement.hpp"
+#include "NetworkArena.hpp"
+#include "NeuralNetwork.hpp"
+#include "WorkerPool.hpp"
+
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/mempolicy.h>
+#include <vector>
+
+using namespace COGNA;
+
+/***********************************************************
+ * check_cpu_list()
+ *
+ * Description: Parses a CPU list and compares it to the expected CPUs. An empty expectation
+ *              means the list has to be rejected.
+ *
+ * Return:  int     Number of errors found
+ */
+int check_cpu_list(const char *text, const std::vector<int> &expected){
+    std::vector<int> cpus;
+    int result = CpuPlacement::parse_cpu_list(text, cpus);
+    if(expected.empty()){
+        if(result != ERROR_CODE){
+            fprintf(stderr, "[ERROR] Accepted invalid CPU list \"%s\".\n", text);
+            return 1;
+        }
+        return 0;
+    }
+    if(result != SUCCESS_CODE || cpus != expected){
+        fprintf(stderr, "[ERROR] CPU list \"%s\" is parsed wrong.\n", text);
+        return 1;
+    }
+    return 0;
+}
+
+/***********************************************************
+ * run_cpu_lists()
+ *
+ * Description: Checks parsing and formatting of CPU lists.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_cpu_lists(){
+    int errors = check_cpu_list("0-3,8,10-11", {0, 1, 2, 3, 8, 10, 11});
+    errors += check_cpu_list(" 5 , 1-2,2", {1, 2, 5});
+    errors += check_cpu_list("7", {7});
+    errors += check_cpu_list("", {});
+    errors += check_cpu_list("3-1", {});
+    errors += check_cpu_list("1-", {});
+    errors += check_cpu_list("-1", {});
+    errors += check_cpu_list("1,,2", {});
+    errors += check_cpu_list("1-2-3", {});
+    errors += check_cpu_list("cpu0", {});
+
+    std::vector<int> cpus;
+    CpuPlacement::parse_cpu_list("11,10,0-3,8", cpus);
+    if(CpuPlacement::format_cpu_list(cpus) != "0-3,8,10-11"){
+        fprintf(stderr, "[ERROR] CPU list is formatted as \"%s\".\n", CpuPlacement::format_cpu_list(cpus).c_str());
+        errors++;
+    }
+    return errors;
+}
+
+/***********************************************************
+ * run_pinned_workers()
+ *
+ * Description: Pins all workers of a pool to the first CPU the test may use and checks that
+ *              every task runs there.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_pinned_workers(int cpu){
+    WorkerPool pool(3);
+    if(pool.pin_workers(std::vector<int>(1, cpu)) == ERROR_CODE){
+        fprintf(stderr, "[ERROR] Could not pin the workers to CPU %d.\n", cpu);
+        return 1;
+    }
+
+    std::mutex cpu_mutex;
+    std::vector<int> task_cpus;
+    std::vector<std::function<void()>> tasks;
+    for(int i=0; i<30; i++){
+        tasks.push_back([&](){
+            std::lock_guard<std::mutex> lock(cpu_mutex);
+            task_cpus.push_back(sched_getcpu());
+        });
+    }
+    pool.run(tasks);
+
+    int errors = 0;
+    for(int worker=0; worker<pool.worker_number(); worker++){
+        if(pool.worker_cpu(worker) != cpu){
+            fprintf(stderr, "[ERROR] Worker %d reports CPU %d.\n", worker, pool.worker_cpu(worker));
+            errors++;
+        }
+    }
+    for(unsigned int i=0; i<task_cpus.size(); i++){
+        if(task_cpus[i] != cpu){
+            fprintf(stderr, "[ERROR] Task ran on CPU %d instead of %d.\n", task_cpus[i], cpu);
+            errors++;
+            break;
+        }
+    }
+    return errors;
+}
+
+/***********************************************************
+ * node_of_page()
+ *
+ * Description: Asks the kernel on which NUMA node a page is stored.
+ *
+ * Return:  int     The node, -1 if the kernel does not tell
+ */
+int node_of_page(void *memory){
+    int node = -1;
+    if(syscall(SYS_get_mempolicy, &node, NULL, 0, memory, MPOL_F_NODE | MPOL_F_ADDR) != 0){
+        return -1;
+    }
+    return node;
+}
+
+/***********************************************************
+ * build_network()
+ *
+ * Description: Builds a small network in which activity spreads along a ring.
+ */
+NeuralNetwork *build_network(){
+    Neuron::s_max_id = 0;
+    NeuralNetwork *nn = new NeuralNetwork();
+    for(int n=1; n<=1000; n++){
+        nn->add_neuron(1.0f);
+    }
+    for(int n=1; n<=1000; n++){
+        nn->add_neuron_connection(n, 1 + n % 1000, 2.0f);
+        nn->add_neuron_connection(n, 1 + (n * 5 + 1) % 1000, 0.6f, EXCITATORY, FUNCTION_SIGMOID, LEARNING_HABISENS);
+    }
+    nn->setup_network();
+    return nn;
+}
+
+/***********************************************************
+ * run_bound_memory()
+ *
+ * Description: Binds an arena and a compiled network to the node of a CPU and checks that the
+ *              memory ends up there without changing its content.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_bound_memory(int node){
+    int errors = 0;
+    NetworkArena arena;
+    std::vector<int*> values;
+    for(int i=0; i<100000; i++){
+        values.push_back(arena.create<int>(i));
+    }
+
+    if(arena.bind_to_node(node) == ERROR_CODE){
+        fprintf(stderr, "[ERROR] Could not bind the arena to NUMA node %d.\n", node);
+        errors++;
+    }
+    for(int i=0; i<100000; i++){
+        values.push_back(arena.create<int>(i));
+    }
+    for(unsigned int i=0; i<values.size(); i++){
+        if(*values[i] != (int)(i % 100000)){
+            fprintf(stderr, "[ERROR] Binding changed the arena.\n");
+            errors++;
+            break;
+        }
+    }
+    if(arena.numa_node() != node || node_of_page(values.back()) != node || node_of_page(values[50000]) != node){
+        fprintf(stderr, "[ERROR] Arena is not stored on NUMA node %d.\n", node);
+        errors++;
+    }
+
+    NeuralNetwork *bound = build_network();
+    NeuralNetwork *unbound = build_network();
+    std::vector<NeuralNetwork*> network_list(bound->_id + 1, NULL);
+    network_list[bound->_id] = bound;
+    network_list[unbound->_id] = unbound;
+    bound->compile_network(network_list);
+    unbound->compile_network(network_list);
+    if(bound->bind_to_node(node) == ERROR_CODE){
+        fprintf(stderr, "[ERROR] Could not bind the network to NUMA node %d.\n", node);
+        errors++;
+    }
+
+    for(int step=0; step<100; step++){
+        bound->init_activation(1 + step % 10, 2.0f);
+        unbound->init_activation(1 + step % 10, 2.0f);
+        bound->feed_forward(network_list);
+        unbound->feed_forward(network_list);
+    }
+    bound->store_compiled_state();
+    unbound->store_compiled_state();
+    for(unsigned int n=0; n<bound->_neurons.size(); n++){
+        if(bound->_neurons[n]->_activation != unbound->_neurons[n]->_activation ||
+           bound->_neurons[n]->_last_fired_step != unbound->_neurons[n]->_last_fired_step){
+            fprintf(stderr, "[ERROR] Binding changed N-%d of the network.\n", n);
+            errors++;
+            break;
+        }
+    }
+
+    delete bound;
+    delete unbound;
+    return errors;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Checks CPU lists, pinned workers and memory bound to a NUMA node.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    int errors = run_cpu_lists();
+
+    cpu_set_t allowed;
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+    int cpu = 0;
+    while(CPU_ISSET(cpu, &allowed) == false){
+        cpu++;
+    }
+    int node = CpuPlacement::numa_node(cpu);
+    printf("[INFO] Testing on CPU %d of NUMA node %d.\n", cpu, node);
+
+    errors += run_pinned_workers(cpu);
+    if(node >= 0){
+        errors += run_bound_memory(node);
+    }
+
+    if(errors > 0){
+        fprintf(stderr, "[ERROR] %d errors found.\n", errors);
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
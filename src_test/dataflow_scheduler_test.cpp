@@ -0,0 +1,126 @@
+#include "cluster_test_utils.hpp"
+#include "DataflowScheduler.hpp"
+#include "NeuralNetwork.hpp"
+
+#include <cstdio>
+#include <vector>
+
+using namespace COGNA;
+
+const int NETWORK_NUMBER = 6;
+const int NEURON_NUMBER = 2000;
+const int WORKER_NUMBER = 4;
+const int TEST_STEPS = 60;
+
+/* A chain of three networks, a single network and a pair of networks activating each other.
+   Every network is a ring of neurons with random shortcuts, so activity keeps circling. */
+const ClusterShape CLUSTER_SHAPE = {NETWORK_NUMBER, NEURON_NUMBER, 1, 0, 10, false, false, true,
+                                    {{0, 1}, {1, 2}, {4, 5}, {5, 4}}};
+
+/***********************************************************
+ * build_compiled_cluster()
+ *
+ * Description: Builds and compiles the cluster and activates the networks which are not
+ *              activated by other networks.
+ *
+ * Return:  std::vector<NeuralNetwork*>     The network list of the cluster
+ */
+std::vector<NeuralNetwork*> build_compiled_cluster(){
+    std::vector<NeuralNetwork*> network_list = build_cluster(23, CLUSTER_SHAPE);
+    std::vector<NeuralNetwork*> networks = cluster_networks(network_list);
+    for(unsigned int i=0; i<networks.size(); i++){
+        networks[i]->compile_network(network_list);
+    }
+
+    /* Networks 1, 2 and 5 only become active through other networks */
+    networks[0]->init_activation(1, 3.0f);
+    networks[3]->init_activation(1, 3.0f);
+    networks[4]->init_activation(1, 3.0f);
+    return network_list;
+}
+
+/***********************************************************
+ * check_graph()
+ *
+ * Description: Checks the edges and groups derived from the compiled cluster.
+ *
+ * Return:  int     Number of errors found
+ */
+int check_graph(DataflowScheduler &scheduler, const std::vector<NeuralNetwork*> &networks){
+    int errors = 0;
+    if(scheduler.group_count() != 3){
+        fprintf(stderr, "[ERROR] Found %d instead of 3 groups.\n", scheduler.group_count());
+        errors++;
+    }
+    if(scheduler.upstream_networks(networks[1]->_id) != std::vector<int>(1, networks[0]->_id) ||
+       scheduler.downstream_networks(networks[1]->_id) != std::vector<int>(1, networks[2]->_id) ||
+       scheduler.upstream_networks(networks[0]->_id).empty() == false ||
+       scheduler.downstream_networks(networks[2]->_id).empty() == false){
+        fprintf(stderr, "[ERROR] Chain of networks is not derived correctly.\n");
+        errors++;
+    }
+    if(scheduler.upstream_networks(networks[3]->_id).empty() == false ||
+       scheduler.downstream_networks(networks[3]->_id).empty() == false){
+        fprintf(stderr, "[ERROR] Single network has neighbours.\n");
+        errors++;
+    }
+    if(scheduler.upstream_networks(networks[4]->_id) != std::vector<int>(1, networks[5]->_id) ||
+       scheduler.downstream_networks(networks[4]->_id) != std::vector<int>(1, networks[5]->_id)){
+        fprintf(stderr, "[ERROR] Pair of networks is not derived correctly.\n");
+        errors++;
+    }
+    return errors;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Steps a cluster with the DataflowScheduler in several runs and checks that the
+ *              result is bitwise the same as stepping all networks together.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    std::vector<NeuralNetwork*> serial_list = build_compiled_cluster();
+    std::vector<NeuralNetwork*> dataflow_list = build_compiled_cluster();
+    std::vector<NeuralNetwork*> serial_networks = cluster_networks(serial_list);
+    std::vector<NeuralNetwork*> dataflow_networks = cluster_networks(dataflow_list);
+
+    WorkerPool pool(WORKER_NUMBER);
+    DataflowScheduler scheduler(dataflow_list, &pool);
+    int errors = check_graph(scheduler, dataflow_networks);
+
+    for(int step=0; step<TEST_STEPS; step++){
+        for(unsigned int i=0; i<serial_networks.size(); i++){
+            serial_networks[i]->feed_forward(serial_list);
+        }
+    }
+    scheduler.run(7);
+    scheduler.run(1);
+    scheduler.run(TEST_STEPS - 8);
+    scheduler.print_statistics();
+
+    for(unsigned int i=0; i<serial_networks.size(); i++){
+        errors += compare_networks(serial_networks[i], dataflow_networks[i], TEST_STEPS);
+    }
+
+    int fired_neurons = 0;
+    for(int n=MIN_NEURON_ID; n<=NEURON_NUMBER; n++){
+        fired_neurons += (dataflow_networks[2]->_neurons[n]->_last_fired_step > 0);
+    }
+    if(fired_neurons == 0){
+        fprintf(stderr, "[ERROR] No deliveries reached the end of the chain.\n");
+        errors++;
+    }
+
+    for(unsigned int i=0; i<serial_networks.size(); i++){
+        delete serial_networks[i];
+        delete dataflow_networks[i];
+    }
+
+    if(errors > 0){
+        fprintf(stderr, "[ERROR] %d errors found.\n", errors);
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
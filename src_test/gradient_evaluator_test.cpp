@@ -0,0 +1,95 @@
+#include "GradientEvaluator.hpp"
+#include "MathUtils.hpp"
+#include "Constants.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+using namespace COGNA;
+
+const int RANDOM_VALUES = 100000;
+
+/***********************************************************
+ * compare_gradient()
+ *
+ * Description: Compares a gradient of the evaluator with the one of MathUtils bit by bit.
+ *
+ * Return:  int     1 if they differ, 0 otherwise
+ */
+int compare_gradient(const GradientEvaluator *evaluator, float source_value, float curve_factor, int64_t x,
+                     float power_factor, int method, float max, float min){
+    float expected = MathUtils::calculate_static_gradient(source_value, curve_factor, x, power_factor, method, max, min);
+    float actual = GradientEvaluator::static_gradient(evaluator, source_value, curve_factor, x, power_factor,
+                                                      method, max, min);
+    if(memcmp(&expected, &actual, sizeof(float)) != 0){
+        fprintf(stderr, "[ERROR] Gradient at x=%ld with curvature %g is %.9g instead of %.9g.\n",
+                (long)x, power_factor, actual, expected);
+        return 1;
+    }
+    return 0;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Checks that the gradients of the GradientEvaluator are bitwise equal to
+ *              MathUtils::calculate_static_gradient() inside and outside of the power table,
+ *              for negative x, without an evaluator and with the evaluator of another curvature.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    const int methods[2] = {ADD, SUBTRACT};
+    const float curvatures[] = {0.0f, 0.3f, 0.5f, 1.0f, 1.7f, 2.0f, 3.0f};
+    const int64_t special_x[] = {0, 1, 2, POWER_TABLE_SIZE - 1, POWER_TABLE_SIZE, POWER_TABLE_SIZE + 1,
+                                 10 * POWER_TABLE_SIZE, 1000000, -1, -2, -POWER_TABLE_SIZE};
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> random_x(-100, 3 * POWER_TABLE_SIZE);
+    std::uniform_real_distribution<float> value(-2.0f, 2.0f);
+    std::uniform_real_distribution<float> factor(0.0f, 0.01f);
+
+    int errors = 0;
+    for(unsigned int c=0; c<sizeof(curvatures) / sizeof(float); c++){
+        float curvature = curvatures[c];
+        const GradientEvaluator *evaluator = GradientEvaluator::get(curvature);
+        const GradientEvaluator *other = GradientEvaluator::get(curvature + 0.25f);
+        if(evaluator == NULL || GradientEvaluator::get(curvature) != evaluator){
+            fprintf(stderr, "[ERROR] Curvature %g has no shared evaluator.\n", curvature);
+            errors++;
+            continue;
+        }
+
+        for(unsigned int i=0; i<sizeof(special_x) / sizeof(int64_t); i++){
+            for(int m=0; m<2; m++){
+                int method = methods[m];
+                errors += compare_gradient(evaluator, 0.5f, 0.001f, special_x[i], curvature, method, 1.0f, 0.0f);
+                errors += compare_gradient(evaluator, 0.5f, 0.001f, special_x[i], curvature, method, 1e30f, -1e30f);
+                errors += compare_gradient(NULL, 0.5f, 0.001f, special_x[i], curvature, method, 1.0f, 0.0f);
+                errors += compare_gradient(other, 0.5f, 0.001f, special_x[i], curvature, method, 1.0f, 0.0f);
+            }
+        }
+
+        for(int i=0; i<RANDOM_VALUES; i++){
+            int64_t x = random_x(rng);
+            int method = methods[rng() % 2];
+            float source_value = value(rng);
+            float curve_factor = factor(rng);
+            errors += compare_gradient(evaluator, source_value, curve_factor, x, curvature, method, 1.0f, -1.0f);
+            errors += compare_gradient(other, source_value, curve_factor, x, curvature, method, 1.0f, -1.0f);
+        }
+    }
+
+    if(GradientEvaluator::get(NAN) != NULL){
+        fprintf(stderr, "[ERROR] Curvature NaN has an evaluator.\n");
+        errors++;
+    }
+
+    if(errors > 0){
+        fprintf(stderr, "[ERROR] %d gradients differ from MathUtils::calculate_static_gradient().\n", errors);
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
@@ -0,0 +1,299 @@
+#include "CognaLauncher.hpp"
+#include "GraphPartitioner.hpp"
+#include "NeuralNetwork.hpp"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace COGNA;
+
+const int COMMUNITY_NUMBER = 4;
+const int COMMUNITY_SIZE = 250;
+const int CONNECTIONS_PER_NEURON = 8;
+const int LAUNCHER_WORKERS = 2;
+const int LAUNCHER_PROFILE_STEPS = 10;
+
+/***********************************************************
+ * connect_unique()
+ *
+ * Description: Connects two neurons of a network, if they are not connected yet.
+ */
+void connect_unique(NeuralNetwork *nn, int prev, int next){
+    if(prev == next){
+        return;
+    }
+    for(unsigned int i=0; i<nn->_neurons[prev]->_connections.size(); i++){
+        if(nn->_neurons[prev]->_connections[i]->next_neuron == nn->_neurons[next]){
+            return;
+        }
+    }
+    nn->add_neuron_connection(prev, next, 1.0f);
+}
+
+/***********************************************************
+ * run_communities()
+ *
+ * Description: Splits a network of interleaved communities, whose neurons are mostly connected
+ *              within their community, and checks that the cut gets small and the shards stay balanced.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_communities(){
+    std::mt19937 rng(11);
+    NeuralNetwork *nn = new NeuralNetwork();
+    int neuron_number = COMMUNITY_NUMBER * COMMUNITY_SIZE;
+    for(int n=1; n<=neuron_number; n++){
+        nn->add_neuron(1.0f);
+    }
+
+    /* Neuron n belongs to community (n - 1) % COMMUNITY_NUMBER, so contiguous blocks cut almost every connection */
+    for(int n=1; n<=neuron_number; n++){
+        for(int c=0; c<CONNECTIONS_PER_NEURON; c++){
+            int next = 1 + COMMUNITY_NUMBER * (rng() % COMMUNITY_SIZE) + (n - 1) % COMMUNITY_NUMBER;
+            if(rng() % 20 == 0){
+                next = 1 + rng() % neuron_number;
+            }
+            if(next <= neuron_number){
+                connect_unique(nn, n, next);
+            }
+        }
+    }
+
+    std::vector<NeuralNetwork*> network_list(nn->_id + 1, NULL);
+    network_list[nn->_id] = nn;
+    GraphPartitioner partitioner(network_list);
+    PartitionMap partition_map = partitioner.partition(COMMUNITY_NUMBER);
+    partition_map.print_statistics();
+
+    int errors = 0;
+    float cut_fraction = partition_map._cut_weight / partition_map._connection_weight;
+    if(cut_fraction > 0.1f){
+        fprintf(stderr, "[ERROR] %.1f%% of the connection weight crosses shards.\n", 100.0f * cut_fraction);
+        errors++;
+    }
+    if(partition_map.imbalance() > 1.0f + PARTITION_IMBALANCE + 0.01f){
+        fprintf(stderr, "[ERROR] Shards are imbalanced by %.3f.\n", partition_map.imbalance());
+        errors++;
+    }
+    if(partition_map._neuron_shards[nn->_id].size() != nn->_neurons.size()){
+        fprintf(stderr, "[ERROR] Map contains %lu instead of %lu neurons.\n",
+                partition_map._neuron_shards[nn->_id].size(), nn->_neurons.size());
+        errors++;
+    }
+
+    /* The same graph gives the same partition */
+    PartitionMap second_map = partitioner.partition(COMMUNITY_NUMBER);
+    if(second_map._neuron_shards != partition_map._neuron_shards){
+        fprintf(stderr, "[ERROR] Partitioning is not deterministic.\n");
+        errors++;
+    }
+
+    delete nn;
+    return errors;
+}
+
+/***********************************************************
+ * run_networks()
+ *
+ * Description: Splits a chain of small dense networks and checks that no network is torn apart.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_networks(){
+    std::mt19937 rng(5);
+    std::vector<NeuralNetwork*> networks;
+    for(int i=0; i<6; i++){
+        Neuron::s_max_id = 0;
+        NeuralNetwork *nn = new NeuralNetwork();
+        for(int n=1; n<=50; n++){
+            nn->add_neuron(1.0f);
+        }
+        for(int n=1; n<=50; n++){
+            for(int c=0; c<6; c++){
+                connect_unique(nn, n, 1 + rng() % 50);
+            }
+        }
+        networks.push_back(nn);
+    }
+    for(unsigned int i=0; i+1<networks.size(); i++){
+        networks[i]->add_neuron_connection(1, networks[i+1]->_neurons[1], 1.0f);
+    }
+
+    std::vector<NeuralNetwork*> network_list(networks.back()->_id + 1, NULL);
+    for(unsigned int i=0; i<networks.size(); i++){
+        network_list[networks[i]->_id] = networks[i];
+    }
+    GraphPartitioner partitioner(network_list);
+    PartitionMap partition_map = partitioner.partition(3);
+    partition_map.print_statistics();
+
+    int errors = 0;
+    std::vector<int> networks_per_shard(3, 0);
+    for(unsigned int i=0; i<networks.size(); i++){
+        int network_id = networks[i]->_id;
+        int shard = partition_map._network_shards[network_id];
+        networks_per_shard[shard]++;
+        for(unsigned int n=MIN_NEURON_ID; n<networks[i]->_neurons.size(); n++){
+            if(partition_map.shard_of(network_id, n) != shard){
+                fprintf(stderr, "[ERROR] N-%d of NN-%d is not in shard %d of its network.\n", n, network_id, shard);
+                errors++;
+                break;
+            }
+        }
+    }
+    for(int s=0; s<3; s++){
+        if(networks_per_shard[s] != 2){
+            fprintf(stderr, "[ERROR] Shard %d holds %d networks.\n", s, networks_per_shard[s]);
+            errors++;
+        }
+    }
+
+    for(unsigned int i=0; i<networks.size(); i++){
+        delete networks[i];
+    }
+    return errors;
+}
+
+/***********************************************************
+ * run_profile()
+ *
+ * Description: Profiles a compiled network in which only some neurons fire and checks that
+ *              the weights of the shards follow the firing rates.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_profile(){
+    Neuron::s_max_id = 0;
+    NeuralNetwork *nn = new NeuralNetwork();
+    for(int n=1; n<=100; n++){
+        nn->add_neuron(1.0f);
+    }
+    for(int n=1; n<=100; n++){
+        for(int c=1; c<=4; c++){
+            connect_unique(nn, n, 1 + (n + c * 7) % 100);
+        }
+    }
+    std::vector<NeuralNetwork*> network_list(nn->_id + 1, NULL);
+    network_list[nn->_id] = nn;
+    nn->setup_network();
+    /* Dense steps fire every neuron at most once per step, so the activation stays in a part of the network */
+    nn->_parameter->dense_frontier_threshold = 0.25f;
+    nn->compile_network(network_list);
+
+    GraphPartitioner partitioner(network_list);
+    for(int step=0; step<20; step++){
+        nn->init_activation(1, 100.0f);
+        nn->feed_forward(network_list);
+        partitioner.profile_step();
+    }
+
+    int errors = 0;
+    if(partitioner.profiled_steps() != 20){
+        fprintf(stderr, "[ERROR] Profiled %ld steps.\n", (long)partitioner.profiled_steps());
+        errors++;
+    }
+
+    /* Without the profile every neuron weighs 1 + 4 connections, silent neurons only 1 + 4 * PARTITION_MIN_RATE */
+    PartitionMap profiled_map = partitioner.partition(2);
+    GraphPartitioner unprofiled(network_list);
+    PartitionMap unprofiled_map = unprofiled.partition(2);
+    double profiled_weight = profiled_map._shard_weights[0] + profiled_map._shard_weights[1];
+    double unprofiled_weight = unprofiled_map._shard_weights[0] + unprofiled_map._shard_weights[1];
+    printf("[INFO] Cluster weighs %.1f with and %.1f without profile.\n", profiled_weight, unprofiled_weight);
+    if(unprofiled_weight != 101.0 + 4.0 * 100 || profiled_weight >= 0.5 * unprofiled_weight ||
+       profiled_weight < 101.0 + 4.0 * 100 * PARTITION_MIN_RATE){
+        fprintf(stderr, "[ERROR] Profile is not used for the weights.\n");
+        errors++;
+    }
+
+    delete nn;
+    return errors;
+}
+
+/***********************************************************
+ * run_launcher()
+ *
+ * Description: Profiles a single parallel network in a launcher and checks that the launcher
+ *              splits its steps by the neuron shards of the partition. Has to run before any
+ *              other network is created, since the launcher expects the network to have ID 0.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_launcher(){
+    Neuron::s_max_id = 0;
+    NeuralNetwork *nn = new NeuralNetwork();
+    int neuron_number = COMMUNITY_NUMBER * COMMUNITY_SIZE;
+    for(int n=1; n<=neuron_number; n++){
+        nn->add_neuron(1.0f);
+    }
+    for(int n=1; n<=neuron_number; n++){
+        for(int c=1; c<=4; c++){
+            connect_unique(nn, n, 1 + (n + c * COMMUNITY_NUMBER) % neuron_number);
+        }
+    }
+    if(nn->_id != 0){
+        fprintf(stderr, "[ERROR] Network of the launcher has ID %d.\n", nn->_id);
+        delete nn;
+        return 1;
+    }
+
+    std::vector<NeuralNetwork*> network_list(1, nn);
+    nn->setup_network();
+    nn->_parameter->dense_frontier_threshold = 0.0f;
+    nn->_parameter->parallel_threads = LAUNCHER_WORKERS;
+    nn->compile_network(network_list);
+    nn->init_activation(1, 100.0f);
+
+    CognaLauncher *launcher = new CognaLauncher(network_list, std::vector<utils::networking_client*>(),
+                                                std::vector<utils::networking_sender*>(), 1, LAUNCHER_WORKERS);
+    launcher->set_partition_profile_steps(LAUNCHER_PROFILE_STEPS);
+    launcher->set_free_running(true);
+    launcher->set_max_steps(2 * LAUNCHER_PROFILE_STEPS);
+    launcher->run_cogna();
+
+    int errors = 0;
+    const std::vector<uint16_t> &partition = nn->get_partition();
+    std::vector<int> shard_sizes(LAUNCHER_WORKERS, 0);
+    for(unsigned int n=0; n<partition.size(); n++){
+        if(partition[n] >= LAUNCHER_WORKERS){
+            fprintf(stderr, "[ERROR] N-%d is in shard %d of %d.\n", n, partition[n], LAUNCHER_WORKERS);
+            errors++;
+            break;
+        }
+        shard_sizes[partition[n]]++;
+    }
+    if(partition.size() != nn->_neurons.size() || shard_sizes[0] == 0 || shard_sizes[1] == 0){
+        fprintf(stderr, "[ERROR] Launcher did not split the network by its partition.\n");
+        errors++;
+    }
+    if(nn->_statistics._parallel_steps == 0){
+        fprintf(stderr, "[ERROR] Network took no parallel steps in the launcher.\n");
+        errors++;
+    }
+
+    /* Deletes the network as well */
+    delete launcher;
+    return errors;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Checks that the partitioner cuts few connections, keeps the shards balanced and
+ *              uses the firing profile, and that the launcher uses the partition.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    int errors = run_launcher();
+    errors += run_communities();
+    errors += run_networks();
+    errors += run_profile();
+
+    if(errors > 0){
+        fprintf(stderr, "[ERROR] %d errors found.\n", errors);
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
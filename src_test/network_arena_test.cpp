@@ -0,0 +1,77 @@
+#include "NeuralNetwork.hpp"
+#include "NetworkArena.hpp"
+
+#include <cstdint>
+#include <cstdio>
+
+using namespace COGNA;
+
+const int NEURON_NUMBER = 2000;
+
+/***********************************************************
+ * main()
+ *
+ * Description: Checks that arena memory is aligned, that neurons and connections are laid out in
+ *              creation order and that a network with huge pages runs and frees its memory.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    int errors = 0;
+
+    NetworkArena arena;
+    for(size_t alignment=1; alignment<=64; alignment*=2){
+        char *memory = (char*)arena.allocate(3, alignment);
+        if((uintptr_t)memory % alignment != 0){
+            fprintf(stderr, "[ERROR] Memory is not aligned to %lu bytes.\n", (unsigned long)alignment);
+            errors++;
+        }
+    }
+    arena.allocate(ARENA_MAX_CHUNK_SIZE, 8);
+    if(arena.chunk_count() != 2){
+        fprintf(stderr, "[ERROR] Large allocation did not start a new chunk.\n");
+        errors++;
+    }
+
+    for(int huge_pages=0; huge_pages<=1; huge_pages++){
+        NeuralNetwork *nn = new NeuralNetwork();
+        nn->_arena->set_huge_pages(huge_pages != 0);
+        for(int n=1; n<=NEURON_NUMBER; n++){
+            nn->add_neuron(0.5f);
+            if(n > 1){
+                nn->add_neuron_connection(n-1, n, 1.0f);
+            }
+        }
+
+        /* Neuron n is followed by the connection leading to it, except where a new chunk starts */
+        size_t unordered = 0;
+        for(int n=2; n<NEURON_NUMBER; n++){
+            char *neuron = (char*)nn->_neurons[n];
+            char *connection = (char*)nn->_neurons[n-1]->_connections[0];
+            char *next_neuron = (char*)nn->_neurons[n+1];
+            if(connection < neuron || next_neuron < connection){
+                unordered++;
+            }
+        }
+        if(unordered > nn->_arena->chunk_count()){
+            fprintf(stderr, "[ERROR] %lu objects are not stored in creation order.\n", (unsigned long)unordered);
+            errors++;
+        }
+
+        nn->setup_network();
+        for(int step=0; step<20; step++){
+            nn->init_activation(1, 2.0f);
+            nn->feed_forward();
+        }
+        if(nn->_neurons[10]->_last_fired_step == 0){
+            fprintf(stderr, "[ERROR] Activation did not propagate.\n");
+            errors++;
+        }
+        delete nn;
+    }
+
+    if(errors > 0){
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,246 @@
+#include "cluster_test_utils.hpp"
+#include "GraphPartitioner.hpp"
+#include "NeuralNetwork.hpp"
+
+#include <cstdio>
+#include <dirent.h>
+#include <random>
+#include <vector>
+
+using namespace COGNA;
+
+const int NEURON_NUMBER = 3000;
+const int TEST_STEPS = 150;
+
+/* Two large networks activating each other and firing at connections of each other, some neurons fire at
+   themselves. Synaptic connections inside a network and neurons influencing transmitters are never stepped
+   in parallel, so there are none. */
+const ClusterShape CLUSTER_SHAPE = {2, NEURON_NUMBER, 6, 0, 60, true, false, false, {{0, 1}, {1, 0}}};
+
+/***********************************************************
+ * compile_cluster()
+ *
+ * Description: Compiles all networks of a cluster with dense steps only.
+ *
+ * Return:  std::vector<NeuralNetwork*>     The networks of the cluster in ID order
+ */
+std::vector<NeuralNetwork*> compile_cluster(std::vector<NeuralNetwork*> &cluster, int threads, bool gather){
+    std::vector<NeuralNetwork*> networks;
+    for(unsigned int i=0; i<cluster.size(); i++){
+        if(cluster[i]){
+            networks.push_back(cluster[i]);
+            cluster[i]->_parameter->dense_frontier_threshold = 0.0f;
+            cluster[i]->_parameter->parallel_threads = threads;
+            cluster[i]->_parameter->gather_propagation = gather;
+            cluster[i]->compile_network(cluster);
+        }
+    }
+    return networks;
+}
+
+/***********************************************************
+ * thread_count()
+ *
+ * Description: Counts the threads of the process.
+ *
+ * Return:  int     Number of threads
+ */
+int thread_count(){
+    int threads = 0;
+    DIR *directory = opendir("/proc/self/task");
+    if(directory == NULL){
+        return -1;
+    }
+    struct dirent *entry;
+    while((entry = readdir(directory)) != NULL){
+        if(entry->d_name[0] != '.'){
+            threads++;
+        }
+    }
+    closedir(directory);
+    return threads;
+}
+
+/***********************************************************
+ * run_compared_clusters()
+ *
+ * Description: Runs the same cluster serially and with parallel or gathering dense steps and
+ *              compares both bitwise in every step. Partitioned clusters reduce the forces by
+ *              the shards of a GraphPartitioner instead of ranges of IDs. With a shared pool,
+ *              all parallel networks run on its workers and start no threads of their own.
+ *
+ * Return:  int     Number of differences found
+ */
+int run_compared_clusters(int threads, bool gather, bool partitioned, WorkerPool *shared_pool=NULL){
+    int differences = 0;
+    std::vector<NeuralNetwork*> serial_cluster = build_cluster(42, CLUSTER_SHAPE);
+    std::vector<NeuralNetwork*> parallel_cluster = build_cluster(42, CLUSTER_SHAPE);
+    std::vector<NeuralNetwork*> serial_networks = compile_cluster(serial_cluster, 1, false);
+    std::vector<NeuralNetwork*> parallel_networks = compile_cluster(parallel_cluster, threads, gather);
+    if(partitioned){
+        GraphPartitioner partitioner(parallel_cluster);
+        PartitionMap partition_map = partitioner.partition(threads + 2);
+        for(unsigned int i=0; i<parallel_networks.size(); i++){
+            parallel_networks[i]->set_partition(partition_map._neuron_shards[parallel_networks[i]->_id]);
+        }
+    }
+    for(unsigned int i=0; i<parallel_networks.size() && shared_pool; i++){
+        parallel_networks[i]->set_worker_pool(shared_pool);
+    }
+
+    std::mt19937 input_rng(7);
+    std::uniform_real_distribution<float> input_activation(0.5f, 5.0f);
+    for(int step=1; step<=TEST_STEPS && differences == 0; step++){
+        for(int input=0; input<20; input++){
+            int target = 1 + input_rng()%NEURON_NUMBER;
+            float activation = input_activation(input_rng);
+            serial_networks[0]->init_activation(target, activation);
+            parallel_networks[0]->init_activation(target, activation);
+        }
+
+        for(unsigned int i=0; i<serial_networks.size(); i++){
+            serial_networks[i]->feed_forward(serial_cluster);
+            parallel_networks[i]->feed_forward(parallel_cluster);
+        }
+
+        if(step % 10 == 0 || step == TEST_STEPS){
+            for(unsigned int i=0; i<serial_networks.size(); i++){
+                differences += compare_networks(serial_networks[i], parallel_networks[i], step);
+            }
+        }
+    }
+
+    if(shared_pool && thread_count() != shared_pool->worker_number()){
+        fprintf(stderr, "[ERROR] %d threads run besides a shared pool of %d workers.\n", thread_count(),
+                shared_pool->worker_number());
+        differences++;
+    }
+
+    NetworkStatistics &statistics = parallel_networks[0]->_statistics;
+    if(statistics._parallel_steps != statistics._dense_steps || statistics._dense_steps == 0){
+        fprintf(stderr, "[ERROR] %ld of %ld dense steps ran in parallel with %d threads (gather %d).\n",
+                (long)statistics._parallel_steps, (long)statistics._dense_steps, threads, gather);
+        differences++;
+    }
+
+    int activated_neurons = 0;
+    for(unsigned int n=MIN_NEURON_ID; n<parallel_networks[0]->_neurons.size(); n++){
+        if(parallel_networks[0]->_neurons[n]->_last_fired_step > 0){
+            activated_neurons++;
+        }
+    }
+    if(activated_neurons < NEURON_NUMBER / 2){
+        fprintf(stderr, "[ERROR] Only %d neurons fired.\n", activated_neurons);
+        differences++;
+    }
+
+    for(unsigned int i=0; i<serial_networks.size(); i++){
+        delete serial_networks[i];
+        delete parallel_networks[i];
+    }
+    return differences;
+}
+
+/***********************************************************
+ * run_unsupported_network()
+ *
+ * Description: Checks that a network with a neuron influencing a transmitter is stepped serially.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_unsupported_network(){
+    std::vector<NeuralNetwork*> cluster = build_cluster(3, CLUSTER_SHAPE);
+    std::vector<NeuralNetwork*> networks;
+    for(unsigned int i=0; i<cluster.size(); i++){
+        if(cluster[i]){
+            networks.push_back(cluster[i]);
+        }
+    }
+    networks[0]->set_neural_transmitter_influence(1, 1);
+    compile_cluster(cluster, 4, true);
+
+    for(int step=1; step<=10; step++){
+        networks[0]->init_activation(1, 5.0f);
+        networks[0]->feed_forward(cluster);
+    }
+
+    int errors = 0;
+    if(networks[0]->_statistics._parallel_steps != 0){
+        fprintf(stderr, "[ERROR] Network influencing transmitters took parallel steps.\n");
+        errors++;
+    }
+    for(unsigned int i=0; i<networks.size(); i++){
+        delete networks[i];
+    }
+    return errors;
+}
+
+/***********************************************************
+ * run_parallel_parameters()
+ *
+ * Description: Checks that only compiled networks with dense steps step in parallel, so the
+ *              launcher keeps all other networks as single tasks.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_parallel_parameters(){
+    std::vector<NeuralNetwork*> cluster = build_cluster(4, CLUSTER_SHAPE);
+    NeuralNetwork *nn = NULL;
+    for(unsigned int i=0; i<cluster.size() && nn == NULL; i++){
+        nn = cluster[i];
+    }
+
+    int errors = 0;
+    nn->_parameter->parallel_threads = 2;
+    nn->_parameter->dense_frontier_threshold = 0.0f;
+    if(nn->is_parallel()){
+        fprintf(stderr, "[ERROR] Network steps in parallel without being compiled.\n");
+        errors++;
+    }
+    nn->_parameter->dense_frontier_threshold = 2.0f;
+    nn->compile_network(cluster);
+    if(nn->is_parallel()){
+        fprintf(stderr, "[ERROR] Network steps in parallel without dense steps.\n");
+        errors++;
+    }
+    nn->_parameter->dense_frontier_threshold = 0.0f;
+    if(nn->is_parallel() == false){
+        fprintf(stderr, "[ERROR] Compiled network with dense steps does not step in parallel.\n");
+        errors++;
+    }
+
+    for(unsigned int i=0; i<cluster.size(); i++){
+        delete cluster[i];
+    }
+    return errors;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Checks that parallel and gathering dense steps produce bitwise the same results
+ *              as serial dense steps for several thread numbers.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    int differences = 0;
+    for(int threads=2; threads<=4; threads++){
+        differences += run_compared_clusters(threads, false, false);
+    }
+    for(int threads=1; threads<=3; threads+=2){
+        differences += run_compared_clusters(threads, true, false);
+    }
+    differences += run_compared_clusters(3, false, true);
+    differences += run_compared_clusters(2, true, true);
+    WorkerPool shared_pool(3);
+    differences += run_compared_clusters(2, false, false, &shared_pool);
+    differences += run_unsupported_network();
+    differences += run_parallel_parameters();
+
+    if(differences > 0){
+        fprintf(stderr, "[ERROR] Parallel steps differ from serial steps.\n");
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
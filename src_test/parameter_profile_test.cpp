@@ -0,0 +1,238 @@
+#include "CognaBuilder.hpp"
+#include "NeuralNetwork.hpp"
+#include "ParameterProfilePool.hpp"
+#include "Constants.hpp"
+
+#include <cstdio>
+#include <set>
+#include <vector>
+
+using namespace COGNA;
+
+const char PROFILE_PROJECT[] = "Profile_Test";       // Variants_Test with overridden connection parameters
+const char PLAIN_PROJECT[] = "Variants_Test";
+
+/***********************************************************
+ * run_interning()
+ *
+ * Description: Checks that equal parameters share one profile and that changing the parameters
+ *              of a neuron or connection does not change the others sharing its profile.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_interning(){
+    int errors = 0;
+    Neuron::s_max_id = 0;
+    NeuralNetwork *nn = new NeuralNetwork();
+    const int first = 1;
+    const int second = 2;
+    const int third = 3;
+    for(int n=first; n<=third; n++){
+        nn->add_neuron(1.0f);
+    }
+    Connection *first_con = nn->add_neuron_connection(first, third, 1.0f);
+    Connection *second_con = nn->add_neuron_connection(second, third, 1.0f);
+
+    const NeuronParameterHandler *neuron_profile = nn->_neurons[first]->_parameter;
+    const ConnectionParameterHandler *connection_profile = first_con->_parameter;
+    size_t neuron_profiles = nn->_profiles->neuron_profile_count();
+    size_t connection_profiles = nn->_profiles->connection_profile_count();
+    if(nn->_neurons[second]->_parameter != neuron_profile || second_con->_parameter != connection_profile){
+        fprintf(stderr, "[ERROR] Equal parameters are not interned to the same profile.\n");
+        errors++;
+    }
+    if(nn->_profiles->intern(*neuron_profile) != neuron_profile ||
+       nn->_profiles->intern(*connection_profile) != connection_profile){
+        fprintf(stderr, "[ERROR] Interning a profile again does not return it.\n");
+        errors++;
+    }
+
+    /* Copy-on-write of a single neuron and connection */
+    NeuronParameterHandler neuron_parameter = *neuron_profile;
+    neuron_parameter.activation_threshold = 2.0f;
+    nn->_neurons[first]->set_parameter(neuron_parameter);
+    ConnectionParameterHandler connection_parameter = *connection_profile;
+    connection_parameter.max_weight = 2.0f * connection_profile->max_weight + 1.0f;
+    first_con->set_parameter(connection_parameter);
+
+    if(nn->_neurons[first]->_parameter == neuron_profile || nn->_neurons[first]->_parameter->activation_threshold != 2.0f){
+        fprintf(stderr, "[ERROR] Changed neuron still uses the shared profile.\n");
+        errors++;
+    }
+    if(nn->_neurons[second]->_parameter != neuron_profile || nn->_neurons[second]->_parameter->activation_threshold != 1.0f){
+        fprintf(stderr, "[ERROR] Changing a neuron changed another neuron sharing its profile.\n");
+        errors++;
+    }
+    if(first_con->_parameter == connection_profile || first_con->_parameter->max_weight != connection_parameter.max_weight){
+        fprintf(stderr, "[ERROR] Changed connection still uses the shared profile.\n");
+        errors++;
+    }
+    if(second_con->_parameter != connection_profile || second_con->_parameter->max_weight == connection_parameter.max_weight){
+        fprintf(stderr, "[ERROR] Changing a connection changed another connection sharing its profile.\n");
+        errors++;
+    }
+
+    /* Changing the others the same way reuses the new profiles */
+    nn->_neurons[second]->set_parameter(neuron_parameter);
+    second_con->set_parameter(connection_parameter);
+    if(nn->_neurons[second]->_parameter != nn->_neurons[first]->_parameter ||
+       second_con->_parameter != first_con->_parameter ||
+       nn->_profiles->neuron_profile_count() != neuron_profiles + 1 ||
+       nn->_profiles->connection_profile_count() != connection_profiles + 1){
+        fprintf(stderr, "[ERROR] Equally changed parameters are not interned to the same profile.\n");
+        errors++;
+    }
+
+    delete nn;
+    return errors;
+}
+
+/***********************************************************
+ * build_main_network()
+ *
+ * Description: Builds a project and returns its main network. The builder is returned as well,
+ *              since it owns the network.
+ *
+ * Return:  NeuralNetwork*     The main network, NULL if building failed
+ */
+NeuralNetwork *build_main_network(const char *project, CognaBuilder *&builder){
+    Neuron::s_max_id = 0;
+    Connection::s_max_id = 0;
+    builder = new CognaBuilder(project);
+    if(builder->build_cogna_cluster() == ERROR_CODE || builder->get_network_list().empty()){
+        fprintf(stderr, "[ERROR] Building %s failed.\n", project);
+        return NULL;
+    }
+    return builder->get_network_list()[0];
+}
+
+/***********************************************************
+ * find_connection()
+ *
+ * Description: Finds a connection of a network by its ID in the project file.
+ *
+ * Return:  Connection*     The connection, NULL if it does not exist
+ */
+Connection *find_connection(NeuralNetwork *nn, int json_id){
+    for(unsigned int n=0; n<nn->_neurons.size(); n++){
+        for(unsigned int con=0; con<nn->_neurons[n]->_connections.size(); con++){
+            if(nn->_neurons[n]->_connections[con]->_json_id == json_id){
+                return nn->_neurons[n]->_connections[con];
+            }
+        }
+    }
+    return NULL;
+}
+
+/***********************************************************
+ * run_builder_overrides()
+ *
+ * Description: Checks that connection parameters overridden in a project get their own profile,
+ *              that equal overrides share it and that the other connections keep their profile.
+ *              Profile_Test sets max_weight of the connections 0 and 2 and habituation_threshold
+ *              of connection 3.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_builder_overrides(){
+    CognaBuilder *plain_builder = NULL;
+    CognaBuilder *profile_builder = NULL;
+    NeuralNetwork *plain = build_main_network(PLAIN_PROJECT, plain_builder);
+    NeuralNetwork *nn = build_main_network(PROFILE_PROJECT, profile_builder);
+    if(plain == NULL || nn == NULL){
+        delete plain_builder;
+        delete profile_builder;
+        return 1;
+    }
+
+    int errors = 0;
+    const int connection_ids[] = {0, 1, 2, 3, 4, 7, 8};
+    std::vector<Connection*> connections;
+    for(unsigned int i=0; i<sizeof(connection_ids) / sizeof(int); i++){
+        connections.push_back(find_connection(nn, connection_ids[i]));
+        if(connections.back() == NULL){
+            fprintf(stderr, "[ERROR] Connection %d of %s does not exist.\n", connection_ids[i], PROFILE_PROJECT);
+            errors++;
+        }
+    }
+    if(errors > 0){
+        delete plain_builder;
+        delete profile_builder;
+        return errors;
+    }
+
+    const ConnectionParameterHandler *plain_profile = connections[1]->_parameter;
+    const ConnectionParameterHandler *weight_profile = connections[0]->_parameter;
+    const ConnectionParameterHandler *threshold_profile = connections[3]->_parameter;
+    if(weight_profile->max_weight != 3.0f || threshold_profile->habituation_threshold != 0.5f){
+        fprintf(stderr, "[ERROR] Overridden connection parameters were not loaded.\n");
+        errors++;
+    }
+    if(connections[2]->_parameter != weight_profile){
+        fprintf(stderr, "[ERROR] Equally overridden connections do not share their profile.\n");
+        errors++;
+    }
+    if(weight_profile == plain_profile || threshold_profile == plain_profile || threshold_profile == weight_profile){
+        fprintf(stderr, "[ERROR] Overridden connections share the profile of other connections.\n");
+        errors++;
+    }
+    for(unsigned int i=4; i<connections.size(); i++){
+        if(connections[i]->_parameter != plain_profile){
+            fprintf(stderr, "[ERROR] Connection %d lost its shared profile.\n", connection_ids[i]);
+            errors++;
+        }
+    }
+    if(plain_profile->max_weight == 3.0f || plain_profile->habituation_threshold == 0.5f){
+        fprintf(stderr, "[ERROR] Overriding connection parameters changed the shared profile.\n");
+        errors++;
+    }
+
+    /* Only the two distinct overrides add profiles */
+    size_t plain_count = plain->_profiles->connection_profile_count();
+    size_t count = nn->_profiles->connection_profile_count();
+    if(count != plain_count + 2){
+        fprintf(stderr, "[ERROR] %s has %lu connection profiles instead of %lu.\n", PROFILE_PROJECT,
+                (unsigned long)count, (unsigned long)plain_count + 2);
+        errors++;
+    }
+
+    std::set<const ConnectionParameterHandler*> used_profiles;
+    for(unsigned int n=0; n<nn->_neurons.size(); n++){
+        for(unsigned int con=0; con<nn->_neurons[n]->_connections.size(); con++){
+            used_profiles.insert(nn->_neurons[n]->_connections[con]->_parameter);
+        }
+    }
+    fprintf(stderr, "%s: %lu connections use %lu of %lu connection profiles.\n", PROFILE_PROJECT,
+            (unsigned long)nn->_connections.size(), (unsigned long)used_profiles.size(), (unsigned long)count);
+
+    /* The launcher usually frees the networks */
+    std::vector<NeuralNetwork*> networks = plain_builder->get_network_list();
+    std::vector<NeuralNetwork*> profile_networks = profile_builder->get_network_list();
+    networks.insert(networks.end(), profile_networks.begin(), profile_networks.end());
+    for(unsigned int i=0; i<networks.size(); i++){
+        delete networks[i];
+    }
+    delete plain_builder;
+    delete profile_builder;
+    return errors;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Checks the interning and the copy-on-write of the parameter profiles of neurons
+ *              and connections, directly and through the parameters a project overrides.
+ *              Has to run in build/tests, like the builder test.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    int errors = run_interning();
+    errors += run_builder_overrides();
+
+    if(errors > 0){
+        fprintf(stderr, "[ERROR] %d errors found.\n", errors);
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
@@ -0,0 +1,93 @@
+#include "PhaseBarrier.hpp"
+#include "Constants.hpp"
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace COGNA;
+
+const int THREAD_NUMBER = 4;
+const int PHASE_NUMBER = 2000;
+
+/***********************************************************
+ * worker()
+ *
+ * Description: Writes its slot in every even phase and checks the slots of all
+ *              other threads in every odd phase, until the barrier is closed.
+ */
+void worker(PhaseBarrier *barrier, int id, std::vector<int> *slots, int *errors){
+    int phase = 0;
+    while(barrier->arrive_and_wait() == true){
+        (*slots)[id] = phase;
+        barrier->arrive_and_wait();
+        for(int i=0; i<THREAD_NUMBER; i++){
+            if((*slots)[i] != phase){
+                (*errors)++;
+            }
+        }
+        phase++;
+    }
+}
+
+/***********************************************************
+ * run_barrier()
+ *
+ * Description: Runs all phases with a coordinating main thread like the CognaLauncher.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_barrier(int spin_count){
+    PhaseBarrier barrier(THREAD_NUMBER + 1, spin_count);
+    std::vector<int> slots(THREAD_NUMBER, -1);
+    std::vector<int> errors(THREAD_NUMBER, 0);
+    std::vector<std::thread> threads;
+    for(int i=0; i<THREAD_NUMBER; i++){
+        threads.push_back(std::thread(worker, &barrier, i, &slots, &errors[i]));
+    }
+
+    for(int phase=0; phase<PHASE_NUMBER; phase++){
+        barrier.arrive_and_wait();
+        barrier.arrive_and_wait();
+    }
+    barrier.close();
+    barrier.arrive_and_wait();
+
+    int error_number = 0;
+    for(int i=0; i<THREAD_NUMBER; i++){
+        threads[i].join();
+        error_number += errors[i];
+        if(slots[i] != PHASE_NUMBER - 1){
+            fprintf(stderr, "[ERROR] Thread %d stopped after phase %d.\n", i, slots[i]);
+            error_number++;
+        }
+    }
+    if(barrier.phase() != 2 * PHASE_NUMBER + 1){
+        fprintf(stderr, "[ERROR] Barrier completed %u phases.\n", barrier.phase());
+        error_number++;
+    }
+    if(spin_count == 0 && barrier.sleep_count() == 0){
+        fprintf(stderr, "[ERROR] Threads never slept without spinning.\n");
+        error_number++;
+    }
+    return error_number;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Checks that all threads pass every phase together, with spinning
+ *              and with sleeping only, and that closing the barrier stops them.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    int errors = run_barrier(BARRIER_SPIN_COUNT);
+    errors += run_barrier(0);
+
+    if(errors > 0){
+        fprintf(stderr, "[ERROR] %d errors found.\n", errors);
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
@@ -0,0 +1,135 @@
+#include "RealtimeProfile.hpp"
+#include "CpuPlacement.hpp"
+#include "Constants.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace COGNA;
+
+const int PREFAULT_PAGES = 64;
+const int TEST_PRIORITY = 10;
+
+/***********************************************************
+ * run_prefault()
+ *
+ * Description: Pre-faults a fresh mapping and a vector and checks that every page became resident
+ *              and that no content changed.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_prefault(){
+    int errors = 0;
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    size_t size = PREFAULT_PAGES * page_size;
+    void *memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(memory == MAP_FAILED){
+        fprintf(stderr, "[ERROR] Could not map memory.\n");
+        return 1;
+    }
+
+    RealtimeProfile::prefault_memory(memory, size);
+    std::vector<unsigned char> resident(PREFAULT_PAGES, 0);
+    if(mincore(memory, size, resident.data()) != 0){
+        fprintf(stderr, "[ERROR] mincore() failed: %s.\n", strerror(errno));
+        errors++;
+    }
+    for(int i=0; i<PREFAULT_PAGES; i++){
+        if((resident[i] & 1) == 0){
+            fprintf(stderr, "[ERROR] Page %d is not resident after pre-faulting.\n", i);
+            errors++;
+            break;
+        }
+    }
+    munmap(memory, size);
+
+    /* An odd size ends within a page */
+    std::vector<int> values;
+    values.reserve(3 * page_size / sizeof(int) + 5);
+    for(unsigned int i=0; i<3 * page_size / sizeof(int) + 1; i++){
+        values.push_back(i * 7 + 1);
+    }
+    std::vector<int> copy = values;
+    RealtimeProfile::prefault_vector(values);
+    if(values != copy){
+        fprintf(stderr, "[ERROR] Pre-faulting changed a vector.\n");
+        errors++;
+    }
+
+    RealtimeProfile::prefault_stack();
+    return errors;
+}
+
+/***********************************************************
+ * run_privileges()
+ *
+ * Description: Applies the guarantees needing privileges and checks that they either work or fail
+ *              with a reason. Restores the scheduling and unlocks the memory afterwards.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_privileges(){
+    int errors = 0;
+    if(RealtimeProfile::set_current_fifo_priority(TEST_PRIORITY) == SUCCESS_CODE){
+        if(sched_getscheduler(0) != SCHED_FIFO){
+            fprintf(stderr, "[ERROR] Thread does not run with SCHED_FIFO.\n");
+            errors++;
+        }
+        struct sched_param parameter;
+        parameter.sched_priority = 0;
+        pthread_setschedparam(pthread_self(), SCHED_OTHER, &parameter);
+        printf("[INFO] SCHED_FIFO priority %d applied.\n", TEST_PRIORITY);
+    }
+    else if(errno != EPERM){
+        fprintf(stderr, "[ERROR] SCHED_FIFO failed with %s.\n", strerror(errno));
+        errors++;
+    }
+    else{
+        printf("[INFO] SCHED_FIFO is not permitted, the limit is %lu.\n",
+               (unsigned long)RealtimeProfile::priority_limit());
+    }
+
+    if(RealtimeProfile::lock_memory() == SUCCESS_CODE){
+        munlockall();
+        printf("[INFO] Memory locked.\n");
+    }
+    else if(errno != EPERM && errno != ENOMEM && errno != EAGAIN){
+        fprintf(stderr, "[ERROR] mlockall() failed with %s.\n", strerror(errno));
+        errors++;
+    }
+    else{
+        printf("[INFO] Memory could not be locked: %s.\n", strerror(errno));
+    }
+
+    std::vector<int> isolated;
+    if(CpuPlacement::isolated_cpus(isolated) == ERROR_CODE){
+        fprintf(stderr, "[ERROR] Could not read the isolated CPUs.\n");
+        errors++;
+    }
+    printf("[INFO] Isolated CPUs: \"%s\".\n", CpuPlacement::format_cpu_list(isolated).c_str());
+    return errors;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Checks the functions of the real-time profile.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    int errors = run_prefault();
+    errors += run_privileges();
+
+    if(errors > 0){
+        fprintf(stderr, "[ERROR] %d errors found.\n", errors);
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
@@ -1,6 +1,7 @@
 #include "DataWriter.hpp"
 #include "NeuralNetwork.hpp"
 #include "HelperFunctions.hpp"
+#include "Trace.hpp"
 
 #include <cstdio>
 
@@ -164,7 +165,7 @@ int main(){
 
         if(d_time >= TIME_BETWEEN_STEPS){
             start_time = utils::get_time_microsec(time);
-            if(DEBUG_MODE && DEB_BASE)
+            if(Trace::enabled(TRACE_BASE))
                 nn->print_activation();
 
             nn->feed_forward();
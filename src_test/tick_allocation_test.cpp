@@ -0,0 +1,233 @@
+#include "CognaLauncher.hpp"
+#include "NeuralNetwork.hpp"
+#include "client_server.hpp"
+#include "networking_client.hpp"
+#include "networking_sender.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace COGNA;
+
+const int NEURON_NUMBER = 200;
+const int CONNECTIONS_PER_NEURON = 4;
+const int TRANSMITTER_NUMBER = 2;
+const int RANDOM_CHANCE = 99;
+const int WORKER_NUMBER = 2;
+const int WARMUP_STEPS = 300;
+const int TEST_STEPS = 1000;
+const int CLOCKED_FREQUENCY = 5000;
+const int SENDER_PORT = 50999;
+const int CLIENT_PORT = 50998;
+const int INPUT_INTERVAL_US = 200;
+const char INPUT_MESSAGE[] = "input";
+
+static std::atomic<long> s_allocations(0);
+static std::atomic<COGNA::CognaLauncher*> s_launcher(NULL);   // Launcher whose measured steps are counted
+
+/***********************************************************
+ * operator new()
+ *
+ * Description: Counts every heap allocation of the program during the measured steps of the launcher.
+ *              The step counter is only written between two steps, while no other thread allocates.
+ */
+void *operator new(size_t size){
+    CognaLauncher *launcher = s_launcher;
+    if(launcher){
+        unsigned long long step = launcher->get_cluster_step();
+        if(step >= WARMUP_STEPS && step < WARMUP_STEPS + TEST_STEPS){
+            s_allocations++;
+        }
+    }
+    void *memory = malloc(size > 0 ? size : 1);
+    if(memory == NULL){
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void *memory) noexcept{
+    free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept{
+    free(memory);
+}
+
+/***********************************************************
+ * build_network()
+ *
+ * Description: Builds a randomly connected network, which also fires at the other network
+ *              of the cluster and reports some of its neurons to an output node. Random neurons
+ *              keep it firing.
+ */
+NeuralNetwork *build_network(std::mt19937 &rng, utils::networking_sender *sender){
+    std::uniform_real_distribution<float> threshold(0.1f, 2.0f);
+    std::uniform_real_distribution<float> weight(0.2f, 2.0f);
+    const int functions[3] = {FUNCTION_SIGMOID, FUNCTION_LINEAR, FUNCTION_RELU};
+
+    Neuron::s_max_id = 0;
+    NeuralNetwork *nn = new NeuralNetwork();
+    nn->define_transmitters(TRANSMITTER_NUMBER);
+    for(int n=1; n<=NEURON_NUMBER; n++){
+        nn->add_neuron(threshold(rng));
+        if(rng()%8 == 0){
+            nn->set_neural_transmitter_influence(n, rng()%TRANSMITTER_NUMBER, POSITIVE_INFLUENCE);
+        }
+        if(rng()%10 == 0){
+            nn->set_random_neuron_activation(n, RANDOM_CHANCE, 3.0f);
+        }
+    }
+
+    for(int n=1; n<=NEURON_NUMBER; n++){
+        for(int c=0; c<CONNECTIONS_PER_NEURON; c++){
+            int next = 1 + rng()%NEURON_NUMBER;
+            if(next == n){
+                continue;
+            }
+            nn->add_neuron_connection(n, next, weight(rng),
+                                      rng()%4 ? EXCITATORY : INHIBITORY,
+                                      functions[rng()%3],
+                                      LEARNING_NONE + rng()%4,
+                                      rng()%TRANSMITTER_NUMBER);
+        }
+    }
+
+    nn->add_extern_output_node(1, sender, "activation");
+    for(int n=1; n<=NEURON_NUMBER; n+=20){
+        nn->_extern_output_nodes[0]->add_target(nn->_neurons[n]);
+    }
+    return nn;
+}
+
+/***********************************************************
+ * feed_client()
+ *
+ * Description: Sends messages to the client of the launcher until it is stopped.
+ */
+void feed_client(udp_client_server::udp_client *input, std::atomic<bool> *feeding){
+    while(*feeding){
+        input->send(INPUT_MESSAGE, strlen(INPUT_MESSAGE));
+        usleep(INPUT_INTERVAL_US);
+    }
+}
+
+/***********************************************************
+ * count_tick_allocations()
+ *
+ * Description: Runs a cluster of two networks with a sender and a fed client in a CognaLauncher
+ *              and counts the heap allocations of all steps after the warm-up. Has to run in its
+ *              own process, since the launcher expects the networks to have the IDs 0 and 1.
+ *
+ * Return:  long     Number of allocations during the measured steps
+ */
+long count_tick_allocations(bool compiled, bool free_running){
+    std::mt19937 rng(42);
+    utils::networking_sender *sender = new utils::networking_sender("127.0.0.1", SENDER_PORT);
+    utils::networking_client *client = new utils::networking_client("127.0.0.1", CLIENT_PORT, false);
+    NeuralNetwork *first = build_network(rng, sender);
+    NeuralNetwork *second = build_network(rng, sender);
+
+    for(int n=1; n<=NEURON_NUMBER; n+=10){
+        first->add_neuron_connection(n, second->_neurons[n], 1.0f);
+        second->add_neuron_connection(n, first->_neurons[n], 1.0f);
+    }
+
+    std::vector<NeuralNetwork*> cluster(second->_id + 1, NULL);
+    cluster[first->_id] = first;
+    cluster[second->_id] = second;
+    if(first->_id != 0 || second->_id != 1){
+        fprintf(stderr, "[ERROR] Networks of the launcher have the IDs %d and %d.\n", first->_id, second->_id);
+        exit(ERROR_CODE);
+    }
+
+    for(unsigned int i=0; i<cluster.size(); i++){
+        cluster[i]->setup_network();
+        if(compiled && cluster[i]->compile_network(cluster) == ERROR_CODE){
+            fprintf(stderr, "[ERROR] Compiling NN-%d failed.\n", cluster[i]->_id);
+            exit(ERROR_CODE);
+        }
+        cluster[i]->reserve_deliveries(cluster);
+    }
+
+    CognaLauncher *launcher = new CognaLauncher(cluster, std::vector<utils::networking_client*>(1, client),
+                                                std::vector<utils::networking_sender*>(1, sender),
+                                                CLOCKED_FREQUENCY, WORKER_NUMBER);
+    launcher->set_free_running(free_running);
+    launcher->set_dataflow_scheduling(free_running);
+    launcher->set_max_steps(WARMUP_STEPS + TEST_STEPS + 1);
+
+    udp_client_server::udp_client *input = new udp_client_server::udp_client("127.0.0.1", CLIENT_PORT);
+    std::atomic<bool> feeding(true);
+    std::thread feeder(feed_client, input, &feeding);
+
+    s_launcher = launcher;
+    launcher->run_cogna();
+    s_launcher = NULL;
+
+    feeding = false;
+    feeder.join();
+    delete input;
+
+    /* Deletes the networks, the sender and the client as well */
+    delete launcher;
+    return s_allocations;
+}
+
+/***********************************************************
+ * run_counted()
+ *
+ * Description: Counts the allocations of a launcher in a child process.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_counted(bool compiled, bool free_running){
+    fflush(stdout);
+    fflush(stderr);
+    pid_t child = fork();
+    if(child < 0){
+        fprintf(stderr, "[ERROR] Could not start run.\n");
+        return 1;
+    }
+    if(child == 0){
+        long allocations = count_tick_allocations(compiled, free_running);
+        fprintf(stderr, "Allocations in %d steps of the %s, %s: %ld.\n", TEST_STEPS,
+                compiled ? "compiled network" : "object graph", free_running ? "free running" : "clocked",
+                allocations);
+        fflush(stdout);
+        _exit(allocations > 0 ? 1 : SUCCESS_CODE);
+    }
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    return (WIFEXITED(status) && WEXITSTATUS(status) == SUCCESS_CODE) ? 0 : 1;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Checks that a running launcher does not allocate heap memory anymore after the warm-up,
+ *              both on the object graph and on the compiled network, free running with the dataflow
+ *              scheduler and clocked on the worker pool.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    int errors = run_counted(false, true);
+    errors += run_counted(true, true);
+    errors += run_counted(true, false);
+
+    if(errors > 0){
+        fprintf(stderr, "[ERROR] The steps of the launcher allocate heap memory.\n");
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
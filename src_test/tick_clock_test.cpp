@@ -0,0 +1,150 @@
+#include "TickClock.hpp"
+#include "Constants.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <unistd.h>
+
+using namespace COGNA;
+
+const int DRIFT_FREQUENCY = 1000;
+const int DRIFT_TICKS = 1000;
+const int DRIFT_WORK_US = 300;          // A relative sleep after every step would run 30% slower
+const int OVERRUN_FREQUENCY = 50;       // 20 ms per tick
+const int OVERRUN_TICKS = 10;
+const int OVERRUN_WORK_MS = 50;
+const double TOLERANCE_MS = 8.0;
+
+/***********************************************************
+ * elapsed_ms()
+ *
+ * Description: Returns the milliseconds since a point in time.
+ *
+ * Return:  double     Milliseconds
+ */
+double elapsed_ms(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/***********************************************************
+ * check_histogram()
+ *
+ * Description: Checks that the histogram counted every tick once and bounds the largest lateness.
+ *
+ * Return:  int     Number of errors found
+ */
+int check_histogram(const TickClock &clock){
+    uint64_t counted = 0;
+    for(int b=0; b<LATENESS_BUCKETS; b++){
+        counted += clock.lateness_count(b);
+    }
+    int errors = 0;
+    if(counted != clock.ticks()){
+        fprintf(stderr, "[ERROR] Histogram counted %lu of %lu ticks.\n", (unsigned long)counted,
+                (unsigned long)clock.ticks());
+        errors++;
+    }
+    if(clock.lateness_percentile(1.0) <= clock.max_lateness() ||
+       clock.lateness_percentile(0.5) > clock.lateness_percentile(1.0)){
+        fprintf(stderr, "[ERROR] Percentiles do not bound the lateness of %ld us.\n", (long)clock.max_lateness());
+        errors++;
+    }
+    return errors;
+}
+
+/***********************************************************
+ * run_drift()
+ *
+ * Description: Ticks with work in every tick and checks that the ticks still hold the frequency.
+ *              Missed ticks are caught up, so the last tick is due after exactly DRIFT_TICKS periods.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_drift(){
+    TickClock clock(DRIFT_FREQUENCY, OVERRUN_CATCH_UP);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    clock.start();
+    for(int i=0; i<DRIFT_TICKS; i++){
+        clock.wait();
+        usleep(DRIFT_WORK_US);
+    }
+    double run_time = elapsed_ms(start);
+    clock.print_statistics();
+
+    int errors = check_histogram(clock);
+    double expected = 1000.0 * DRIFT_TICKS / DRIFT_FREQUENCY;
+    printf("[INFO] %d ticks took %.2f ms, expected %.2f ms.\n", DRIFT_TICKS, run_time, expected);
+    if(run_time < expected || run_time > expected + TOLERANCE_MS + DRIFT_WORK_US / 1000.0){
+        fprintf(stderr, "[ERROR] Ticks drifted.\n");
+        errors++;
+    }
+    if(clock.ticks() != (uint64_t)DRIFT_TICKS){
+        fprintf(stderr, "[ERROR] Clock counted %lu ticks.\n", (unsigned long)clock.ticks());
+        errors++;
+    }
+    return errors;
+}
+
+/***********************************************************
+ * run_overrun()
+ *
+ * Description: Overruns the second tick by one and a half periods and checks when the last tick starts.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_overrun(int policy, const char *name, double expected_ms, uint64_t expected_skipped){
+    TickClock clock(OVERRUN_FREQUENCY, policy);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    clock.start();
+    for(int i=0; i<OVERRUN_TICKS; i++){
+        clock.wait();
+        if(i == 0){
+            usleep(OVERRUN_WORK_MS * 1000);
+        }
+    }
+    double run_time = elapsed_ms(start);
+
+    int errors = check_histogram(clock);
+    printf("[INFO] Last tick with overrun policy %s started after %.2f ms, expected %.2f ms.\n",
+           name, run_time, expected_ms);
+    if(run_time < expected_ms || run_time > expected_ms + TOLERANCE_MS){
+        fprintf(stderr, "[ERROR] Overrun policy %s started the last tick at the wrong time.\n", name);
+        errors++;
+    }
+    if(clock.overruns() != 1 || clock.skipped_ticks() != expected_skipped){
+        fprintf(stderr, "[ERROR] Overrun policy %s counted %lu overruns and %lu skipped ticks.\n", name,
+                (unsigned long)clock.overruns(), (unsigned long)clock.skipped_ticks());
+        errors++;
+    }
+    return errors;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Checks that the ticks start at absolute deadlines and that all overrun policies
+ *              handle missed deadlines as documented.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    int errors = run_drift();
+
+    /* The first tick ends at 70 ms, the second one is due at 40 ms and overruns by 30 ms */
+    double period = 1000.0 / OVERRUN_FREQUENCY;
+    errors += run_overrun(OVERRUN_CATCH_UP, "catch_up", OVERRUN_TICKS * period, 0);
+    errors += run_overrun(OVERRUN_SKIP, "skip", (OVERRUN_TICKS + 1) * period, 1);
+    errors += run_overrun(OVERRUN_STRETCH, "stretch", (OVERRUN_TICKS + 1.5) * period, 0);
+
+    if(TickClock::parse_overrun_policy("catch_up") != OVERRUN_CATCH_UP ||
+       TickClock::parse_overrun_policy("late") != ERROR_CODE){
+        fprintf(stderr, "[ERROR] Overrun policies are not parsed.\n");
+        errors++;
+    }
+
+    if(errors > 0){
+        fprintf(stderr, "[ERROR] %d errors found.\n", errors);
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
@@ -0,0 +1,98 @@
+#include "NeuralNetwork.hpp"
+#include "Trace.hpp"
+
+#include <cstdio>
+#include <vector>
+
+using namespace COGNA;
+
+const int NEURON_NUMBER = 20;
+const int TEST_STEPS = 50;
+
+/***********************************************************
+ * run_chain()
+ *
+ * Description: Runs a chain of neurons, which is activated at its start every step.
+ */
+void run_chain(){
+    NeuralNetwork *nn = new NeuralNetwork();
+    for(int n=1; n<=NEURON_NUMBER; n++){
+        nn->add_neuron(0.5f);
+    }
+    for(int n=1; n<NEURON_NUMBER; n++){
+        nn->add_neuron_connection(n, n+1, 1.0f);
+    }
+    nn->setup_network();
+
+    for(int step=0; step<TEST_STEPS; step++){
+        nn->init_activation(1, 2.0f);
+        nn->feed_forward();
+    }
+    delete nn;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Checks that only enabled categories are recorded, that the ring buffer
+ *              keeps the newest events and that category names are parsed.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    int errors = 0;
+
+    Trace::set_categories(TRACE_NONE);
+    run_chain();
+    if(Trace::recorded() != 0){
+        fprintf(stderr, "[ERROR] %lu events recorded with tracing disabled.\n", (unsigned long)Trace::recorded());
+        errors++;
+    }
+
+    uint32_t categories = TRACE_NONE;
+    if(Trace::parse_categories("step, base", categories) == ERROR_CODE || categories != (TRACE_STEP | TRACE_BASE)){
+        fprintf(stderr, "[ERROR] Categories were not parsed.\n");
+        errors++;
+    }
+    if(Trace::parse_categories("base,unknown", categories) != ERROR_CODE){
+        fprintf(stderr, "[ERROR] Unknown category was accepted.\n");
+        errors++;
+    }
+
+    Trace::set_categories(TRACE_STEP | TRACE_BASE);
+    run_chain();
+    Trace::set_categories(TRACE_NONE);
+
+    std::vector<TraceEvent> events(TRACE_BUFFER_SIZE);
+    int event_number = Trace::snapshot(events.data());
+    int steps = 0;
+    for(int i=0; i<event_number; i++){
+        if(events[i].category != TRACE_STEP && events[i].category != TRACE_BASE){
+            fprintf(stderr, "[ERROR] Event of disabled category %u recorded.\n", events[i].category);
+            errors++;
+            break;
+        }
+        steps += (events[i].event == TRACE_EVENT_STEP);
+    }
+    if(COGNA_TRACING && (steps == 0 || event_number == 0)){
+        fprintf(stderr, "[ERROR] Enabled categories were not recorded.\n");
+        errors++;
+    }
+
+    /* Overflow the buffer, only the newest events have to be kept */
+    Trace::clear();
+    for(int i=0; i<TRACE_BUFFER_SIZE + 10; i++){
+        Trace::record(TRACE_BASE, TRACE_EVENT_FORCE, TRACE_NOW, i, 1, 2, 0.0f);
+    }
+    event_number = Trace::snapshot(events.data());
+    if(event_number != TRACE_BUFFER_SIZE || events[0].step != 10 || events[event_number-1].step != TRACE_BUFFER_SIZE + 9){
+        fprintf(stderr, "[ERROR] Ring buffer does not keep the newest events.\n");
+        errors++;
+    }
+
+    if(errors > 0){
+        return ERROR_CODE;
+    }
+    fprintf(stderr, "Trace recorded %d events.\n", event_number);
+    return SUCCESS_CODE;
+}
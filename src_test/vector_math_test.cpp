@@ -0,0 +1,71 @@
+#include "VectorMath.hpp"
+#include "Constants.hpp"
+
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace COGNA;
+
+const int TEST_VALUES = 100003;
+
+/***********************************************************
+ * main()
+ *
+ * Description: Compares VectorMath::pow() with std::pow() for random and special values.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> base(0.0, 60.0);
+    std::uniform_real_distribution<double> exponent(-3.0, 3.0);
+    std::vector<double> x(TEST_VALUES);
+    std::vector<double> y(TEST_VALUES);
+    std::vector<double> result(TEST_VALUES);
+
+    for(int i=0; i<TEST_VALUES; i++){
+        x[i] = base(rng);
+        y[i] = exponent(rng);
+    }
+    const double special_bases[] = {0.0, -1.0, -2.5, 1e-310, INFINITY, NAN, 1.0, 1e300, 1e-300, DBL_MIN, DBL_MAX};
+    const double special_exponents[] = {2.0, 3.0, 0.5, 1.0, 2.0, 1.0, NAN, 3.0, -3.0, 1.0, 0.5};
+    for(unsigned int i=0; i<sizeof(special_bases) / sizeof(double); i++){
+        x[i * 7] = special_bases[i];
+        y[i * 7] = special_exponents[i];
+    }
+
+    VectorMath::pow(x.data(), y.data(), result.data(), TEST_VALUES);
+
+    int errors = 0;
+    double max_error = 0.0;
+    for(int i=0; i<TEST_VALUES; i++){
+        double expected = std::pow(x[i], y[i]);
+        if(std::isnan(expected) || std::isnan(result[i])){
+            if(std::isnan(expected) != std::isnan(result[i])){
+                fprintf(stderr, "[ERROR] pow(%g, %g) = %g instead of %g\n", x[i], y[i], result[i], expected);
+                errors++;
+            }
+            continue;
+        }
+        if(expected == result[i]){
+            continue;
+        }
+        double error = std::fabs(result[i] - expected) / std::fabs(expected);
+        if(error > max_error){
+            max_error = error;
+        }
+        if(error > VECTOR_POW_TOLERANCE){
+            fprintf(stderr, "[ERROR] pow(%g, %g) = %.17g instead of %.17g\n", x[i], y[i], result[i], expected);
+            errors++;
+        }
+    }
+
+    fprintf(stderr, "VectorMath::pow() with %s differs by at most %g.\n", VectorMath::instruction_set(), max_error);
+    if(errors > 0){
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}
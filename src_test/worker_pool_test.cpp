@@ -0,0 +1,218 @@
+#include "WorkerPool.hpp"
+#include "Constants.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace COGNA;
+
+const int WORKER_NUMBER = 4;
+const int TASK_NUMBER = 37;
+const int RUN_NUMBER = 500;
+
+/***********************************************************
+ * busy_wait()
+ *
+ * Description: Keeps the calling thread busy for some microseconds without sleeping.
+ */
+void busy_wait(int microseconds){
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now()
+                                                + std::chrono::microseconds(microseconds);
+    while(std::chrono::steady_clock::now() < end){
+    }
+}
+
+/***********************************************************
+ * run_counting()
+ *
+ * Description: Runs many steps of cheap tasks and checks that every task runs exactly once per step.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_counting(){
+    WorkerPool pool(WORKER_NUMBER);
+    std::vector<int> counters(TASK_NUMBER, 0);
+    std::vector<std::function<void()>> tasks;
+    for(int i=0; i<TASK_NUMBER; i++){
+        tasks.push_back([&counters, i](){ counters[i]++; });
+    }
+
+    int error_number = 0;
+    for(int run=0; run<RUN_NUMBER; run++){
+        pool.run(tasks);
+        for(int i=0; i<TASK_NUMBER; i++){
+            if(counters[i] != run + 1){
+                fprintf(stderr, "[ERROR] Task %d ran %d times in %d steps.\n", i, counters[i], run + 1);
+                error_number++;
+            }
+        }
+        if(error_number > 0){
+            return error_number;
+        }
+    }
+
+    uint64_t task_sum = 0;
+    for(int i=0; i<pool.worker_number(); i++){
+        task_sum += pool.statistics(i)._tasks;
+    }
+    if(task_sum != (uint64_t)TASK_NUMBER * RUN_NUMBER){
+        fprintf(stderr, "[ERROR] Statistics count %lu tasks.\n", (unsigned long)task_sum);
+        error_number++;
+    }
+    return error_number;
+}
+
+/***********************************************************
+ * run_uneven()
+ *
+ * Description: Gives all expensive tasks to the queue of the first worker and checks
+ *              that the other workers steal them.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_uneven(){
+    WorkerPool pool(WORKER_NUMBER);
+    std::atomic<int> finished(0);
+    std::vector<std::function<void()>> tasks;
+    for(int i=0; i<2 * WORKER_NUMBER; i++){
+        int cost = (i < 4) ? 2000 : 0;
+        tasks.push_back([&finished, cost](){
+            busy_wait(cost);
+            finished++;
+        });
+    }
+
+    for(int run=0; run<20; run++){
+        pool.run(tasks);
+    }
+
+    int error_number = 0;
+    if(finished != 20 * 2 * WORKER_NUMBER){
+        fprintf(stderr, "[ERROR] %d tasks finished.\n", finished.load());
+        error_number++;
+    }
+
+    uint64_t stolen = 0;
+    for(int i=0; i<pool.worker_number(); i++){
+        stolen += pool.statistics(i)._stolen_tasks;
+        float utilization = pool.utilization(i);
+        if(utilization < 0.0f || utilization > 1.0f){
+            fprintf(stderr, "[ERROR] Worker %d has a utilization of %f.\n", i, utilization);
+            error_number++;
+        }
+    }
+    if(stolen == 0){
+        fprintf(stderr, "[ERROR] No task was stolen.\n");
+        error_number++;
+    }
+    pool.print_statistics();
+    return error_number;
+}
+
+/***********************************************************
+ * run_placed()
+ *
+ * Description: Places the tasks on the workers unevenly, including workers without tasks,
+ *              and checks that every task runs exactly once per step.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_placed(){
+    WorkerPool pool(WORKER_NUMBER);
+    std::vector<int> counters(TASK_NUMBER, 0);
+    std::vector<std::function<void()>> tasks;
+    for(int i=0; i<TASK_NUMBER; i++){
+        tasks.push_back([&counters, i](){ counters[i]++; });
+    }
+    std::vector<uint32_t> first_tasks = {0, 30, 30, 36, TASK_NUMBER};
+
+    for(int run=0; run<RUN_NUMBER; run++){
+        pool.run(tasks, first_tasks);
+        for(int i=0; i<TASK_NUMBER; i++){
+            if(counters[i] != run + 1){
+                fprintf(stderr, "[ERROR] Placed task %d ran %d times in %d steps.\n", i, counters[i], run + 1);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/***********************************************************
+ * run_every_worker()
+ *
+ * Description: Runs a task on every worker and checks that each worker ran it once on its own
+ *              thread, worker 0 on the calling thread, and that the pool still runs tasks afterwards.
+ *
+ * Return:  int     Number of errors found
+ */
+int run_every_worker(){
+    WorkerPool pool(WORKER_NUMBER);
+    std::vector<int> calls(WORKER_NUMBER, 0);
+    std::vector<std::thread::id> threads(WORKER_NUMBER);
+    for(int run=0; run<RUN_NUMBER; run++){
+        pool.run_on_every_worker([&calls, &threads](int worker){
+            calls[worker]++;
+            threads[worker] = std::this_thread::get_id();
+            busy_wait(worker * 5);
+        });
+    }
+
+    int error_number = 0;
+    for(int i=0; i<WORKER_NUMBER; i++){
+        if(calls[i] != RUN_NUMBER){
+            fprintf(stderr, "[ERROR] Worker %d ran its task %d times in %d runs.\n", i, calls[i], RUN_NUMBER);
+            error_number++;
+        }
+        for(int j=0; j<i; j++){
+            if(threads[i] == threads[j]){
+                fprintf(stderr, "[ERROR] Workers %d and %d ran on the same thread.\n", j, i);
+                error_number++;
+            }
+        }
+    }
+    if(threads[0] != std::this_thread::get_id()){
+        fprintf(stderr, "[ERROR] Worker 0 did not run on the calling thread.\n");
+        error_number++;
+    }
+
+    std::vector<int> counters(TASK_NUMBER, 0);
+    std::vector<std::function<void()>> tasks;
+    for(int i=0; i<TASK_NUMBER; i++){
+        tasks.push_back([&counters, i](){ counters[i]++; });
+    }
+    pool.run(tasks);
+    for(int i=0; i<TASK_NUMBER; i++){
+        if(counters[i] != 1){
+            fprintf(stderr, "[ERROR] Task %d ran %d times after running on every worker.\n", i, counters[i]);
+            error_number++;
+        }
+    }
+    return error_number;
+}
+
+/***********************************************************
+ * main()
+ *
+ * Description: Checks that the pool runs every task exactly once per step, also with placed
+ *              tasks, balances uneven tasks by stealing, runs a task on every worker and shuts
+ *              down cleanly.
+ *
+ * Return:  int     Error code of program
+ */
+int main(){
+    int errors = run_counting();
+    errors += run_uneven();
+    errors += run_placed();
+    errors += run_every_worker();
+
+    if(errors > 0){
+        fprintf(stderr, "[ERROR] %d errors found.\n", errors);
+        return ERROR_CODE;
+    }
+    return SUCCESS_CODE;
+}